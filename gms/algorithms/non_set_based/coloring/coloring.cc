@@ -19,7 +19,7 @@ CSRGraph Preprocess(const CSRGraph& g)
     std::vector<GMS::NodeId> ranking;
     PpSequential::getSimpleIdOrdering(g, ranking);
 
-    return PpSequential::InduceDirectedGraph<>(g, ranking);
+    return PpParallel::OrientByRank(g, ranking);
 }
 
 std::vector<NodeId> Reorder(const CSRGraph& g)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <gms/common/cli/cli.h>
+#include <gms/algorithms/preprocessing/parallel/relabel.h>
 #include <gms/common/pipeline.h>
 #include "clique_counting.h"
 
@@ -8,9 +9,29 @@ namespace GMS::KClique {
 
 std::tuple<CLCliqueApp, CSRGraph> parse(int argc, char **argv) {
     GMS::CLI::Parser parser;
+    parser.set_relabeler(PpParallel::relabelByOrdering, PpParallel::Relabel::availableOrderings());
     auto clique_size = parser.add_param("clique-size", "cs", "8", "the clique size");
+    auto approx_error = parser.add_param("approx-error", std::nullopt, "0.05",
+                                         "target relative error of the approximate counters");
+    auto approx_confidence = parser.add_param("approx-confidence", std::nullopt, "0.95",
+                                              "confidence level of the approximate counters");
+    auto approx_time = parser.add_param("approx-time", std::nullopt, "0",
+                                        "time budget of the approximate counters in seconds (0: unlimited)");
+    auto peeling_epsilon = parser.add_param("peeling-epsilon", std::nullopt, "0.1",
+                                            "approximation parameter of the k-clique densest subgraph peeling");
+    auto task_threshold = parser.add_param("task-threshold", std::nullopt, "4096",
+                                           "edges of a candidate subgraph from which work stealing spawns a task");
     auto [args, g] = parser.parse_and_load(argc, argv);
-    return std::make_tuple<CLCliqueApp, CSRGraph>(CLCliqueApp(args, clique_size), std::move(g));
+
+    CLCliqueApp app(args, clique_size);
+    Estimation::Budget budget;
+    budget.relative_error = approx_error.to_double();
+    budget.confidence = approx_confidence.to_double();
+    budget.seconds = approx_time.to_double();
+    app.set_approximation(budget);
+    app.set_peeling_epsilon(peeling_epsilon.to_double());
+    app.set_task_threshold(task_threshold.to_int());
+    return std::make_tuple<CLCliqueApp, CSRGraph>(std::move(app), std::move(g));
 }
 
 template <const bool TNodeParallel, class CGraph = CSRGraph>
@@ -23,32 +44,53 @@ public:
     const CLApp& clApp;
     CGraph *originalGraph;
     std::optional<CGraph> orderedGraph;
+    std::vector<NodeId> ranking; // vertex v of originalGraph is vertex ranking[v] of orderedGraph
+    std::vector<NodeId> cores; // core numbers of originalGraph, set by Preprocess
+    std::optional<OrderingCache::CachedOrdering> degeneracyCache;
     KclistGraphT *danischGraph;
     unsigned long long count;
     double epsilon;
+    Estimation::Estimate estimate;
+    std::vector<unsigned long long> vertexCounts;
+    std::vector<unsigned long long> edgeCounts;
+    DensestSubgraph densest;
+    Parallelize::TaskStats taskStats;
 
     CliqueCountPipeline(const CLApp& clapp) : clApp(clapp), originalGraph(nullptr), danischGraph(nullptr), count(0), epsilon(1.)
     {}
 
     void Preprocess()
     {
-        std::vector<NodeId> ranking;
-        PpSequential::getDegeneracyOrderingDanischHeap(*originalGraph, ranking);
-        orderedGraph = PpSequential::InduceDirectedGraph<CGraph>(*originalGraph, ranking);
+        // the degeneracy ordering and the core numbers are kept in the ordering cache, if it is enabled
+        if (!degeneracyCache)
+        {
+            const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(clApp);
+            degeneracyCache.emplace(dcli.ordering_cache_mode(), dcli.ordering_cache(), *originalGraph, "degeneracy");
+        }
+        degeneracyCache->get(ranking, cores, [this](std::vector<NodeId>& r, std::vector<NodeId>& c) {
+            PpParallel::getKCoreDecomposition<CGraph, true>(*originalGraph, r, c);
+        });
+        degeneracyCache->print();
+        // same direction as the ranking of getDegeneracyOrderingDanischHeap: the first peeled vertex has the highest rank
+        const NodeId n = originalGraph->num_nodes();
+        #pragma omp parallel for
+        for (NodeId v = 0; v < n; v++)
+        {
+            ranking[v] = n - 1 - ranking[v];
+        }
+        orderedGraph = PpParallel::OrientByRank<CGraph>(*originalGraph, ranking);
     }
 
     void PreprocessSimple()
     {
-        std::vector<NodeId> ranking;
         PpSequential::getSimpleIdOrdering(*originalGraph, ranking);
-        orderedGraph = PpSequential::InduceDirectedGraph<CGraph>(*originalGraph, ranking);
+        orderedGraph = PpParallel::OrientByRank<CGraph>(*originalGraph, ranking);
     }
 
     void PreprocessDegree()
     {
-        std::vector<NodeId> ranking;
         PpSequential::getDegreeOrdering<CGraph>(*originalGraph, ranking);
-        orderedGraph = PpSequential::InduceDirectedGraph<CGraph>(*originalGraph, ranking);
+        orderedGraph = PpParallel::OrientByRank<CGraph>(*originalGraph, ranking);
     }
 
     template<BoundaryFunction ApproxSorting_T, bool useRankFormat = false>
@@ -56,12 +98,12 @@ public:
     {
         std::vector<NodeId> sortedVertices;
         PpParallel::getDegeneracyOrderingApproxCGraph<ApproxSorting_T, useRankFormat>(*originalGraph, sortedVertices, epsilon);
-        std::vector<NodeId> ranking(originalGraph->num_nodes());
+        ranking.resize(originalGraph->num_nodes());
         for(NodeId i = 0; i < originalGraph->num_nodes(); i++)
         {
             ranking[sortedVertices[i]] = i;
         }
-        orderedGraph = PpSequential::InduceDirectedGraph<CGraph>(*originalGraph, ranking);
+        orderedGraph = PpParallel::OrientByRank<CGraph>(*originalGraph, ranking);
     }
 
     void kclisting()
@@ -73,6 +115,150 @@ public:
         }
     }
 
+    // kclisting with the subgraphs built into per thread arenas
+    void kclistingPooled()
+    {
+        if constexpr (TNodeParallel) {
+            count = Par::NPPooled_kclisting<CGraph>(orderedGraph.value(), clApp);
+        } else {
+            count = Par::EPPooled_kclisting<CGraph>(orderedGraph.value(), clApp);
+        }
+    }
+
+    // kclistingPooled with the bit matrix kernel
+    void kclistingBitset()
+    {
+        if constexpr (TNodeParallel) {
+            count = Par::NPBitset_kclisting<CGraph>(orderedGraph.value(), clApp);
+        } else {
+            count = Par::EPBitset_kclisting<CGraph>(orderedGraph.value(), clApp);
+        }
+    }
+
+    // Work stealing variant of kclisting, the load balance is printed by verifyStealing
+    void kclistingStealing()
+    {
+        if constexpr (TNodeParallel) {
+            count = Par::NPStealing_kclisting<CGraph>(orderedGraph.value(), clApp, &taskStats);
+        } else {
+            count = Par::EPStealing_kclisting<CGraph>(orderedGraph.value(), clApp, &taskStats);
+        }
+    }
+
+    // Per vertex and per edge k-clique counts in original vertex ids, see localCountsToOriginalIds
+    void kclistingLocal()
+    {
+        count = Par::NP_kclisting_local<CGraph>(orderedGraph.value(), clApp, vertexCounts, &edgeCounts);
+        localCountsToOriginalIds();
+    }
+
+    // The vertices of the densest subgraph are reported in original vertex ids
+    void densestSubgraph()
+    {
+        const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(clApp);
+        densest = GMS::KClique::densestSubgraph(orderedGraph.value(), clApp, dcli.peeling_epsilon());
+        count = densest.cliques;
+        std::vector<NodeId> originalIds(ranking.size());
+        #pragma omp parallel for
+        for(NodeId u = 0; u < static_cast<NodeId>(ranking.size()); u++)
+        {
+            originalIds[ranking[u]] = dcli.original_id(u);
+        }
+        for(NodeId& v : densest.vertices)
+        {
+            v = originalIds[v];
+        }
+        std::sort(densest.vertices.begin(), densest.vertices.end());
+    }
+
+    // graphIds[x] is the vertex of originalGraph with the original id x (see CLCliqueApp::original_id)
+    std::vector<NodeId> graphIdsOfOriginal() const
+    {
+        const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(clApp);
+        const NodeId n = originalGraph->num_nodes();
+        std::vector<NodeId> graphIds(n);
+        #pragma omp parallel for
+        for(NodeId u = 0; u < n; u++)
+        {
+            graphIds[dcli.original_id(u)] = u;
+        }
+        return graphIds;
+    }
+
+    /**
+     * Maps the counts of NP_kclisting_local from the oriented graph to the original ids of the input, which undoes
+     * both the orientation ranking and the --relabel stage: vertexCounts[x] becomes the count of original vertex x.
+     * The edge counts follow the original vertices x and, for each of them, its neighbours y > x in increasing order,
+     * so they don't depend on the orientation or on the relabeling either.
+     */
+    void localCountsToOriginalIds()
+    {
+        const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(clApp);
+        const CGraph& dag = orderedGraph.value();
+        const NodeId n = originalGraph->num_nodes();
+        const std::vector<NodeId> graphIds = graphIdsOfOriginal();
+        std::vector<int64_t> originalOffsets(n + 1, 0), dagOffsets(n + 1, 0);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for(NodeId x = 0; x < n; x++)
+        {
+            int64_t upper = 0;
+            for(NodeId w : originalGraph->out_neigh(graphIds[x]))
+            {
+                upper += dcli.original_id(w) > x;
+            }
+            originalOffsets[x + 1] = upper;
+        }
+        for(NodeId v = 0; v < n; v++)
+        {
+            originalOffsets[v + 1] += originalOffsets[v];
+            dagOffsets[v + 1] = dagOffsets[v] + dag.out_degree(v);
+        }
+
+        // count of the edge {u, w} of originalGraph, stored with the lower ranked endpoint in the orientation
+        auto edgeCount = [&](NodeId u, NodeId w) {
+            NodeId r = ranking[u], s = ranking[w];
+            if(s < r) std::swap(r, s);
+            const auto neigh = dag.out_neigh(r);
+            const auto it = std::lower_bound(neigh.begin(), neigh.end(), s);
+            return edgeCounts[dagOffsets[r] + std::distance(neigh.begin(), it)];
+        };
+
+        std::vector<unsigned long long> originalVertexCounts(n);
+        std::vector<unsigned long long> originalEdgeCounts(edgeCounts.empty() ? 0 : originalOffsets[n]);
+        #pragma omp parallel
+        {
+            std::vector<std::pair<NodeId, unsigned long long>> edges;
+            #pragma omp for schedule(dynamic, 1024)
+            for(NodeId x = 0; x < n; x++)
+            {
+                const NodeId u = graphIds[x];
+                originalVertexCounts[x] = vertexCounts[ranking[u]];
+                if(originalEdgeCounts.empty()) continue;
+                edges.clear();
+                for(NodeId w : originalGraph->out_neigh(u))
+                {
+                    const NodeId y = dcli.original_id(w);
+                    if(y > x) edges.emplace_back(y, edgeCount(u, w));
+                }
+                std::sort(edges.begin(), edges.end());
+                for(size_t i = 0; i < edges.size(); i++)
+                {
+                    originalEdgeCounts[originalOffsets[x] + i] = edges[i].second;
+                }
+            }
+        }
+        vertexCounts = std::move(originalVertexCounts);
+        edgeCounts = std::move(originalEdgeCounts);
+    }
+
+    // The approximate counter needs the CSR oriented graph with sorted neighbourhoods of the Preprocess* methods.
+    void turanShadow()
+    {
+        const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(clApp);
+        estimate = Approx::turanShadow(orderedGraph.value(), clApp, dcli.budget());
+        count = std::llround(estimate.value);
+    }
+
     void verifierSetup()
     {
         if constexpr (TNodeParallel) {
@@ -93,6 +279,87 @@ public:
         LocalPrinter << (pass? "pass" : "failed");
     }
 
+    // Prints the load balance of kclistingStealing outside of the timed kernel and verifies the count.
+    void verifyStealing()
+    {
+        taskStats.print();
+        verify();
+    }
+
+    void verifyApprox()
+    {
+        const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(clApp);
+        unsigned long long reference;
+        if constexpr (TNodeParallel) {
+            reference = NP::kclique_main(dcli.clique_size(), danischGraph);
+        } else {
+            reference = EP::kclique_main(dcli.clique_size(), danischGraph);
+        }
+        const bool pass = Verifiers::Approx(reference, estimate, clApp);
+        estimate.print();
+        std::printf("%-21s%.4f\n", "Relative Error:",
+                    reference > 0 ? std::abs(estimate.value - reference) / reference : estimate.value);
+        LocalPrinter << (pass? "pass" : "failed");
+    }
+
+    // The local counts add up to k (k choose 2) times the total for the vertices (edges), which is verified.
+    void verifyLocal()
+    {
+        const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(clApp);
+        const unsigned long long k = dcli.clique_size();
+        unsigned long long vertexSum = 0, edgeSum = 0;
+        #pragma omp parallel for reduction(+:vertexSum)
+        for(size_t v = 0; v < vertexCounts.size(); v++)
+        {
+            vertexSum += vertexCounts[v];
+        }
+        #pragma omp parallel for reduction(+:edgeSum)
+        for(size_t e = 0; e < edgeCounts.size(); e++)
+        {
+            edgeSum += edgeCounts[e];
+        }
+        bool pass = vertexSum == k * count && edgeSum == k * (k - 1) / 2 * count;
+        if(!pass)
+        {
+            std::cout << "Sum of the vertex counts: " << vertexSum << ", expected " << k * count << std::endl;
+            std::cout << "Sum of the edge counts: " << edgeSum << ", expected " << k * (k - 1) / 2 * count
+                << std::endl;
+        }
+        if constexpr (TNodeParallel) {
+            pass = Verifiers::NP(danischGraph, count, clApp) && pass;
+        } else {
+            pass = Verifiers::EP(danischGraph, count, clApp) && pass;
+        }
+        LocalPrinter << (pass? "pass" : "failed");
+    }
+
+    // Recounts the k-cliques of the densest subgraph (in original vertex ids) with the reference implementation.
+    void verifyDensest()
+    {
+        const CSRGraph& dag = orderedGraph.value();
+        const std::vector<NodeId> graphIds = graphIdsOfOriginal();
+        std::vector<char> member(dag.num_nodes(), 0);
+        for(NodeId x : densest.vertices)
+        {
+            member[ranking[graphIds[x]]] = 1;
+        }
+        const CSRGraph induced = Builders::filterEdges(dag, [&](NodeId u, NodeId w) { return member[u] && member[w]; });
+        NP::graph* reference = NP::ToGraph(induced);
+        const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(clApp);
+        const unsigned long long referenceCount = NP::kclique_main(dcli.clique_size(), reference);
+        NP::free_graph(reference);
+
+        const bool pass = referenceCount == densest.cliques;
+        if(!pass)
+        {
+            std::cout << "Cliques of the densest subgraph:" << std::endl;
+            std::cout << "Reference: " << referenceCount << std::endl;
+            std::cout << "Benchmark: " << densest.cliques << std::endl;
+        }
+        densest.print();
+        LocalPrinter << (pass? "pass" : "failed");
+    }
+
     void verifierTearDown()
     {
         if constexpr (TNodeParallel) {
@@ -3,7 +3,11 @@
 #include <gms/common/types.h>
 #include "parallelizationStrategy/SubGraphBuilder.h"
 #include "parallelizationStrategy/SubGraphBuilderWInverse.h"
+#include "parallelizationStrategy/PooledSubGraphBuilder.h"
 #include "kernels/kclisting.h"
+#include "kernels/kclisting_bitset.h"
+#include "kernels/approximate.h"
+#include "kernels/densest_subgraph.h"
 #include "parallelizationStrategy/parallelize.h"
 #include "verification/verify.h"
 
@@ -14,6 +18,34 @@ namespace GMS::KClique::Par
     constexpr auto NP_kclisting
         = Parallelize::node<Builders::SubGraphBuilder<CGraph>, KcListing<CGraph>, CGraph>;
 
+    template <class CGraph = CSRGraph>
+    constexpr auto NPPooled_kclisting
+        = Parallelize::node<Builders::PooledSubGraphBuilder<CGraph>, KcListing<Builders::SubGraphView>, CGraph>;
+
+    template <class CGraph = CSRGraph>
+    constexpr auto EPPooled_kclisting
+        = Parallelize::edge<Builders::PooledSubGraphBuilder<CGraph>, KcListing<Builders::SubGraphView>, CGraph>;
+
+    template <class CGraph = CSRGraph>
+    constexpr auto NPBitset_kclisting
+        = Parallelize::node<Builders::PooledSubGraphBuilder<CGraph>, KcListingBitset<Builders::SubGraphView>, CGraph>;
+
+    template <class CGraph = CSRGraph>
+    constexpr auto EPBitset_kclisting
+        = Parallelize::edge<Builders::PooledSubGraphBuilder<CGraph>, KcListingBitset<Builders::SubGraphView>, CGraph>;
+
+    template <class CGraph = CSRGraph>
+    constexpr auto NP_kclisting_local
+        = Parallelize::nodeLocal<Builders::SubGraphBuilder<CGraph>, KcListing<CGraph>, CGraph>;
+
+    template <class CGraph = CSRGraph>
+    constexpr auto NPStealing_kclisting
+        = Parallelize::stealing<Builders::SubGraphBuilder<CGraph>, KcListing<CGraph>, CGraph, false>;
+
+    template <class CGraph = CSRGraph>
+    constexpr auto EPStealing_kclisting
+        = Parallelize::stealing<Builders::SubGraphBuilder<CGraph>, KcListing<CGraph>, CGraph, true>;
+
     template <class CGraph = CSRGraph>
     constexpr auto EP_kclisting
         = Parallelize::edge<Builders::SubGraphBuilder<CGraph>, KcListing<CGraph>, CGraph>;
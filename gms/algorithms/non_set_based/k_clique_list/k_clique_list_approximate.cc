@@ -0,0 +1,33 @@
+#include <gms/common/types.h>
+
+#include <gms/algorithms/preprocessing/preprocessing.h>
+#include "bench_helper.h"
+
+using namespace GMS::KClique;
+
+template <class CGraph>
+using NPPipeline = CliqueCountPipeline<true, CGraph>;
+
+// Compares the Turán shadow estimator with the exact node parallel k-clique listing on the same oriented graph.
+template <class CGraph>
+void benchmark_suite(BenchCLApp &cli, CGraph &g) {
+    using P = NPPipeline<CGraph>;
+
+    P pipeline(cli);
+    pipeline.originalGraph = &g;
+
+    pipeline.SetPrintInfo("np", "kclisting", "degeneracy");
+    pipeline.template Run<P>(cli, &P::Preprocess, &P::kclisting, &P::verifierSetup, &P::verify, &P::verifierTearDown);
+
+    pipeline.SetPrintInfo("np", "turan-shadow", "degeneracy");
+    pipeline.template Run<P>(cli, &P::Preprocess, &P::turanShadow, &P::verifierSetup, &P::verifyApprox, &P::verifierTearDown);
+}
+
+int main(int argc, char *argv[])
+{
+    auto [cli, g] = parse(argc, argv);
+
+    benchmark_suite(cli, g);
+
+    return 0;
+}
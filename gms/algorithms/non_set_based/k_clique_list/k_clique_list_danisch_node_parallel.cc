@@ -19,6 +19,15 @@ void benchmark_suite(BenchCLApp &cli, CGraph &g) {
     pipeline.SetPrintInfo("np", "kclisting", "degeneracy");
     pipeline.template Run<P>(cli, &P::Preprocess, &P::kclisting, &P::verifierSetup, &P::verify, &P::verifierTearDown);
 
+    pipeline.SetPrintInfo("np", "kclisting-pooled", "degeneracy");
+    pipeline.template Run<P>(cli, &P::Preprocess, &P::kclistingPooled, &P::verifierSetup, &P::verify, &P::verifierTearDown);
+
+    pipeline.SetPrintInfo("np", "kclisting-bitset", "degeneracy");
+    pipeline.template Run<P>(cli, &P::Preprocess, &P::kclistingBitset, &P::verifierSetup, &P::verify, &P::verifierTearDown);
+
+    pipeline.SetPrintInfo("np", "kclisting-stealing", "degeneracy");
+    pipeline.template Run<P>(cli, &P::Preprocess, &P::kclistingStealing, &P::verifierSetup, &P::verifyStealing, &P::verifierTearDown);
+
     pipeline.SetPrintInfo("np", "kclisting", "id");
     pipeline.template Run<P>(cli, &P::PreprocessSimple, &P::kclisting, &P::verifierSetup, &P::verify, &P::verifierTearDown);
 
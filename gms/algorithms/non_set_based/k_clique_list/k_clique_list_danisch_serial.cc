@@ -11,8 +11,8 @@ template <class CGraph>
 CGraph Preprocess(const CGraph& g, const CLApp& cli)
 {
     std::vector<NodeId> ranking;
-    PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    return PpSequential::InduceDirectedGraph<>(g, ranking);
+    PpSequential::getDegeneracyOrderingDanischBucket(g, ranking);
+    return PpParallel::OrientByRank(g, ranking);
 }
 
 int main(int argc, char *argv[])
@@ -0,0 +1,36 @@
+#include <gms/common/types.h>
+
+#include <gms/algorithms/preprocessing/preprocessing.h>
+#include "bench_helper.h"
+
+using namespace GMS::KClique;
+
+template <class CGraph>
+using NPPipeline = CliqueCountPipeline<true, CGraph>;
+
+// Per vertex and per edge k-clique counts and the k-clique densest subgraph, next to the exact total count.
+template <class CGraph>
+void benchmark_suite(BenchCLApp &cli, CGraph &g) {
+    using P = NPPipeline<CGraph>;
+
+    P pipeline(cli);
+    pipeline.originalGraph = &g;
+
+    pipeline.SetPrintInfo("np", "kclisting", "degeneracy");
+    pipeline.template Run<P>(cli, &P::Preprocess, &P::kclisting, &P::verifierSetup, &P::verify, &P::verifierTearDown);
+
+    pipeline.SetPrintInfo("np", "kclisting-local", "degeneracy");
+    pipeline.template Run<P>(cli, &P::Preprocess, &P::kclistingLocal, &P::verifierSetup, &P::verifyLocal, &P::verifierTearDown);
+
+    pipeline.SetPrintInfo("np", "densest-subgraph", "degeneracy");
+    pipeline.template Run<P>(cli, &P::Preprocess, &P::densestSubgraph, &P::verifierSetup, &P::verifyDensest, &P::verifierTearDown);
+}
+
+int main(int argc, char *argv[])
+{
+    auto [cli, g] = parse(argc, argv);
+
+    benchmark_suite(cli, g);
+
+    return 0;
+}
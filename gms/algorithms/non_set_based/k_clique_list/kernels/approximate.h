@@ -0,0 +1,315 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <omp.h>
+
+#include <gms/common/types.h>
+#include <gms/common/estimate.h>
+#include "gms/third_party/gapbs/gapbs.h"
+
+#include "../parallelizationStrategy/SubGraphBuilder.h"
+#include "../parallelizationStrategy/parallelize.h"
+
+/*
+ * Sampling based estimator of the number of k-cliques. It works on the oriented graph of the exact counters
+ * (a DAG, e.g. degeneracy ordered) and builds on the same local subgraphs (SubGraphBuilder), so that its estimates
+ * can be compared directly with the exact counts.
+ */
+namespace GMS::KClique::Approx
+{
+    using Estimation::Budget;
+    using Estimation::Estimate;
+
+    // Counter based random numbers: the stream of a sample only depends on the seed and the sample's index, so the
+    // estimates don't depend on the number of threads.
+    class SampleRandom
+    {
+    public:
+        SampleRandom(uint64_t seed, uint64_t index) : _state(Estimation::mix(seed ^ Estimation::mix(index))) {}
+
+        uint64_t next() { return Estimation::mix(_state++); }
+        double uniform() { return (next() >> 11) * 0x1.0p-53; }
+        uint64_t below(uint64_t bound) { return next() % bound; }
+
+    private:
+        uint64_t _state;
+    };
+
+    /**
+     * @brief The Turán shadow of a graph: vertex sets S with a clique size l such that every k-clique of the graph
+     * is an l-clique of exactly one leaf S (together with the vertices chosen on the way to it). Leaves with l <= 2,
+     * or whose subgraph is complete, are counted exactly, the others are dense enough that a random l-subset of S is
+     * a clique with constant probability.
+     */
+    struct TuranShadow
+    {
+        std::vector<NodeId> vertices;       // the leaf i owns vertices[offsets[i], offsets[i + 1])
+        std::vector<int64_t> offsets{0};
+        std::vector<int> sizes;             // the clique size l of each leaf
+        std::vector<double> weights;        // the number of l-subsets of each leaf
+        double exact = 0.;                  // the cliques of the leaves which were counted exactly
+
+        size_t leaves() const { return sizes.size(); }
+    };
+
+    /**
+     * @brief Builds the shadow of the subgraphs of the vertices of one thread. The local subgraph of a vertex (its
+     * out-neighbourhood in the DAG, from SubGraphBuilder) is stored as a bit matrix, S is split into the
+     * out-neighbourhoods within S of its vertices until it is dense: its edge density exceeds the Turán density
+     * 1 - 1/(l - 1) (Jain and Seshadhri, A Fast and Provable Method for Estimating Clique Counts Using Turán's
+     * Theorem, WWW 2017).
+     */
+    class ShadowBuilder
+    {
+    public:
+        ShadowBuilder(uint coreNumber, TuranShadow& shadow)
+        : _words((coreNumber + 63) / 64), _adjacency(static_cast<size_t>(coreNumber) * _words), _shadow(shadow)
+        {}
+
+        void add(const CSRGraph& local, const NodeId* global, int cliqueSize)
+        {
+            const NodeId count = local.num_nodes();
+            std::fill(_adjacency.begin(), _adjacency.begin() + static_cast<size_t>(count) * _words, 0);
+            for(NodeId u = 0; u < count; u++)
+            {
+                for(NodeId w : local.out_neigh(u))
+                {
+                    row(u)[w / 64] |= uint64_t(1) << (w % 64);
+                }
+            }
+            _global = global;
+            std::vector<NodeId> all(count);
+            for(NodeId u = 0; u < count; u++)
+            {
+                all[u] = u;
+            }
+            expand(all, cliqueSize);
+        }
+
+    private:
+        const size_t _words;
+        std::vector<uint64_t> _adjacency;
+        TuranShadow& _shadow;
+        const NodeId* _global = nullptr;
+
+        uint64_t* row(NodeId u) { return _adjacency.data() + static_cast<size_t>(u) * _words; }
+
+        static double binomial(int64_t n, int k)
+        {
+            double result = 1.;
+            for(int i = 0; i < k; i++)
+            {
+                result = result * (n - i) / (i + 1);
+            }
+            return result;
+        }
+
+        // S: local vertices, l: the clique size still to be found in S
+        void expand(const std::vector<NodeId>& S, int l)
+        {
+            const int64_t size = S.size();
+            if(l == 1)
+            {
+                _shadow.exact += size;
+                return;
+            }
+
+            std::vector<uint64_t> mask(_words, 0);
+            for(NodeId u : S)
+            {
+                mask[u / 64] |= uint64_t(1) << (u % 64);
+            }
+            int64_t edges = 0;
+            for(NodeId u : S)
+            {
+                const uint64_t* r = row(u);
+                for(size_t i = 0; i < _words; i++)
+                {
+                    edges += __builtin_popcountll(r[i] & mask[i]);
+                }
+            }
+
+            const double pairs = size * (size - 1) / 2.;
+            if(l == 2)
+            {
+                _shadow.exact += edges;
+                return;
+            }
+            if(edges == pairs)
+            {
+                _shadow.exact += binomial(size, l);
+                return;
+            }
+            if(edges > (1. - 1. / (l - 1)) * pairs)
+            {
+                for(NodeId u : S)
+                {
+                    _shadow.vertices.push_back(_global[u]);
+                }
+                _shadow.offsets.push_back(_shadow.vertices.size());
+                _shadow.sizes.push_back(l);
+                _shadow.weights.push_back(binomial(size, l));
+                return;
+            }
+
+            std::vector<NodeId> next;
+            for(NodeId u : S)
+            {
+                const uint64_t* r = row(u);
+                next.clear();
+                for(NodeId w : S)
+                {
+                    if(r[w / 64] >> (w % 64) & 1) next.push_back(w);
+                }
+                if(static_cast<int>(next.size()) >= l - 1) expand(next, l - 1);
+            }
+        }
+    };
+
+    // Whether u and v are adjacent in the DAG, in either direction.
+    inline bool adjacent(const CSRGraph& dag, NodeId u, NodeId v)
+    {
+        return std::binary_search(dag.out_neigh(u).begin(), dag.out_neigh(u).end(), v)
+            || std::binary_search(dag.out_neigh(v).begin(), dag.out_neigh(v).end(), u);
+    }
+
+    /**
+     * @brief Turán shadow estimator. The shadow is built in parallel over the vertices, then the weighted leaves are
+     * sampled: a leaf is chosen with probability proportional to its number of l-subsets and a uniform l-subset of it
+     * is tested for being a clique. The number of cliques is the exact part plus the total weight times the
+     * fraction of cliques among the samples. Samples are drawn in growing batches until the confidence interval
+     * meets the budget.
+     *
+     * @param dag Oriented graph with sorted neighbourhoods (see CliqueCountPipeline::Preprocess)
+     * @param maxSamples Upper bound of the number of samples
+     */
+    inline Estimate turanShadow(const CSRGraph& dag, const CLApp& cli, const Budget& budget = Budget(),
+                                int64_t maxSamples = int64_t(1) << 32)
+    {
+        const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(cli);
+        const int cliqueSize = dcli.clique_size();
+        const NodeId n = dag.num_nodes();
+        const double start = omp_get_wtime();
+
+        Estimate estimate;
+        estimate.confidence = budget.confidence;
+        if(cliqueSize <= 2)
+        {
+            estimate.value = estimate.lower = estimate.upper = cliqueSize == 1 ? n : dag.num_edges();
+            estimate.seconds = omp_get_wtime() - start;
+            return estimate;
+        }
+
+        uint coreNumber = 0;
+        #pragma omp parallel for reduction(max : coreNumber)
+        for(NodeId node = 0; node < n; node++)
+        {
+            coreNumber = std::max<uint>(coreNumber, dag.out_degree(node));
+        }
+
+        const int threads = omp_get_max_threads();
+        std::vector<TuranShadow> local(threads);
+        #pragma omp parallel num_threads(threads)
+        {
+            Builders::SubGraphBuilder<CSRGraph> builder(dag, coreNumber);
+            ShadowBuilder shadowBuilder(coreNumber, local[omp_get_thread_num()]);
+
+            #pragma omp for schedule(dynamic, 1) nowait
+            for(NodeId node = 0; node < n; node++)
+            {
+                if(dag.out_degree(node) < cliqueSize - 1) continue;
+                CSRGraph graph = builder.buildSubGraph(node);
+                shadowBuilder.add(graph, dag.out_neigh(node).begin(), cliqueSize - 1);
+            }
+        }
+
+        TuranShadow shadow;
+        for(TuranShadow& part : local)
+        {
+            const int64_t base = shadow.vertices.size();
+            shadow.vertices.insert(shadow.vertices.end(), part.vertices.begin(), part.vertices.end());
+            for(size_t i = 1; i < part.offsets.size(); i++)
+            {
+                shadow.offsets.push_back(base + part.offsets[i]);
+            }
+            shadow.sizes.insert(shadow.sizes.end(), part.sizes.begin(), part.sizes.end());
+            shadow.weights.insert(shadow.weights.end(), part.weights.begin(), part.weights.end());
+            shadow.exact += part.exact;
+            part = TuranShadow();
+        }
+
+        std::vector<double> cumulative(shadow.leaves());
+        double weight = 0.;
+        for(size_t i = 0; i < shadow.leaves(); i++)
+        {
+            weight += shadow.weights[i];
+            cumulative[i] = weight;
+        }
+
+        estimate.value = estimate.lower = estimate.upper = shadow.exact;
+        if(weight == 0.)
+        {
+            estimate.seconds = omp_get_wtime() - start;
+            return estimate;
+        }
+
+        int64_t samples = 0, successes = 0;
+        int64_t batch = int64_t(1) << 14;
+        while(true)
+        {
+            int64_t hits = 0;
+            #pragma omp parallel reduction(+ : hits)
+            {
+                std::vector<NodeId> chosen;
+                #pragma omp for schedule(static)
+                for(int64_t s = samples; s < samples + batch; s++)
+                {
+                    SampleRandom random(budget.seed, s);
+                    const size_t leaf = std::min<size_t>(shadow.leaves() - 1,
+                        std::upper_bound(cumulative.begin(), cumulative.end(), random.uniform() * weight)
+                        - cumulative.begin());
+                    const NodeId* vertices = shadow.vertices.data() + shadow.offsets[leaf];
+                    const int64_t size = shadow.offsets[leaf + 1] - shadow.offsets[leaf];
+                    const int l = shadow.sizes[leaf];
+
+                    // Floyd's algorithm for a uniform l-subset of the leaf
+                    chosen.clear();
+                    for(int64_t j = size - l; j < size; j++)
+                    {
+                        const NodeId t = random.below(j + 1);
+                        chosen.push_back(std::find(chosen.begin(), chosen.end(), t) == chosen.end() ? t : j);
+                    }
+
+                    bool clique = true;
+                    for(int a = 0; a < l && clique; a++)
+                    {
+                        for(int b = a + 1; b < l && clique; b++)
+                        {
+                            clique = adjacent(dag, vertices[chosen[a]], vertices[chosen[b]]);
+                        }
+                    }
+                    hits += clique;
+                }
+            }
+            samples += batch;
+            successes += hits;
+
+            Estimate fraction;
+            const double halfWidth = Estimation::binomial_estimate(successes, samples, budget.confidence, fraction);
+            estimate.value = shadow.exact + weight * fraction.value;
+            estimate.lower = shadow.exact + weight * fraction.lower;
+            estimate.upper = shadow.exact + weight * fraction.upper;
+            estimate.samples = samples;
+            estimate.seconds = omp_get_wtime() - start;
+
+            if(weight * halfWidth <= budget.relative_error * estimate.value) break;
+            if(budget.seconds > 0 && estimate.seconds >= budget.seconds) break;
+            if(samples >= maxSamples) break;
+            batch = std::min(samples, maxSamples - samples);
+        }
+        return estimate;
+    }
+}
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <optional>
+#include <vector>
+#include <omp.h>
+
+#include <gms/common/types.h>
+#include "gms/third_party/gapbs/gapbs.h"
+
+#include "kclisting.h"
+#include "../parallelizationStrategy/SubGraphBuilder.h"
+#include "../parallelizationStrategy/parallelize.h"
+#include "../parallelizationStrategy/util.h"
+
+namespace GMS::KClique
+{
+    /**
+     * @brief Result of the k-clique densest subgraph approximation: the vertices of the densest subgraph found and
+     * its k-clique density, the number of k-cliques per vertex.
+     */
+    struct DensestSubgraph
+    {
+        std::vector<NodeId> vertices;
+        unsigned long long cliques = 0;
+        double density = 0.;
+        int rounds = 0;
+        int incrementalRounds = 0; // rounds which only listed the cliques of the peeled vertices
+
+        void print() const
+        {
+            std::printf("%-21s%zu\n", "Densest Subgraph:", vertices.size());
+            std::printf("%-21s%llu\n", "Cliques:", cliques);
+            std::printf("%-21s%.4f\n", "Clique Density:", density);
+            std::printf("%-21s%d\n", "Peeling Rounds:", rounds);
+            std::printf("%-21s%d\n", "Incremental Rounds:", incrementalRounds);
+        }
+    };
+
+    /**
+     * @brief Updates the k-clique counts of the vertices of an oriented graph when a batch of vertices is peeled, by
+     * listing only the k-cliques which contain a peeled vertex. Such a clique is listed at its smallest peeled vertex
+     * p, as p and a (k-1)-clique of the oriented graph induced on the neighbours of p which are alive and either not
+     * peeled or peeled with a larger id than p. The neighbourhoods in both directions are built once, on construction.
+     */
+    class CliquePeeling
+    {
+    private:
+        const CSRGraph& _dag;
+        const int _cliqueSize;
+        // neighbours of u in both directions, sorted, at _neighbors[_offsets[u] .. _offsets[u + 1])
+        std::vector<int64_t> _offsets;
+        std::vector<NodeId> _neighbors;
+
+    public:
+        CliquePeeling(const CSRGraph& dag, int cliqueSize)
+        : _dag(dag), _cliqueSize(cliqueSize), _offsets(dag.num_nodes() + 1, 0), _neighbors(2 * dag.num_edges_directed())
+        {
+            const NodeId n = dag.num_nodes();
+            for(NodeId u = 0; u < n; u++)
+            {
+                _offsets[u + 1] += dag.out_degree(u);
+                for(NodeId w : dag.out_neigh(u)) _offsets[w + 1]++;
+            }
+            for(NodeId u = 0; u < n; u++) _offsets[u + 1] += _offsets[u];
+            std::vector<int64_t> fill(_offsets.begin(), _offsets.end() - 1);
+            for(NodeId u = 0; u < n; u++)
+            {
+                for(NodeId w : dag.out_neigh(u))
+                {
+                    _neighbors[fill[u]++] = w;
+                    _neighbors[fill[w]++] = u;
+                }
+            }
+            #pragma omp parallel for schedule(dynamic, 1024)
+            for(NodeId u = 0; u < n; u++)
+            {
+                std::sort(_neighbors.begin() + _offsets[u], _neighbors.begin() + _offsets[u + 1]);
+            }
+        }
+
+        /**
+         * @brief Subtracts the k-cliques of the peeled vertices from vertexCounts.
+         *
+         * @param state 1 for the vertices which stay, 2 for the peeled ones, 0 for the vertices peeled before
+         * @return unsigned long long Number of k-cliques which contain a peeled vertex
+         */
+        unsigned long long peel(const std::vector<NodeId>& peeled, const std::vector<char>& state,
+                                std::vector<unsigned long long>& vertexCounts) const
+        {
+            const NodeId n = _dag.num_nodes();
+            int length = 1;
+            #ifdef _OPENMP
+            length = omp_get_max_threads();
+            #endif
+            std::vector<std::vector<unsigned long long>> threadLost(length);
+
+            unsigned long long destroyed = 0;
+            #pragma omp parallel num_threads(length) reduction(+:destroyed)
+            {
+                #ifdef _OPENMP
+                const int id = omp_get_thread_num();
+                #else
+                const int id = 0;
+                #endif
+                threadLost[id].assign(n, 0);
+                Subgraph sub(n, _cliqueSize, threadLost[id]);
+
+                #pragma omp for schedule(dynamic, 1)
+                for(size_t i = 0; i < peeled.size(); i++)
+                {
+                    const NodeId p = peeled[i];
+                    sub.ids.clear();
+                    for(int64_t e = _offsets[p]; e < _offsets[p + 1]; e++)
+                    {
+                        const NodeId w = _neighbors[e];
+                        if(state[w] == 1 || (state[w] == 2 && w > p)) sub.ids.push_back(w);
+                    }
+                    if(sub.ids.size() + 1 < static_cast<size_t>(_cliqueSize)) continue;
+                    build(sub);
+                    destroyed += list(sub, 0, _cliqueSize - 1);
+                }
+            }
+
+            #pragma omp parallel for schedule(static)
+            for(NodeId v = 0; v < n; v++)
+            {
+                for(const auto& lost : threadLost) vertexCounts[v] -= lost[v];
+            }
+            return destroyed;
+        }
+
+        // Edges scanned by peel to build the subgraphs of the peeled vertices.
+        unsigned long long work(const std::vector<NodeId>& peeled, const std::vector<char>& state) const
+        {
+            unsigned long long work = 0;
+            #pragma omp parallel for schedule(dynamic, 64) reduction(+:work)
+            for(size_t i = 0; i < peeled.size(); i++)
+            {
+                const NodeId p = peeled[i];
+                for(int64_t e = _offsets[p]; e < _offsets[p + 1]; e++)
+                {
+                    const NodeId w = _neighbors[e];
+                    if(state[w] == 1 || (state[w] == 2 && w > p)) work += _dag.out_degree(w);
+                }
+            }
+            return work;
+        }
+
+    private:
+        /**
+         * The oriented subgraph induced on the candidates (ids) of a peeled vertex, in local ids (the positions in ids,
+         * which are sorted, so the local neighbourhoods are sorted as well).
+         */
+        struct Subgraph
+        {
+            std::vector<NodeId> local; // local id of a candidate, -1 for the other vertices
+            std::vector<NodeId> ids;
+            std::vector<int64_t> offsets;
+            std::vector<NodeId> neighbors;
+            std::vector<std::vector<NodeId>> levels; // candidates per recursion depth, in local ids
+            std::vector<unsigned long long>& lost;
+
+            Subgraph(NodeId n, int cliqueSize, std::vector<unsigned long long>& lost)
+            : local(n, -1), levels(cliqueSize), lost(lost)
+            {}
+        };
+
+        void build(Subgraph& sub) const
+        {
+            const NodeId size = sub.ids.size();
+            for(NodeId i = 0; i < size; i++) sub.local[sub.ids[i]] = i;
+            sub.offsets.assign(1, 0);
+            sub.neighbors.clear();
+            for(NodeId u : sub.ids)
+            {
+                for(NodeId w : _dag.out_neigh(u))
+                {
+                    if(sub.local[w] >= 0) sub.neighbors.push_back(sub.local[w]);
+                }
+                sub.offsets.push_back(sub.neighbors.size());
+            }
+            for(NodeId u : sub.ids) sub.local[u] = -1;
+
+            sub.levels[0].resize(size);
+            for(NodeId i = 0; i < size; i++) sub.levels[0][i] = i;
+        }
+
+        // Number of l-cliques among sub.levels[depth], each of them is added to the lost counts of its vertices.
+        unsigned long long list(Subgraph& sub, int depth, int l) const
+        {
+            if(l == 0) return 1;
+            const std::vector<NodeId>& candidates = sub.levels[depth];
+            if(candidates.size() < static_cast<size_t>(l)) return 0;
+            unsigned long long total = 0;
+            for(NodeId u : candidates)
+            {
+                unsigned long long cliques = 1;
+                if(l > 1)
+                {
+                    std::vector<NodeId>& next = sub.levels[depth + 1];
+                    next.clear();
+                    std::set_intersection(candidates.begin(), candidates.end(), sub.neighbors.begin() + sub.offsets[u],
+                                          sub.neighbors.begin() + sub.offsets[u + 1], std::back_inserter(next));
+                    cliques = list(sub, depth + 1, l - 1);
+                }
+                sub.lost[sub.ids[u]] += cliques;
+                total += cliques;
+            }
+            return total;
+        }
+    };
+
+    // Edges scanned by Parallelize::nodeLocal to build the subgraphs of the vertices with state 1.
+    inline unsigned long long subgraphWork(const CSRGraph& dag, const std::vector<char>& state)
+    {
+        unsigned long long work = 0;
+        #pragma omp parallel for schedule(dynamic, 256) reduction(+:work)
+        for(NodeId u = 0; u < dag.num_nodes(); u++)
+        {
+            if(state[u] != 1) continue;
+            for(NodeId w : dag.out_neigh(u))
+            {
+                if(state[w] == 1) work += dag.out_degree(w);
+            }
+        }
+        return work;
+    }
+
+    /**
+     * @brief Parallel peeling approximation of the k-clique densest subgraph (Tsourakakis, WWW 2015, with the
+     * batched peeling of Bahmani et al., VLDB 2012). The k-cliques of every vertex are counted once with
+     * Parallelize::nodeLocal, then each round removes all vertices with at most (1 + epsilon) k times the current
+     * density, i.e. at least a fraction epsilon / (1 + epsilon) of them. The counts are updated by listing only the
+     * cliques of the removed vertices (see CliquePeeling), or recounted on the remaining graph, whichever is estimated
+     * to be cheaper: on skewed graphs the first rounds remove most vertices but few cliques, the later ones the other
+     * way around. The densest of the peeled subgraphs is within a factor
+     * k (1 + epsilon) of the optimum, after O(log n / epsilon) rounds.
+     *
+     * @param dag Oriented graph with sorted neighbourhoods (see CliqueCountPipeline::Preprocess), clique size >= 2
+     * @param epsilon Trades the approximation factor for the number of rounds
+     */
+    template<typename Builder_T = Builders::SubGraphBuilder<CSRGraph>, typename Counter_T = KcListing<CSRGraph>>
+    DensestSubgraph densestSubgraph(const CSRGraph& dag, const CLApp& cli, double epsilon = 0.1)
+    {
+        const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(cli);
+        const int cliqueSize = dcli.clique_size();
+        const NodeId n = dag.num_nodes();
+
+        // 1: alive, 2: peeled in the current round, 0: peeled before
+        std::vector<char> state(n, 1);
+        std::vector<unsigned long long> vertexCounts;
+        unsigned long long cliques = Parallelize::nodeLocal<Builder_T, Counter_T, CSRGraph>(dag, cli, vertexCounts);
+        std::optional<CliquePeeling> peeling; // built by the first round which estimates its cost
+        std::vector<NodeId> peeled;
+        NodeId remaining = n;
+        DensestSubgraph best;
+
+        while(remaining > 0)
+        {
+            best.rounds++;
+            const double density = static_cast<double>(cliques) / remaining;
+            if(density > best.density || best.rounds == 1)
+            {
+                best.density = density;
+                best.cliques = cliques;
+                best.vertices.clear();
+                for(NodeId v = 0; v < n; v++)
+                {
+                    if(state[v]) best.vertices.push_back(v);
+                }
+            }
+            if(cliques == 0) break;
+
+            const double threshold = (1. + epsilon) * cliqueSize * density;
+            peeled.clear();
+            unsigned long long peeledCounts = 0; // at least the number of cliques which are removed
+            for(NodeId v = 0; v < n; v++)
+            {
+                if(state[v] && vertexCounts[v] <= threshold)
+                {
+                    state[v] = 2;
+                    peeled.push_back(v);
+                    peeledCounts += vertexCounts[v];
+                }
+            }
+
+            // Estimated costs of both updates, in scanned edges: building the subgraphs of the peeled vertices or of the
+            // remaining ones, plus listing the removed cliques (at most peeledCounts) or counting the remaining ones.
+            bool incremental = false;
+            if(2 * peeledCounts < cliques)
+            {
+                if(!peeling) peeling.emplace(dag, cliqueSize);
+                const unsigned long long cliqueCost = std::max(1, 4 * (cliqueSize - 2));
+                incremental = peeling->work(peeled, state) + cliqueCost * peeledCounts
+                              <= subgraphWork(dag, state) + cliqueCost * (cliques - peeledCounts);
+            }
+            if(incremental)
+            {
+                cliques -= peeling->peel(peeled, state, vertexCounts);
+                best.incrementalRounds++;
+            }
+            else
+            {
+                const CSRGraph current = Builders::filterEdges(dag, [&](NodeId u, NodeId w) { return state[u] == 1 && state[w] == 1; });
+                cliques = Parallelize::nodeLocal<Builder_T, Counter_T, CSRGraph>(current, cli, vertexCounts);
+            }
+            for(NodeId v : peeled)
+            {
+                state[v] = 0;
+            }
+            remaining -= peeled.size();
+        }
+        return best;
+    }
+}
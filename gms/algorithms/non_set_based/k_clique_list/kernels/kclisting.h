@@ -4,6 +4,7 @@
 #include <iostream>
 #include <cassert>
 #include <algorithm>
+#include <type_traits>
 
 
 #include <gms/common/types.h>
@@ -25,6 +26,8 @@ namespace GMS::KClique
         pvector<uint> _label;
         pvector<pvector<NodeId>> _subGraph;
         pvector<pvector<uint>> _subDegree;
+        pvector<NodeId> _path;
+        pvector<NodeId> _index;
         unsigned long long _count;
 
         void doCounting()
@@ -113,6 +116,160 @@ namespace GMS::KClique
             }
         }
 
+        /*
+        Same recursion as listing, but returns the number of cliques found below the current level and reports for
+        every vertex (and edge) of the subgraph how many of them contain it. The cliques of the last level are
+        aggregated per node of _subGraph[2], the counts of the other levels per subtree, so the work per clique stays
+        constant for vertices and proportional to the clique size for edges. _path[l] is the node chosen at level l.
+        */
+        template <class Local_T>
+        unsigned long long listingLocal(CGraph& g, const uint level, Local_T& local)
+        {
+            unsigned long long total = 0;
+            if(level == 2)
+            {
+                for(NodeId node : _subGraph[2])
+                {
+                    const uint degree = _subDegree[2][node];
+                    if(degree == 0) continue;
+                    total += degree;
+                    local.vertex(node, degree);
+                    const auto startNh = g.out_neigh(node).begin();
+                    for(uint i = 0; i < degree; i++)
+                    {
+                        local.vertex(startNh[i], 1);
+                        if(local.edges())
+                        {
+                            local.edge(node, startNh[i], 1);
+                            for(int l = level + 1; l <= CliqueSize; l++)
+                            {
+                                local.edge(_path[l], startNh[i], 1);
+                            }
+                        }
+                    }
+                    if(local.edges())
+                    {
+                        for(int l = level + 1; l <= CliqueSize; l++)
+                        {
+                            local.edge(_path[l], node, degree);
+                        }
+                    }
+                }
+                return total;
+            }
+
+            for(NodeId node : _subGraph[level])
+            {
+                _path[level] = node;
+                buildSubGraph(g, node, level);
+                orderAndCount(g, level);
+                const unsigned long long count = listingLocal(g, level-1, local);
+                restoreLabels(level);
+
+                if(count == 0) continue;
+                total += count;
+                local.vertex(node, count);
+                if(local.edges())
+                {
+                    for(int l = level + 1; l <= CliqueSize; l++)
+                    {
+                        local.edge(_path[l], node, count);
+                    }
+                }
+            }
+            return total;
+        }
+
+        // The subgraph induced by _subGraph[level] as a compact CSR graph, its adjacency lists are the first
+        // _subDegree[level] entries of the neighbourhoods (see orderAndCount).
+        CSRGraph extract(CGraph& g, const uint level)
+        {
+            const NodeId count = _subGraph[level].size();
+            int64_t edges = 0;
+            for(NodeId i = 0; i < count; i++)
+            {
+                const NodeId node = _subGraph[level][i];
+                _index[node] = i;
+                edges += _subDegree[level][node];
+            }
+
+            NodeId *out_neighs = new NodeId[edges];
+            NodeId **out_index = new NodeId*[count+1];
+            int64_t cd = 0;
+            for(NodeId i = 0; i < count; i++)
+            {
+                const NodeId node = _subGraph[level][i];
+                out_index[i] = &out_neighs[cd];
+                const auto startNh = g.out_neigh(node).begin();
+                for(uint j = 0; j < _subDegree[level][node]; j++)
+                {
+                    out_neighs[cd++] = _index[startNh[j]];
+                }
+            }
+            out_index[count] = &out_neighs[cd];
+            return CSRGraph(count, out_index, out_neighs, nullptr, nullptr);
+        }
+
+        /*
+        Same recursion as listing, but the subtree of a node whose candidate subgraph has at least threshold edges is
+        handed to spawn as a separate subproblem: its (level-1)-cliques are those of the extracted subgraph.
+        */
+        template <class Spawn_T>
+        void listingSplit(CGraph& g, const uint level, const uint64_t threshold, Spawn_T& spawn)
+        {
+            if(level == 2 || level == 1)
+            {
+                doCounting();
+                return;
+            }
+
+            for(NodeId node : _subGraph[level])
+            {
+                buildSubGraph(g, node, level);
+                orderAndCount(g, level);
+
+                uint64_t edges = 0;
+                if(level - 1 >= 3)
+                {
+                    for(NodeId innerNode : _subGraph[level-1])
+                    {
+                        edges += _subDegree[level-1][innerNode];
+                    }
+                }
+                if(level - 1 >= 3 && edges >= threshold)
+                {
+                    spawn(extract(g, level-1), level-1);
+                }
+                else
+                {
+                    listingSplit(g, level-1, threshold, spawn);
+                }
+
+                restoreLabels(level);
+            }
+        }
+
+        void reset(CGraph& g)
+        {
+            const NodeId nrNodes = g.num_nodes();
+            _label.resize(nrNodes);
+            for(NodeId i = 0; i < nrNodes; i++)
+            {
+                _label[i] = CliqueSize;
+            }
+            for(int i = 2; i < CliqueSize+1; i++)
+            {
+                _subGraph[i].resize(nrNodes);
+                _subDegree[i].resize(nrNodes);
+            }
+
+            for(NodeId i = 0; i < nrNodes; i++)
+            {
+                _subGraph[CliqueSize][i] = i;
+                _subDegree[CliqueSize][i] = g.out_degree(i);
+            }
+        }
+
         void init(const uint coreNumber)
         {
             _label.reserve(coreNumber);
@@ -131,6 +288,8 @@ namespace GMS::KClique
         _label(pvector<uint>(0)),
         _subGraph( pvector<pvector<NodeId>>(CliqueSize+1)),
         _subDegree( pvector<pvector<uint>>(CliqueSize+1)),
+        _path(pvector<NodeId>(CliqueSize+1)),
+        _index(pvector<NodeId>(0)),
         _count(0)
         {
             for(int i = 2; i < CliqueSize+1; i++)
@@ -164,28 +323,55 @@ namespace GMS::KClique
         {
             if(CliqueSize == 2) return g.num_edges();
             if(CliqueSize == 1) return g.num_nodes();
-            const NodeId nrNodes = g.num_nodes();
-            _label.resize(nrNodes);
-            for(NodeId i = 0; i < nrNodes; i++)
-            {
-                _label[i] = CliqueSize;
-            }
-            for(int i = 2; i < CliqueSize+1; i++)
-            {
-                _subGraph[i].resize(nrNodes);
-                _subDegree[i].resize(nrNodes);
-            }
-
-            for(NodeId i = 0; i < nrNodes; i++)
-            {
-                _subGraph[CliqueSize][i] = i;
-                _subDegree[CliqueSize][i] = g.out_degree(i);
-            }
+            reset(g);
 
             _count = 0;
             listing(g, CliqueSize);
             return _count;
         }
+
+        /**
+         * @brief Counts the cliques like count, except for the subtrees whose candidate subgraph has at least
+         * threshold edges: spawn(CSRGraph&& subgraph, int cliqueSize) is called for each of them instead, and their
+         * cliques are not part of the returned count.
+         *
+         * @return unsigned long long Number of cliques counted without spawning
+         */
+        template <class Spawn_T>
+        unsigned long long countSplit(CGraph& g, const uint64_t threshold, Spawn_T&& spawn)
+        {
+            static_assert(std::is_same_v<CGraph, CSRGraph>, "subproblems are extracted as CSRGraph");
+            if(CliqueSize <= 2) return count(g);
+            reset(g);
+            _index.resize(g.num_nodes());
+
+            _count = 0;
+            listingSplit(g, CliqueSize, threshold, spawn);
+            return _count;
+        }
+
+        /**
+         * @brief Counts the cliques like count and reports the participation counts of the vertices and edges of g
+         * to local: local.vertex(u, c) and, if local.edges(), local.edge(u, w, c) for an edge u -> w of g, each
+         * called with counts c which add up to the number of cliques containing the vertex or edge. The
+         * neighbourhoods of g are reordered like by count.
+         *
+         * @return unsigned long long Total of counted cliques
+         */
+        template <class Local_T>
+        unsigned long long countLocal(CGraph& g, Local_T& local)
+        {
+            if(CliqueSize == 1)
+            {
+                for(NodeId i = 0; i < g.num_nodes(); i++)
+                {
+                    local.vertex(i, 1);
+                }
+                return g.num_nodes();
+            }
+            reset(g);
+            return listingLocal(g, CliqueSize, local);
+        }
     };
 
 } // namespace GMS::KClique
\ No newline at end of file
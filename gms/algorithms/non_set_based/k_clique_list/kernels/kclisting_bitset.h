@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <vector>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <gms/common/types.h>
+#include "gms/third_party/gapbs/gapbs.h"
+
+#include "kclisting.h"
+
+namespace GMS::KClique
+{
+    namespace Bits
+    {
+#ifdef __AVX2__
+        // Per 64 bit lane popcounts of v, with the nibble lookup of Muła, Kurz and Lemire (Faster Population
+        // Counts Using AVX2 Instructions, The Computer Journal 2018).
+        inline __m256i popcount256(__m256i v)
+        {
+            const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const __m256i lowMask = _mm256_set1_epi8(0x0f);
+            const __m256i low = _mm256_and_si256(v, lowMask);
+            const __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+            const __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+            return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+        }
+
+        inline uint64_t horizontalSum(__m256i v)
+        {
+            return _mm256_extract_epi64(v, 0) + _mm256_extract_epi64(v, 1)
+                + _mm256_extract_epi64(v, 2) + _mm256_extract_epi64(v, 3);
+        }
+#endif
+
+        // |a ∩ b| of two bitsets of `words` words
+        inline uint64_t andCount(const uint64_t* a, const uint64_t* b, size_t words)
+        {
+            uint64_t count = 0;
+            size_t i = 0;
+#ifdef __AVX2__
+            __m256i sum = _mm256_setzero_si256();
+            for(; i + 4 <= words; i += 4)
+            {
+                const __m256i v = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                                   _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+                sum = _mm256_add_epi64(sum, popcount256(v));
+            }
+            count = horizontalSum(sum);
+#endif
+            for(; i < words; i++)
+            {
+                count += __builtin_popcountll(a[i] & b[i]);
+            }
+            return count;
+        }
+
+        // out = a ∩ b, returns |out|
+        inline uint64_t andInto(uint64_t* out, const uint64_t* a, const uint64_t* b, size_t words)
+        {
+            uint64_t count = 0;
+            size_t i = 0;
+#ifdef __AVX2__
+            __m256i sum = _mm256_setzero_si256();
+            for(; i + 4 <= words; i += 4)
+            {
+                const __m256i v = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                                   _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+                sum = _mm256_add_epi64(sum, popcount256(v));
+            }
+            count = horizontalSum(sum);
+#endif
+            for(; i < words; i++)
+            {
+                out[i] = a[i] & b[i];
+                count += __builtin_popcountll(out[i]);
+            }
+            return count;
+        }
+    }
+
+    /**
+     * @brief k-clique counting on the bit adjacency matrix of a (sub-)graph, for the small, dense subgraphs left
+     * after degeneracy orientation (in the spirit of BitCol and ARB-count). The candidates of every level are a
+     * bitset, intersected with the out-neighbourhood row of the chosen node and counted with popcounts (AVX2 if
+     * available) instead of KcListing's labels and reordering of the adjacency lists. The graph must be acyclic, as
+     * the subgraphs of an oriented graph are, then every clique is found once, from its first node.
+     *
+     * Subgraphs with more than TMaxNodes nodes are counted by KcListing.
+     */
+    template <class CGraph = CSRGraph, uint TMaxNodes = 1024>
+    class KcListingBitset
+    {
+    public:
+        const int CliqueSize;
+
+    private:
+        const uint _maxNodes;
+        const size_t _maxWords;
+        size_t _words;
+        std::vector<uint64_t> _rows;
+        std::vector<uint64_t> _candidates;
+        KcListing<CGraph> _fallback;
+
+        uint64_t* row(NodeId node) { return _rows.data() + node * _words; }
+        uint64_t* candidates(int level) { return _candidates.data() + level * _maxWords; }
+
+        unsigned long long listing(const int level)
+        {
+            uint64_t* cand = candidates(level);
+            unsigned long long count = 0;
+            for(size_t w = 0; w < _words; w++)
+            {
+                for(uint64_t bits = cand[w]; bits != 0; bits &= bits - 1)
+                {
+                    const NodeId node = w * 64 + __builtin_ctzll(bits);
+                    if(level == 2)
+                    {
+                        count += Bits::andCount(row(node), cand, _words);
+                    }
+                    else if(Bits::andInto(candidates(level-1), row(node), cand, _words) >= uint64_t(level-1))
+                    {
+                        count += listing(level-1);
+                    }
+                }
+            }
+            return count;
+        }
+
+    public:
+        KcListingBitset(const int cliqueSize, const uint coreNumber)
+        : CliqueSize(cliqueSize), _maxNodes(std::min(coreNumber, TMaxNodes)), _maxWords((_maxNodes + 63) / 64),
+        _words(0), _rows(static_cast<size_t>(_maxNodes) * _maxWords),
+        _candidates(static_cast<size_t>(std::max(cliqueSize, 1) + 1) * _maxWords),
+        _fallback(cliqueSize, coreNumber)
+        {}
+
+        unsigned long long count(CGraph& g)
+        {
+            if(CliqueSize == 2) return g.num_edges();
+            if(CliqueSize == 1) return g.num_nodes();
+            const NodeId nrNodes = g.num_nodes();
+            if(nrNodes > static_cast<NodeId>(_maxNodes)) return _fallback.count(g);
+            if(nrNodes < CliqueSize) return 0;
+
+            _words = (nrNodes + 63) / 64;
+            std::fill(_rows.begin(), _rows.begin() + nrNodes * _words, 0);
+            for(NodeId node = 0; node < nrNodes; node++)
+            {
+                uint64_t* r = row(node);
+                for(NodeId neigh : g.out_neigh(node))
+                {
+                    r[neigh / 64] |= uint64_t(1) << (neigh % 64);
+                }
+            }
+
+            uint64_t* all = candidates(CliqueSize);
+            std::fill(all, all + _words, ~uint64_t(0));
+            if(nrNodes % 64 != 0) all[_words - 1] = (uint64_t(1) << (nrNodes % 64)) - 1;
+            return listing(CliqueSize);
+        }
+    };
+}
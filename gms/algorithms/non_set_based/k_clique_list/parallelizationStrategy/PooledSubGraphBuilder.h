@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cinttypes>
+#include <algorithm>
+#include <vector>
+
+#include "util.h"
+#include "gms/third_party/gapbs/gapbs.h"
+
+namespace GMS::KClique::Builders
+{
+    /**
+     * @brief Non-owning view of a subgraph in CSR format, with the interface of CSRGraph used by the Counter_T
+     * kernels. The neighbourhoods are mutable, the kernels reorder them.
+     */
+    class SubGraphView
+    {
+    public:
+        class Neighborhood
+        {
+        private:
+            NodeId* _begin;
+            NodeId* _end;
+
+        public:
+            Neighborhood(NodeId* begin, NodeId* end) : _begin(begin), _end(end) {}
+
+            NodeId* begin() const { return _begin; }
+            NodeId* end() const { return _end; }
+        };
+
+    private:
+        NodeId _numNodes;
+        const int64_t* _offsets;
+        NodeId* _neighs;
+
+    public:
+        SubGraphView(NodeId numNodes, const int64_t* offsets, NodeId* neighs)
+        : _numNodes(numNodes), _offsets(offsets), _neighs(neighs)
+        {}
+
+        NodeId num_nodes() const { return _numNodes; }
+        int64_t num_edges() const { return _offsets[_numNodes] - _offsets[0]; }
+        bool directed() const { return true; }
+        int64_t out_degree(NodeId node) const { return _offsets[node + 1] - _offsets[node]; }
+
+        Neighborhood out_neigh(NodeId node) const
+        {
+            return Neighborhood(_neighs + _offsets[node], _neighs + _offsets[node + 1]);
+        }
+    };
+
+    /**
+     * @brief Builds the same subgraphs as SubGraphBuilder, but into arenas owned by the builder (one per thread):
+     * the adjacency array is exactly as large as the subgraph, it only grows when a larger subgraph than before is
+     * built, so in the steady state no memory is allocated per vertex or edge. The returned SubGraphView is valid
+     * until the next call of buildSubGraph.
+     */
+    template <class CGraph = CSRGraph>
+    class PooledSubGraphBuilder
+    {
+    private:
+        const CGraph& _origGraph;
+        uint _coreNumber;
+        SimpleMapping<NodeId> _mapping;
+        SimpleMapping<NodeId> _controlMapping;
+        std::vector<int64_t> _offsets;
+        std::vector<NodeId> _neighs;
+
+        // makes room for the neighbours of one more node
+        void reserve(int64_t size)
+        {
+            if(size > static_cast<int64_t>(_neighs.size()))
+            {
+                _neighs.resize(std::max<int64_t>(size, 2 * _neighs.size()));
+            }
+        }
+
+        template <class Nodes_T>
+        SubGraphView fill(const Nodes_T& nodes, const uint count)
+        {
+            int64_t cd = 0;
+            uint index = 0;
+            _offsets[0] = 0;
+            for(NodeId currNode : nodes)
+            {
+                reserve(cd + std::min<int64_t>(_origGraph.out_degree(currNode), count));
+                for(NodeId neigh : _origGraph.out_neigh(currNode))
+                {
+                    if(_mapping.AlreadyMapped(neigh))
+                    {
+                        _neighs[cd++] = _mapping.NewIndex(neigh);
+                    }
+                }
+                _offsets[++index] = cd;
+            }
+            return SubGraphView(count, _offsets.data(), _neighs.data());
+        }
+
+    public:
+        PooledSubGraphBuilder(const CGraph& g, const uint coreNumber)
+        : _origGraph(g), _coreNumber(coreNumber), _mapping(SimpleMapping<NodeId>(_coreNumber, _origGraph.num_nodes())),
+        _controlMapping(SimpleMapping<NodeId>(_coreNumber, _origGraph.num_nodes())),
+        _offsets(coreNumber + 1), _neighs(coreNumber)
+        {
+        }
+
+        SubGraphView buildSubGraph(NodeId node)
+        {
+            _mapping.Clear();
+            for(NodeId neigh : _origGraph.out_neigh(node))
+            {
+                _mapping.MapNode(neigh);
+            }
+            return fill(_origGraph.out_neigh(node), _origGraph.out_degree(node));
+        }
+
+        SubGraphView buildSubGraph(NodeId u, NodeId v)
+        {
+            _controlMapping.Clear();
+            _mapping.Clear();
+            for(NodeId neigh : _origGraph.out_neigh(u))
+            {
+                _controlMapping.MapNode(neigh);
+            }
+
+            uint count = 0;
+            for(NodeId neigh : _origGraph.out_neigh(v))
+            {
+                if(_controlMapping.AlreadyMapped(neigh))
+                {
+                    _mapping.MapNode(neigh);
+                    count++;
+                }
+            }
+            // iterate through the common neighbours in the order of v, because they induce the new index
+            return fill(_mapping, count);
+        }
+
+        const SimpleMapping<NodeId>& GetMapping() const
+        {
+            return _mapping;
+        }
+
+        uint CoreNumber() const { return _coreNumber; }
+    };
+}
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <memory>
 #include <vector>
 #include <omp.h>
 
 #include <gms/common/types.h>
+#include <gms/common/estimate.h>
 #include "gms/third_party/gapbs/gapbs.h"
 
 
@@ -14,14 +19,45 @@ namespace GMS::KClique {
 class CLCliqueApp : public GMS::CLI::GapbsCompat {
 protected:
     int clique_size_ = 8;
+    GMS::Estimation::Budget budget_;
+    double peeling_epsilon_ = 0.1;
+    uint64_t task_threshold_ = 4096;
+    std::vector<NodeId> original_ids_;
+    GMS::OrderingCache::Mode ordering_cache_mode_;
+    std::string ordering_cache_;
 
 public:
-    CLCliqueApp(const GMS::CLI::Args &args, const GMS::CLI::Param &clique_size) : GMS::CLI::GapbsCompat(args)
+    CLCliqueApp(const GMS::CLI::Args &args, const GMS::CLI::Param &clique_size) : GMS::CLI::GapbsCompat(args),
+        original_ids_(args.original_ids), ordering_cache_mode_(args.ordering_cache_mode()),
+        ordering_cache_(args.ordering_cache)
     {
         clique_size_ = clique_size.to_int();
     }
 
     int clique_size() const { return clique_size_;}
+
+    // Error budget of the approximate counter
+    void set_approximation(const GMS::Estimation::Budget &budget)
+    {
+        budget_ = budget;
+    }
+
+    const GMS::Estimation::Budget& budget() const { return budget_; }
+
+    // Approximation parameter of the k-clique densest subgraph peeling
+    void set_peeling_epsilon(double epsilon) { peeling_epsilon_ = epsilon; }
+    double peeling_epsilon() const { return peeling_epsilon_; }
+
+    // Number of edges of a candidate subgraph from which the work stealing parallelizations spawn a task for it
+    void set_task_threshold(uint64_t threshold) { task_threshold_ = threshold; }
+    uint64_t task_threshold() const { return task_threshold_; }
+
+    // Id in the input file of vertex v of the (relabeled) graph, see CLI::Args::original_ids
+    NodeId original_id(NodeId v) const { return original_ids_.empty() ? v : original_ids_[v]; }
+
+    // Persistent store of the orderings, see CLI::Args::ordering_cache
+    GMS::OrderingCache::Mode ordering_cache_mode() const { return ordering_cache_mode_; }
+    const std::string &ordering_cache() const { return ordering_cache_; }
 };
 
 namespace Parallelize
@@ -30,7 +66,8 @@ namespace Parallelize
      * @brief Simple parallelization over the nodes/vertices of a graph
      *
      * @tparam Builder_T Able to construct a subgraph given a graph and a node
-     * @tparam Counter_T Able to count the k-cliques within a (sub-)graph
+     * @tparam Counter_T Able to count the k-cliques within a (sub-)graph of the type built by Builder_T (CGraph,
+     * or SubGraphView for PooledSubGraphBuilder)
      * @param g The complete graph
      * @param cli Command line interface with relevant parameters
      * @return unsigned long long Total of counted k-cliques
@@ -58,7 +95,7 @@ namespace Parallelize
             #pragma omp for schedule(dynamic, 1) nowait
             for(NodeId node = 0; node < g.num_nodes(); node++)
             {
-                CGraph graph = builder.buildSubGraph(node);
+                auto graph = builder.buildSubGraph(node);
                 count += counter.count(graph);
             }
         }
@@ -112,7 +149,7 @@ namespace Parallelize
                     u_counter++;
                 }
 
-                CGraph graph = builder.buildSubGraph(u_counter, *it);
+                auto graph = builder.buildSubGraph(u_counter, *it);
                 count += counter.count(graph);
             }
         }
@@ -186,7 +223,7 @@ namespace Parallelize
                             #ifndef _OPENMP
                             int iid = 0;
                             #endif
-                            CGraph graph = builders[iid]->buildSubGraph(node, neigh);
+                            auto graph = builders[iid]->buildSubGraph(node, neigh);
                             thread_count[iid] += counters[iid]->count(graph);
                         }
                     }
@@ -256,7 +293,7 @@ namespace Parallelize
             #pragma omp for schedule(dynamic, 1) nowait
             for(size_t i = 0; i < g.num_edges(); i++)
             {
-                CGraph graph = builder.buildSubGraph(start[i], target[i]);
+                auto graph = builder.buildSubGraph(start[i], target[i]);
                 #ifdef _OPENMP
                 int id = omp_get_thread_num();
                 #endif
@@ -328,7 +365,7 @@ namespace Parallelize
                     {
                         #pragma omp task
                         {
-                            CGraph graph = builder.buildSubGraph(node, neigh);
+                            auto graph = builder.buildSubGraph(node, neigh);
                             count += counter.count(graph);
                         }
                     }
@@ -338,7 +375,7 @@ namespace Parallelize
                 {
                     #pragma omp task
                     {
-                        CGraph graph = builder.buildSubGraph(node);
+                        auto graph = builder.buildSubGraph(node);
                         count += counter.count(graph);
                     }
                 }
@@ -351,6 +388,380 @@ namespace Parallelize
     }
 
 
+
+    /**
+     * @brief Thread local participation counts of nodeLocal. The subgraph of root has the out-neighbours of root
+     * as vertices, in the order of out_neigh(root), its counts are collected in local ids (the edge counts in a
+     * dense matrix) and added to the counts of the graph by finish.
+     */
+    template<typename CGraph = CSRGraph>
+    class LocalCounts
+    {
+    private:
+        const CGraph& _g;
+        const std::vector<int64_t>& _offsets;
+        std::vector<unsigned long long>& _vertices;
+        std::vector<unsigned long long>& _edges;
+        const bool _trackEdges;
+        NodeId _root = 0;
+        std::vector<NodeId> _ids;
+        std::vector<unsigned long long> _local;
+        std::vector<unsigned long long> _localEdges;
+
+    public:
+        LocalCounts(const CGraph& g, const std::vector<int64_t>& offsets, std::vector<unsigned long long>& vertices,
+                    std::vector<unsigned long long>& edges, bool trackEdges)
+        : _g(g), _offsets(offsets), _vertices(vertices), _edges(edges), _trackEdges(trackEdges)
+        {}
+
+        void start(NodeId root)
+        {
+            _root = root;
+            _ids.assign(_g.out_neigh(root).begin(), _g.out_neigh(root).end());
+            _local.assign(_ids.size(), 0);
+            if(_trackEdges) _localEdges.assign(_ids.size() * _ids.size(), 0);
+        }
+
+        bool edges() const { return _trackEdges; }
+
+        void vertex(NodeId u, unsigned long long count) { _local[u] += count; }
+
+        void edge(NodeId u, NodeId w, unsigned long long count) { _localEdges[u * _ids.size() + w] += count; }
+
+        // the cliques of the subgraph, extended by root
+        void finish(unsigned long long total)
+        {
+            if(total == 0) return;
+            _vertices[_root] += total;
+            for(size_t i = 0; i < _ids.size(); i++)
+            {
+                if(_local[i] == 0) continue;
+                _vertices[_ids[i]] += _local[i];
+                if(_trackEdges) _edges[edgeIndex(_root, _ids[i])] += _local[i];
+            }
+            if(!_trackEdges) return;
+            for(size_t i = 0; i < _ids.size(); i++)
+            {
+                for(size_t j = 0; j < _ids.size(); j++)
+                {
+                    const unsigned long long edgeCount = _localEdges[i * _ids.size() + j];
+                    if(edgeCount > 0) _edges[edgeIndex(_ids[i], _ids[j])] += edgeCount;
+                }
+            }
+        }
+
+        // position of the edge u -> w in the CSR adjacency, the neighbourhoods are sorted
+        int64_t edgeIndex(NodeId u, NodeId w) const
+        {
+            const auto neigh = _g.out_neigh(u);
+            return _offsets[u] + std::distance(neigh.begin(), std::lower_bound(neigh.begin(), neigh.end(), w));
+        }
+    };
+
+    /**
+     * @brief Local k-clique counting, parallelized over the nodes like node: the number of k-cliques which contain
+     * each vertex and, if edgeCounts is given, each edge of g. Every thread accumulates into its own arrays, which
+     * are summed up at the end.
+     *
+     * @tparam Counter_T Able to count the k-cliques within a (sub-)graph with countLocal
+     * @param g The complete graph, with sorted neighbourhoods
+     * @param cli Command line interface with relevant parameters
+     * @param vertexCounts Resized to the number of nodes of g
+     * @param edgeCounts If not null, resized to the number of edges of g, indexed by the position of the edge in
+     * the adjacency array (the neighbourhoods of the nodes one after another)
+     * @return unsigned long long Total of counted k-cliques
+     */
+    template<typename Builder_T, typename Counter_T, typename CGraph = CSRGraph>
+    unsigned long long nodeLocal(const CGraph& g, const CLApp& cli, std::vector<unsigned long long>& vertexCounts,
+                                 std::vector<unsigned long long>* edgeCounts = nullptr)
+    {
+        const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(cli);
+        const int cliqueSize = dcli.clique_size();
+        const NodeId n = g.num_nodes();
+        const bool trackEdges = edgeCounts != nullptr;
+
+        std::vector<int64_t> offsets(n + 1, 0);
+        uint coreNumber = 0;
+        for(NodeId node = 0; node < n; node++)
+        {
+            coreNumber = coreNumber > g.out_degree(node) ? coreNumber : g.out_degree(node);
+            offsets[node + 1] = offsets[node] + g.out_degree(node);
+        }
+        vertexCounts.assign(n, cliqueSize == 1 ? 1 : 0);
+        if(trackEdges) edgeCounts->assign(offsets[n], 0);
+        if(cliqueSize == 1) return n;
+
+        int length = 1;
+        #ifdef _OPENMP
+        length = omp_get_max_threads();
+        #endif
+        std::vector<std::vector<unsigned long long>> threadVertices(length);
+        std::vector<std::vector<unsigned long long>> threadEdges(length);
+
+        unsigned long long count = 0;
+        #pragma omp parallel num_threads(length) reduction(+:count)
+        {
+            #ifdef _OPENMP
+            const int id = omp_get_thread_num();
+            #else
+            const int id = 0;
+            #endif
+            threadVertices[id].assign(n, 0);
+            if(trackEdges) threadEdges[id].assign(offsets[n], 0);
+            LocalCounts<CGraph> local(g, offsets, threadVertices[id], threadEdges[id], trackEdges);
+            Builder_T builder(g, coreNumber);
+            Counter_T counter(cliqueSize -1, coreNumber);
+
+            #pragma omp for schedule(dynamic, 1) nowait
+            for(NodeId node = 0; node < n; node++)
+            {
+                auto graph = builder.buildSubGraph(node);
+                local.start(node);
+                const unsigned long long nodeCount = counter.countLocal(graph, local);
+                local.finish(nodeCount);
+                count += nodeCount;
+            }
+        }
+
+        #pragma omp parallel for schedule(static)
+        for(NodeId node = 0; node < n; node++)
+        {
+            for(int t = 0; t < length; t++)
+            {
+                vertexCounts[node] += threadVertices[t][node];
+            }
+        }
+        if(trackEdges)
+        {
+            #pragma omp parallel for schedule(static)
+            for(int64_t e = 0; e < offsets[n]; e++)
+            {
+                for(int t = 0; t < length; t++)
+                {
+                    (*edgeCounts)[e] += threadEdges[t][e];
+                }
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Load balance of the work stealing parallelizations: per thread, the time spent executing tasks and the
+     * time its last task finished, since the start of the counting.
+     */
+    struct TaskStats
+    {
+        std::vector<double> busy;
+        std::vector<double> finish;
+        unsigned long long tasks = 0;
+        unsigned long long spawned = 0;
+        double seconds = 0.;
+
+        // time between the first and the last thread running out of work
+        double tail() const
+        {
+            if(finish.empty()) return 0.;
+            return *std::max_element(finish.begin(), finish.end()) - *std::min_element(finish.begin(), finish.end());
+        }
+
+        void print() const
+        {
+            double sum = 0.;
+            for(double b : busy) sum += b;
+            std::printf("%-21s%llu (%llu spawned)\n", "Tasks:", tasks, spawned);
+            std::printf("%-21s%.5f / %.5f / %.5f\n", "Busy min/avg/max:",
+                        busy.empty() ? 0. : *std::min_element(busy.begin(), busy.end()),
+                        busy.empty() ? 0. : sum / busy.size(),
+                        busy.empty() ? 0. : *std::max_element(busy.begin(), busy.end()));
+            std::printf("%-21s%.5f of %.5f\n", "Tail Latency:", tail(), seconds);
+        }
+    };
+
+    /**
+     * @brief State of one thread of the work stealing parallelizations. The counters are created on first use,
+     * one per clique size: a thread only interrupts a (tied) task to run tasks spawned below it, which count
+     * smaller cliques, so no counter is used by two tasks at the same time.
+     */
+    template<typename Counter_T>
+    struct StealingWorker
+    {
+        std::vector<std::unique_ptr<Counter_T>> counters;
+        unsigned long long count = 0;
+        unsigned long long tasks = 0;
+        unsigned long long spawned = 0;
+        int depth = 0;
+        double begin = 0.;
+        double busy = 0.;
+        double finish = 0.;
+
+        Counter_T& counter(int cliqueSize, uint coreNumber)
+        {
+            if(counters.size() <= static_cast<size_t>(cliqueSize)) counters.resize(cliqueSize + 1);
+            if(!counters[cliqueSize]) counters[cliqueSize] = std::make_unique<Counter_T>(cliqueSize, coreNumber);
+            return *counters[cliqueSize];
+        }
+
+        // nested tasks run by the same thread are only timed once
+        void enter()
+        {
+            if(depth++ == 0) begin = omp_get_wtime();
+        }
+
+        void leave(double start)
+        {
+            tasks++;
+            if(--depth == 0)
+            {
+                const double end = omp_get_wtime();
+                busy += end - begin;
+                finish = end - start;
+            }
+        }
+    };
+
+    /**
+     * @brief Runs the subproblems of the work stealing parallelizations: counts the cliques of a subgraph with
+     * Counter_T::countSplit and spawns an OpenMP task for every large enough subtree, so idle threads steal the
+     * deeper levels of the recursion of hub vertices.
+     */
+    template<typename Counter_T>
+    class StealingRunner
+    {
+    private:
+        std::vector<StealingWorker<Counter_T>>& _workers;
+        const uint _coreNumber;
+        const uint64_t _threshold;
+        const double _start;
+
+        static int thread()
+        {
+            #ifdef _OPENMP
+            return omp_get_thread_num();
+            #else
+            return 0;
+            #endif
+        }
+
+    public:
+        StealingRunner(std::vector<StealingWorker<Counter_T>>& workers, uint coreNumber, uint64_t threshold,
+                       double start)
+        : _workers(workers), _coreNumber(coreNumber), _threshold(threshold), _start(start)
+        {}
+
+        template<typename Graph_T>
+        void run(Graph_T& graph, int cliqueSize)
+        {
+            StealingWorker<Counter_T>& worker = _workers[thread()];
+            worker.enter();
+            const unsigned long long count = worker.counter(cliqueSize, _coreNumber).countSplit(graph, _threshold, *this);
+            worker.count += count;
+            worker.leave(_start);
+        }
+
+        void operator()(CSRGraph&& subgraph, int cliqueSize)
+        {
+            _workers[thread()].spawned++;
+            CSRGraph* task = new CSRGraph(std::move(subgraph));
+            #pragma omp task firstprivate(task, cliqueSize)
+            {
+                run(*task, cliqueSize);
+                delete task;
+            }
+        }
+    };
+
+    /**
+     * @brief Work stealing parallelization over the nodes (or, with TEdges, the edges) of a graph. Every subgraph
+     * is a task, and inside of them Counter_T spawns further tasks for the subtrees of its recursion whose candidate
+     * subgraph has at least cli.task_threshold() edges. Unlike node and edge, a few hub subgraphs don't leave the
+     * other threads idle at the end.
+     *
+     * @tparam Counter_T Able to count the k-cliques within a (sub-)graph with countSplit
+     * @param g The complete graph
+     * @param cli Command line interface with relevant parameters
+     * @param stats If not null, filled with the load balance of the run
+     * @return unsigned long long Total count of k-cliques
+     */
+    template<typename Builder_T, typename Counter_T, typename CGraph = CSRGraph, bool TEdges = false>
+    unsigned long long stealing(CGraph& g, const CLApp& cli, TaskStats* stats = nullptr)
+    {
+        const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(cli);
+        const int cliqueSize = dcli.clique_size();
+
+        if(cliqueSize == 1) return g.num_nodes();
+        if(cliqueSize == 2) return g.num_edges();
+
+        uint coreNumber = 0;
+        for(NodeId node = 0; node < g.num_nodes(); node++)
+        {
+            coreNumber = coreNumber > g.out_degree(node) ? coreNumber : g.out_degree(node);
+        }
+
+        int length = 1;
+        #ifdef _OPENMP
+        length = omp_get_max_threads();
+        #endif
+        std::vector<StealingWorker<Counter_T>> workers(length);
+        std::vector<std::unique_ptr<Builder_T>> builders(length);
+        const double start = omp_get_wtime();
+        StealingRunner<Counter_T> runner(workers, coreNumber, dcli.task_threshold(), start);
+        const int subgraphCliqueSize = TEdges ? cliqueSize - 2 : cliqueSize - 1;
+
+        #pragma omp parallel num_threads(length)
+        {
+            #ifdef _OPENMP
+            const int id = omp_get_thread_num();
+            #else
+            const int id = 0;
+            #endif
+            builders[id] = std::make_unique<Builder_T>(g, coreNumber);
+            #pragma omp barrier
+
+            #pragma omp single
+            {
+                #pragma omp task untied
+                for(NodeId node = 0; node < g.num_nodes(); node++)
+                {
+                    if constexpr (TEdges)
+                    {
+                        for(NodeId neigh : g.out_neigh(node))
+                        {
+                            #pragma omp task firstprivate(node, neigh)
+                            {
+                                CGraph graph = builders[omp_get_thread_num()]->buildSubGraph(node, neigh);
+                                runner.run(graph, subgraphCliqueSize);
+                            }
+                        }
+                    }
+                    else
+                    {
+                        #pragma omp task firstprivate(node)
+                        {
+                            CGraph graph = builders[omp_get_thread_num()]->buildSubGraph(node);
+                            runner.run(graph, subgraphCliqueSize);
+                        }
+                    }
+                }
+            }
+        }
+
+        unsigned long long count = 0;
+        if(stats != nullptr)
+        {
+            *stats = TaskStats();
+            stats->seconds = omp_get_wtime() - start;
+        }
+        for(const StealingWorker<Counter_T>& worker : workers)
+        {
+            count += worker.count;
+            if(stats == nullptr) continue;
+            stats->busy.push_back(worker.busy);
+            stats->finish.push_back(worker.finish);
+            stats->tasks += worker.tasks;
+            stats->spawned += worker.spawned;
+        }
+        return count;
+    }
 }
 
 namespace Serial
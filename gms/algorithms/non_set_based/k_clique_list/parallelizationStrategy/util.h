@@ -125,4 +125,47 @@ namespace GMS::KClique::Builders
         }
     };
 
+
+    /**
+     * @brief The subgraph of g with the edges u -> w for which keep(u, w) is true, with the same vertices. The order
+     * of the neighbourhoods is kept.
+     */
+    template<typename Keep_T>
+    CSRGraph filterEdges(const CSRGraph& g, Keep_T&& keep)
+    {
+        const NodeId n = g.num_nodes();
+        std::vector<int64_t> offsets(n + 1, 0);
+        #pragma omp parallel for schedule(dynamic, 256)
+        for(NodeId u = 0; u < n; u++)
+        {
+            int64_t degree = 0;
+            for(NodeId w : g.out_neigh(u))
+            {
+                degree += keep(u, w);
+            }
+            offsets[u + 1] = degree;
+        }
+        for(NodeId u = 0; u < n; u++)
+        {
+            offsets[u + 1] += offsets[u];
+        }
+
+        NodeId *out_neighs = new NodeId[offsets[n]];
+        NodeId **out_index = new NodeId*[n + 1];
+        #pragma omp parallel for schedule(dynamic, 256)
+        for(NodeId u = 0; u < n; u++)
+        {
+            NodeId *out = out_neighs + offsets[u];
+            for(NodeId w : g.out_neigh(u))
+            {
+                if(keep(u, w)) *(out++) = w;
+            }
+        }
+        for(NodeId u = 0; u <= n; u++)
+        {
+            out_index[u] = out_neighs + offsets[u];
+        }
+        return CSRGraph(n, out_index, out_neighs, nullptr, nullptr);
+    }
+
 }
\ No newline at end of file
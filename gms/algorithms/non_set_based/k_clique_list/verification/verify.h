@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cmath>
 #include <iostream>
 
 #include <gms/third_party/gapbs/benchmark.h>
+#include <gms/common/estimate.h>
 
 #include "kclisting_original.h"
 #include "kclisting_original_nodeParallel.h"
@@ -108,5 +110,26 @@ namespace GMS::KClique::Verifiers
     {
         NP::free_graph(g);
     }
+
+    /**
+     * Accepts an estimate of the approximate counters whose confidence interval contains the reference count, or
+     * whose relative error is within three times the error target.
+     */
+    inline bool Approx(unsigned long long referenceCount, const Estimation::Estimate& estimate, const CLApp& cli)
+    {
+        const CLCliqueApp& dcli = dynamic_cast<const CLCliqueApp&>(cli);
+        const double error = referenceCount > 0
+            ? std::abs(estimate.value - referenceCount) / referenceCount : estimate.value;
+        const bool pass = (estimate.lower <= referenceCount && referenceCount <= estimate.upper)
+            || error <= 3 * dcli.budget().relative_error;
+        if(!pass)
+        {
+            std::cout << "Nr of " << dcli.clique_size() << " cliques:" << std::endl;
+            std::cout << "Reference: " << referenceCount << std::endl;
+            std::cout << "Estimate:  " << estimate.value << " [" << estimate.lower << ", " << estimate.upper << "]"
+                << std::endl;
+        }
+        return pass;
+    }
 }
 
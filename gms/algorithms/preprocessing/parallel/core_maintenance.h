@@ -0,0 +1,539 @@
+#pragma once
+
+#include "../general.h"
+#include "degeneracy_bucketed.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace PpParallel
+{
+namespace CoreMaintenanceDetail
+{
+    constexpr NodeId kNone = -1;
+} // namespace CoreMaintenanceDetail
+
+/**
+ * Maintains the core numbers and a degeneracy ordering of a mutable, undirected SetGraph under batches of edge
+ * insertions and deletions.
+ *
+ * Core numbers are updated edge by edge with the traversal algorithm (Sariyüce et al., VLDB 2013): an insertion of
+ * {u, v} can only raise the core number of vertices with core number K = min(core[u], core[v]) which are connected
+ * to the endpoint(s) by vertices of core number K, and it raises them by at most one. Deletions are symmetric.
+ * Only this subcore is traversed, and the traversal is pruned at vertices with at most K neighbours of core number
+ * >= K, so the work is proportional to the affected region rather than to the graph.
+ *
+ * The ordering is kept as a k-order (Zhang et al., ICDE 2017): the vertices are ordered by core number (one list per
+ * shell) and every vertex has at most core[v] neighbours behind it, i.e. it is exactly the kind of ordering the
+ * peeling algorithms produce. Vertices whose core number drops are appended to the lower shell in the order they
+ * were dropped, vertices whose core number rises are peeled among themselves and appended to the higher shell, both
+ * keep the k-order property for the moved vertices. Neighbours which might get too many later neighbours by an
+ * update are checked at the end of the batch, and a violation is repaired locally by walking the k-order from the
+ * violating vertex until the vertices which have to move fit behind the walked part again.
+ */
+template <class SGraph>
+class CoreMaintenance
+{
+public:
+    using Edge = std::pair<NodeId, NodeId>;
+
+    struct BatchStatistics
+    {
+        int64_t insertedEdges = 0;
+        int64_t deletedEdges = 0;
+        int64_t changedCores = 0;     // number of core number changes
+        int64_t visitedVertices = 0;  // vertices traversed to update the core numbers
+        int64_t walkedVertices = 0;   // vertices walked to repair the ordering
+    };
+
+    /**
+     * Computes the initial core numbers and ordering with the bucketed k-core decomposition.
+     * The graph has to be undirected and must outlive this object, all updates have to go through applyBatch.
+     */
+    explicit CoreMaintenance(SGraph &graph) :
+        graph(graph), n(graph.num_nodes()), cores(n), next(n), prev(n), label(n), visited(n, 0), count(n)
+    {
+        std::vector<NodeId> order;
+        getKCoreDecomposition(graph, order, cores);
+        for (NodeId v : order)
+            append(v);
+    }
+
+    /**
+     * Applies the deletions and then the insertions. Self loops, insertions of existing edges and deletions of
+     * missing edges are ignored.
+     */
+    BatchStatistics applyBatch(const std::vector<Edge> &insertions, const std::vector<Edge> &deletions)
+    {
+        BatchStatistics stats;
+        for (auto [u, v] : deletions)
+        {
+            if (u == v || !graph.out_neigh(u).contains(v))
+                continue;
+            graph.out_neigh(u).remove(v);
+            graph.out_neigh(v).remove(u);
+            stats.deletedEdges++;
+            removeEdge(u, v, stats);
+        }
+        for (auto [u, v] : insertions)
+        {
+            if (u == v || graph.out_neigh(u).contains(v))
+                continue;
+            graph.out_neigh(u).add(v);
+            graph.out_neigh(v).add(u);
+            stats.insertedEdges++;
+            insertEdge(u, v, stats);
+        }
+        repairOrder(stats);
+        return stats;
+    }
+
+    NodeId coreNumber(NodeId v) const { return cores[v]; }
+
+    const std::vector<NodeId> &coreNumbers() const { return cores; }
+
+    NodeId degeneracy() const
+    {
+        for (NodeId k = head.size() - 1; k > 0; k--)
+        {
+            if (head[k] != CoreMaintenanceDetail::kNone)
+                return k;
+        }
+        return 0;
+    }
+
+    /**
+     * The current degeneracy ordering, in rank format (res[v] = position of v) if useRankFormat,
+     * otherwise in order format (res[i] = i-th vertex).
+     */
+    template <bool useRankFormat = false, class Output = std::vector<NodeId>>
+    void ordering(Output &res) const
+    {
+        res.resize(n);
+        NodeId position = 0;
+        for (NodeId v : head)
+        {
+            for (; v != CoreMaintenanceDetail::kNone; v = next[v], position++)
+            {
+                if constexpr (useRankFormat)
+                    res[v] = position;
+                else
+                    res[position] = v;
+            }
+        }
+    }
+
+private:
+    // Shell lists
+
+    void ensureShell(NodeId k)
+    {
+        if (k >= (NodeId)head.size())
+        {
+            head.resize(k + 1, CoreMaintenanceDetail::kNone);
+            tail.resize(k + 1, CoreMaintenanceDetail::kNone);
+        }
+    }
+
+    // Appends v to the list of the shell cores[v].
+    void append(NodeId v)
+    {
+        const NodeId k = cores[v];
+        ensureShell(k);
+        prev[v] = tail[k];
+        next[v] = CoreMaintenanceDetail::kNone;
+        if (tail[k] == CoreMaintenanceDetail::kNone)
+        {
+            head[k] = v;
+            label[v] = 0;
+        }
+        else
+        {
+            next[tail[k]] = v;
+            label[v] = label[tail[k]] + 1;
+        }
+        tail[k] = v;
+    }
+
+    // Unlinks v from the list of the shell k.
+    void unlink(NodeId v, NodeId k)
+    {
+        if (prev[v] != CoreMaintenanceDetail::kNone)
+            next[prev[v]] = next[v];
+        else
+            head[k] = next[v];
+        if (next[v] != CoreMaintenanceDetail::kNone)
+            prev[next[v]] = prev[v];
+        else
+            tail[k] = prev[v];
+    }
+
+    // Whether u comes before v in the ordering.
+    bool before(NodeId u, NodeId v) const
+    {
+        return cores[u] < cores[v] || (cores[u] == cores[v] && label[u] < label[v]);
+    }
+
+    void suspect(NodeId v) { suspects.push_back(v); }
+
+    // Marks all neighbours of v in the shells k and k + 1 as suspects (their number of later neighbours can grow).
+    void suspectNeighbors(NodeId v, NodeId k)
+    {
+        for (NodeId w : graph.out_neigh(v))
+        {
+            if (cores[w] == k || cores[w] == k + 1)
+                suspect(w);
+        }
+    }
+
+    // Number of neighbours of v with core number >= k.
+    NodeId coreDegree(NodeId v, NodeId k) const
+    {
+        NodeId degree = 0;
+        for (NodeId w : graph.out_neigh(v))
+            degree += cores[w] >= k;
+        return degree;
+    }
+
+    void visit(NodeId v)
+    {
+        visited[v] = 1;
+        touched.push_back(v);
+    }
+
+    void resetVisited(BatchStatistics &stats)
+    {
+        stats.visitedVertices += touched.size();
+        for (NodeId v : touched)
+            visited[v] = 0;
+        touched.clear();
+    }
+
+    // Core numbers
+
+    void insertEdge(NodeId u, NodeId v, BatchStatistics &stats)
+    {
+        suspect(u);
+        suspect(v);
+        const NodeId k = std::min(cores[u], cores[v]);
+
+        // Traverse the subcore of the endpoints, count[w] = number of neighbours which can be in the (k+1)-core.
+        std::vector<NodeId> &stack = work;
+        stack.clear();
+        for (NodeId r : {u, v})
+        {
+            if (cores[r] == k && !visited[r])
+            {
+                visit(r);
+                stack.push_back(r);
+            }
+        }
+        while (!stack.empty())
+        {
+            NodeId w = stack.back();
+            stack.pop_back();
+            count[w] = coreDegree(w, k);
+            if (count[w] <= k)
+                continue;
+            for (NodeId x : graph.out_neigh(w))
+            {
+                if (cores[x] == k && !visited[x])
+                {
+                    visit(x);
+                    stack.push_back(x);
+                }
+            }
+        }
+
+        // Evict the candidates which can't be in the (k+1)-core (visited[w] = 2), the others rise to k + 1.
+        for (NodeId w : touched)
+        {
+            if (count[w] <= k && visited[w] == 1)
+                evict(w, k);
+        }
+
+        std::vector<NodeId> &raised = moved;
+        raised.clear();
+        for (NodeId w : touched)
+        {
+            if (visited[w] == 1)
+                raised.push_back(w);
+        }
+        resetVisited(stats);
+        if (raised.empty())
+            return;
+
+        stats.changedCores += raised.size();
+        for (NodeId w : raised)
+        {
+            unlink(w, k);
+            cores[w] = k + 1;
+        }
+        appendPeeled(raised, k + 1);
+        for (NodeId w : raised)
+            suspectNeighbors(w, k);
+    }
+
+    void evict(NodeId w, NodeId k)
+    {
+        std::vector<NodeId> &stack = evicted;
+        stack.clear();
+        visited[w] = 2;
+        stack.push_back(w);
+        while (!stack.empty())
+        {
+            NodeId x = stack.back();
+            stack.pop_back();
+            for (NodeId y : graph.out_neigh(x))
+            {
+                if (cores[y] == k && visited[y] == 1 && --count[y] <= k)
+                {
+                    visited[y] = 2;
+                    stack.push_back(y);
+                }
+            }
+        }
+    }
+
+    /**
+     * Appends the vertices to the end of the shell k, in the order in which they are peeled when only their
+     * neighbours among them and in higher shells are counted. Since the core numbers are exact, there is always a
+     * vertex with at most k such neighbours.
+     */
+    void appendPeeled(const std::vector<NodeId> &vertices, NodeId k)
+    {
+        std::vector<NodeId> &queue = work;
+        queue.clear();
+        for (NodeId w : vertices)
+            visit(w);
+        for (NodeId w : vertices)
+        {
+            NodeId degree = 0;
+            for (NodeId x : graph.out_neigh(w))
+                degree += cores[x] > k || visited[x];
+            count[w] = degree;
+            if (degree <= k)
+                queue.push_back(w);
+        }
+        for (size_t i = 0; i < queue.size(); i++)
+        {
+            NodeId w = queue[i];
+            visited[w] = 0;
+            append(w);
+            for (NodeId x : graph.out_neigh(w))
+            {
+                if (visited[x] && count[x]-- == k + 1)
+                    queue.push_back(x);
+            }
+        }
+        if (queue.size() != vertices.size())
+            throw std::logic_error("core maintenance: inconsistent core numbers");
+        touched.clear();
+    }
+
+    void removeEdge(NodeId u, NodeId v, BatchStatistics &stats)
+    {
+        const NodeId k = std::min(cores[u], cores[v]);
+        if (k == 0)
+            return;
+
+        // count[w] = number of neighbours with core number >= k, computed when w is reached first. Vertices with
+        // count[w] < k are dropped (visited[w] = 2) and processed in this order, which is also the order in which they
+        // are appended to the shell k - 1. Their core number is lowered when they are processed, so every dropped
+        // vertex is subtracted exactly once from the counts of its neighbours.
+        std::vector<NodeId> &dropped = moved;
+        dropped.clear();
+        auto check = [&](NodeId w) {
+            if (count[w] < k)
+            {
+                visited[w] = 2;
+                dropped.push_back(w);
+            }
+        };
+
+        for (NodeId r : {u, v})
+        {
+            if (cores[r] == k && !visited[r])
+            {
+                visit(r);
+                count[r] = coreDegree(r, k);
+                check(r);
+            }
+        }
+        for (size_t i = 0; i < dropped.size(); i++)
+        {
+            const NodeId w = dropped[i];
+            cores[w] = k - 1;
+            for (NodeId x : graph.out_neigh(w))
+            {
+                if (cores[x] != k || visited[x] == 2)
+                    continue;
+                if (!visited[x])
+                {
+                    visit(x);
+                    count[x] = coreDegree(x, k);
+                }
+                else
+                {
+                    count[x]--;
+                }
+                check(x);
+            }
+        }
+        resetVisited(stats);
+
+        stats.changedCores += dropped.size();
+        for (NodeId w : dropped)
+        {
+            unlink(w, k);
+            append(w);
+        }
+    }
+
+    // Ordering repair
+
+    // Number of neighbours of v behind it in the ordering.
+    NodeId laterNeighbors(NodeId v) const
+    {
+        NodeId later = 0;
+        for (NodeId w : graph.out_neigh(v))
+            later += before(v, w);
+        return later;
+    }
+
+    void repairOrder(BatchStatistics &stats)
+    {
+        // A repair never gives a vertex outside of the walked segment more later neighbours, so every suspect is
+        // checked once, when it is reached.
+        for (NodeId v : suspects)
+        {
+            if (laterNeighbors(v) > cores[v])
+                stats.walkedVertices += repairFrom(v);
+        }
+        suspects.clear();
+    }
+
+    /**
+     * Order based repair of the shell k = core[v] from v, which has more than k later neighbours (Zhang et al.,
+     * ICDE 2017). The shell is walked from v on, the candidates are the walked vertices which have to move behind the
+     * current position: a walked vertex w becomes a candidate if it has more than k later neighbours once the
+     * candidates before it are moved behind it, otherwise it stays. count[c] of a candidate c is the number of its
+     * neighbours which are candidates, not walked yet or in higher shells. The walk stops as soon as all candidates
+     * have count[c] <= k, then they are moved right behind the last walked vertex, in any order. If the end of the
+     * shell is reached first, the candidates are appended in peeling order, which always succeeds since the core
+     * numbers are exact. Only the walked segment is relinked and relabeled, with its own labels.
+     * Returns the number of walked vertices.
+     */
+    int64_t repairFrom(NodeId v)
+    {
+        const NodeId k = cores[v];
+        std::vector<NodeId> &segment = work;
+        std::vector<NodeId> &candidates = moved;
+        std::vector<NodeId> &stay = evicted;
+        segment.clear();
+        candidates.clear();
+        stay.clear();
+
+        NodeId over = 0; // candidates with count[c] > k
+        auto candidate = [&](NodeId w, NodeId degree) {
+            visit(w);
+            candidates.push_back(w);
+            count[w] = degree;
+            over += degree > k;
+        };
+        segment.push_back(v);
+        candidate(v, laterNeighbors(v));
+        for (NodeId w = next[v]; w != CoreMaintenanceDetail::kNone && over > 0; w = next[w])
+        {
+            segment.push_back(w);
+            NodeId degree = 0;
+            for (NodeId x : graph.out_neigh(w))
+                degree += visited[x] || before(w, x);
+            if (degree > k)
+            {
+                candidate(w, degree);
+                continue;
+            }
+            stay.push_back(w);
+            for (NodeId x : graph.out_neigh(w))
+            {
+                if (visited[x] && count[x]-- == k + 1)
+                    over--;
+            }
+        }
+
+        // The new order of the segment: the vertices which stay, then the candidates.
+        const NodeId front = prev[segment.front()];
+        const NodeId back = next[segment.back()];
+        std::vector<int64_t> labels;
+        labels.reserve(segment.size());
+        for (NodeId w : segment)
+            labels.push_back(label[w]);
+        if (over > 0)
+        {
+            // The end of the shell was reached, count[c] only counts candidates and higher shells: peel them.
+            const size_t first = stay.size();
+            for (NodeId c : candidates)
+            {
+                if (count[c] <= k)
+                    stay.push_back(c);
+            }
+            for (size_t i = first; i < stay.size(); i++)
+            {
+                visited[stay[i]] = 0;
+                for (NodeId x : graph.out_neigh(stay[i]))
+                {
+                    if (visited[x] && count[x]-- == k + 1)
+                        stay.push_back(x);
+                }
+            }
+            if (stay.size() != segment.size())
+                throw std::logic_error("core maintenance: inconsistent core numbers");
+        }
+        else
+        {
+            stay.insert(stay.end(), candidates.begin(), candidates.end());
+        }
+        for (NodeId w : candidates)
+            visited[w] = 0;
+        touched.clear();
+
+        NodeId last = front;
+        for (size_t i = 0; i < stay.size(); i++)
+        {
+            const NodeId w = stay[i];
+            label[w] = labels[i];
+            prev[w] = last;
+            if (last == CoreMaintenanceDetail::kNone)
+                head[k] = w;
+            else
+                next[last] = w;
+            last = w;
+        }
+        next[last] = back;
+        if (back == CoreMaintenanceDetail::kNone)
+            tail[k] = last;
+        else
+            prev[back] = last;
+        return segment.size();
+    }
+
+    SGraph &graph;
+    const NodeId n;
+    std::vector<NodeId> cores;
+
+    // Doubly linked list per shell, label[v] increases along the list.
+    std::vector<NodeId> head, tail;
+    std::vector<NodeId> next, prev;
+    std::vector<int64_t> label;
+
+    // Workspace, all of it is reset after every update so the cost doesn't depend on n.
+    std::vector<uint8_t> visited;
+    std::vector<NodeId> count;
+    std::vector<NodeId> touched;
+    std::vector<NodeId> work;
+    std::vector<NodeId> moved;
+    std::vector<NodeId> evicted;
+    std::vector<NodeId> suspects;
+};
+} // namespace PpParallel
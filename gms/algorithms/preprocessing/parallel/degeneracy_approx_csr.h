@@ -6,75 +6,72 @@
 #include <gms/third_party/fast_statistics.h>
 #include <gms/third_party/fast_range.h>
 #include "boundary_function.h"
+#include "degeneracy_approx_histogram.h"
 
 namespace PpParallel
 {
+/**
+ * Approximate (2+epsilon) degeneracy ordering. In every round, all vertices with a remaining degree of at most
+ * boundary(...) are peeled at once. The peeled vertices are placed by a counting sort over a degree histogram and
+ * their neighbours' degrees are decremented through thread local aggregation buffers.
+ */
 template <BoundaryFunction boundary, bool useRankFormat = false, class CGraph = CSRGraph, class Output = std::vector<NodeId>, class Set = RoaringSet>
 void getDegeneracyOrderingApproxCGraph(const CGraph &graph, Output &res, double epsilon)
 {
+    using namespace ApproxDegeneracy;
+
     auto vSize = graph.num_nodes();
     NodeId counter = 0;
     res.resize(vSize); //Prepare Result
     
     //Prepare Counter and Working Set
     std::vector<int> degreeCounter(vSize);
-    NodeId *vArray = new NodeId[vSize];
+    std::vector<uint8_t> removed(vSize);
+    std::vector<NodeId> vArray(vSize);
+    std::vector<NodeId> buffer(vSize);
 #pragma omp parallel for schedule(static, 16)
     for (int i = 0; i < vSize; i++) {
         degreeCounter[i] = graph.out_degree(i);
+        removed[i] = 0;
         vArray[i] = i;
     }
 
-    NodeId *start_index = vArray;
-    NodeId *end_index = vArray + vSize;
-
+    std::vector<int64_t> histogram;
     while (counter < vSize) {
-        auto remaining = end_index - start_index;
-
-        unsigned int border = boundary(start_index, remaining, degreeCounter, epsilon);
+        auto remaining = vSize - counter;
 
-        #ifdef _OPENMP
-        auto middle_index = __gnu_parallel::partition(start_index, end_index,
-                                                      [border, &degreeCounter](const NodeId v) {
-                                                          return degreeCounter[v] <= border;
-                                                      });
-        #else
-        auto middle_index = std::partition(start_index, end_index,
-                                                      [border, &degreeCounter](const NodeId v) {
-                                                          return degreeCounter[v] <= border;
-                                                      });
-        #endif
-        
-        auto mid = middle_index - start_index;
-
-        #ifdef _OPENMP
-        __gnu_parallel::sort(start_index, middle_index,
-                             [&degreeCounter](const NodeId v, const NodeId w) { return degreeCounter[v] < degreeCounter[w]; });
-        #else
-        std::sort(start_index, middle_index,
-                             [&degreeCounter](const NodeId v, const NodeId w) { return degreeCounter[v] < degreeCounter[w]; });
-        #endif
+        int64_t border = boundary(vArray.data() + counter, remaining, degreeCounter, epsilon);
+        auto mid = histogramPartition(vArray.data() + counter, remaining, buffer.data() + counter, degreeCounter, border, histogram);
+        vArray.swap(buffer);
+        const NodeId *peeled = vArray.data() + counter;
 
         //Add to Result Set
-        //And reflect removing the vertices from the graph (PUSH style)
 #pragma omp parallel for schedule(static, 16)
         for (int i = 0; i < mid; i++) {
             if constexpr (useRankFormat) 
-                res[start_index[i]] = counter + i; //Result in Rank-Format
+                res[peeled[i]] = counter + i; //Result in Rank-Format
             else
-                res[counter + i] = start_index[i]; //Result in Order-Format
-            auto v = start_index[i];
-            for (auto u : graph.out_neigh(v))
-            {
-                #pragma omp atomic
-                    degreeCounter[u]--;
+                res[counter + i] = peeled[i]; //Result in Order-Format
+            removed[peeled[i]] = 1;
+        }
+
+        //Reflect removing the vertices from the graph (PUSH style)
+#pragma omp parallel
+        {
+            DecrementBuffer decrements;
+#pragma omp for schedule(dynamic, 16) nowait
+            for (int i = 0; i < mid; i++) {
+                for (auto u : graph.out_neigh(peeled[i]))
+                {
+                    if (!removed[u])
+                        decrements.decrement(u, degreeCounter);
+                }
             }
+            decrements.flush(degreeCounter);
         }
 
-        start_index = middle_index;
         counter += mid;
     }
-    delete[] vArray;
 }
 
 } // namespace PpParallel
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "../general.h"
+#include "gms/third_party/gapbs/platform_atomics.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace PpParallel::ApproxDegeneracy
+{
+    // Upper bound for the number of histogram buckets per thread. Larger degree ranges are bucketed coarser, and the
+    // buckets are sorted by degree afterwards.
+    constexpr int64_t kMaxHistogramBuckets = 4096;
+
+    /**
+     * Moves the vertices v of in[0, size) with degree[v] <= border to the front of out, sorted by their degree with a
+     * parallel counting sort over a degree histogram, and the other vertices behind them in their previous order.
+     * This replaces a parallel partition followed by a parallel sort of the peeled vertices. If the degrees up to border
+     * don't fit into kMaxHistogramBuckets, a bucket holds a range of degrees and is stable sorted by degree afterwards,
+     * so the peeled vertices are sorted by degree in either case.
+     *
+     * @param counts Workspace for the per-thread histograms.
+     * @return the number of vertices with degree[v] <= border.
+     */
+    template <class Degrees>
+    int64_t histogramPartition(const NodeId *in, int64_t size, NodeId *out, const Degrees &degree, int64_t border,
+                               std::vector<int64_t> &counts)
+    {
+        if (border < 0)
+            border = -1;
+        const int64_t range = border + 1;
+        const int64_t width = std::min(range, kMaxHistogramBuckets);
+        const int64_t slots = width + 1; // the last slot holds the vertices which aren't peeled
+        auto slot = [&](int64_t d) -> int64_t {
+            if (d > border)
+                return width;
+            if (d < 0)
+                return 0;
+            return width == range ? d : d * width / range;
+        };
+
+        const int max_threads = omp_get_max_threads();
+        counts.assign(max_threads * slots, 0);
+        const bool coarse = width != range;
+        std::vector<int64_t> bucketBegin(coarse ? slots : 0);
+        int64_t peeled = 0;
+#pragma omp parallel num_threads(max_threads)
+        {
+            const int t = omp_get_thread_num();
+            const int num_threads = omp_get_num_threads();
+            const int64_t begin = size * t / num_threads;
+            const int64_t end = size * (t + 1) / num_threads;
+            int64_t *count = counts.data() + t * slots;
+            for (int64_t i = begin; i < end; i++)
+                count[slot(degree[in[i]])]++;
+#pragma omp barrier
+#pragma omp single
+            {
+                // bucket major, thread minor, so the placement is stable within every bucket
+                int64_t offset = 0;
+                for (int64_t s = 0; s < slots; s++)
+                {
+                    if (s == width)
+                        peeled = offset;
+                    if (coarse)
+                        bucketBegin[s] = offset;
+                    for (int u = 0; u < num_threads; u++)
+                    {
+                        int64_t c = counts[u * slots + s];
+                        counts[u * slots + s] = offset;
+                        offset += c;
+                    }
+                }
+            }
+            for (int64_t i = begin; i < end; i++)
+                out[count[slot(degree[in[i]])]++] = in[i];
+            if (coarse)
+            {
+#pragma omp barrier
+#pragma omp for schedule(dynamic, 16)
+                for (int64_t s = 0; s < width; s++)
+                {
+                    const int64_t last = s + 1 < width ? bucketBegin[s + 1] : peeled;
+                    std::stable_sort(out + bucketBegin[s], out + last,
+                                     [&](NodeId a, NodeId b) { return degree[a] < degree[b]; });
+                }
+            }
+        }
+        return peeled;
+    }
+
+    /**
+     * Thread local aggregation of degree decrements. Decrements of the same vertex are combined in a small
+     * direct-mapped cache and applied with one atomic operation when the entry is evicted or flushed, which mostly
+     * helps for high degree vertices, i.e. the most contended counters.
+     */
+    class DecrementBuffer
+    {
+    public:
+        static constexpr int kSlotBits = 10;
+        static constexpr NodeId kEmpty = -1;
+
+        DecrementBuffer() { keys.fill(kEmpty); }
+
+        template <class Degrees>
+        void decrement(NodeId v, Degrees &degree)
+        {
+            const size_t s = (static_cast<uint32_t>(v) * 2654435761u) >> (32 - kSlotBits);
+            if (keys[s] == v)
+            {
+                amounts[s]++;
+                return;
+            }
+            if (keys[s] != kEmpty)
+                fetch_and_add(degree[keys[s]], -amounts[s]);
+            keys[s] = v;
+            amounts[s] = 1;
+        }
+
+        template <class Degrees>
+        void flush(Degrees &degree)
+        {
+            for (size_t s = 0; s < keys.size(); s++)
+            {
+                if (keys[s] != kEmpty)
+                {
+                    fetch_and_add(degree[keys[s]], -amounts[s]);
+                    keys[s] = kEmpty;
+                }
+            }
+        }
+
+    private:
+        std::array<NodeId, 1 << kSlotBits> keys;
+        std::array<int, 1 << kSlotBits> amounts;
+    };
+} // namespace PpParallel::ApproxDegeneracy
@@ -6,6 +6,7 @@
 #include <gms/third_party/fast_statistics.h>
 #include <gms/third_party/fast_range.h>
 #include "boundary_function.h"
+#include "degeneracy_approx_histogram.h"
 
 namespace PpParallel
 {
@@ -20,42 +21,23 @@ void getDegeneracyOrderingApproxSGraph(const SGraph &graph, Output &res, const d
     
     //Prepare Counter and Working Set
     std::vector<int> degreeCounter(vSize);
-    NodeId *vArray = new NodeId[vSize];
+    std::vector<NodeId> vArray(vSize);
+    std::vector<NodeId> buffer(vSize);
 #pragma omp parallel for schedule(static, 16)
     for (int i = 0; i < vSize; i++) {
         degreeCounter[i] = graph.out_neigh(i).cardinality();
         vArray[i] = i;
     }
 
-    NodeId *start_index = vArray;
-    NodeId *end_index = vArray + vSize;
-
+    std::vector<int64_t> histogram;
     while (counter < vSize) {
-        auto remaining = end_index - start_index;
-
-        unsigned int border = boundary(start_index, remaining, degreeCounter, epsilon);
-
-        #ifdef _OPENMP
-        auto middle_index = __gnu_parallel::partition(start_index, end_index,
-                                                      [border, &degreeCounter](const NodeId v) {
-                                                          return degreeCounter[v] <= border;
-                                                      });
-        #else
-        auto middle_index = std::partition(start_index, end_index,
-                                                      [border, &degreeCounter](const NodeId v) {
-                                                          return degreeCounter[v] <= border;
-                                                      });
-        #endif
-        
-        auto mid = middle_index - start_index;
+        auto remaining = vSize - counter;
 
-        #ifdef _OPENMP
-        __gnu_parallel::sort(start_index, middle_index,
-                             [&degreeCounter](const NodeId v, const NodeId w) { return degreeCounter[v] < degreeCounter[w]; });
-        #else
-        std::sort(start_index, middle_index,
-                             [&degreeCounter](const NodeId v, const NodeId w) { return degreeCounter[v] < degreeCounter[w]; });
-        #endif
+        int64_t border = boundary(vArray.data() + counter, remaining, degreeCounter, epsilon);
+        auto mid = ApproxDegeneracy::histogramPartition(vArray.data() + counter, remaining, buffer.data() + counter,
+                                                        degreeCounter, border, histogram);
+        vArray.swap(buffer);
+        NodeId *start_index = vArray.data() + counter;
 
         Set X(start_index, mid);
 
@@ -78,10 +60,8 @@ void getDegeneracyOrderingApproxSGraph(const SGraph &graph, Output &res, const d
             }
         }
 
-        start_index = middle_index;
         counter += mid;
     }
-    delete[] vArray;
 }
 
 } // namespace PpParallel
\ No newline at end of file
@@ -0,0 +1,245 @@
+#pragma once
+
+#include "../general.h"
+#include "gms/third_party/gapbs/platform_atomics.h"
+
+#include <limits>
+
+namespace PpParallel
+{
+namespace BucketPeeling
+{
+    // Number of buckets which are materialized at a time, vertices with a larger degree wait in an overflow bucket.
+    constexpr NodeId kOpenBuckets = 128;
+    constexpr NodeId kUnassigned = -1;
+
+    // Concatenates the thread local buffers into out (and clears them).
+    inline void concatenate(std::vector<std::vector<NodeId>> &parts, std::vector<NodeId> &out)
+    {
+        std::vector<size_t> offsets(parts.size() + 1, 0);
+        for (size_t t = 0; t < parts.size(); t++)
+            offsets[t + 1] = offsets[t] + parts[t].size();
+        out.resize(offsets.back());
+#pragma omp parallel for schedule(static, 1)
+        for (size_t t = 0; t < parts.size(); t++)
+        {
+            std::copy(parts[t].begin(), parts[t].end(), out.begin() + offsets[t]);
+            parts[t].clear();
+        }
+    }
+
+    /**
+     * Bucket structure of Julienne (Dhulipala et al., SPAA 2017): only the buckets of the window
+     * [base, base + kOpenBuckets) are materialized, all vertices with a larger degree are kept in one overflow bucket.
+     * Entries aren't removed when the degree of a vertex changes, stale entries are skipped when a bucket is extracted.
+     */
+    class Buckets
+    {
+    public:
+        Buckets() :
+            buckets(kOpenBuckets + 1),
+            local(omp_get_max_threads(), std::vector<std::vector<NodeId>>(kOpenBuckets + 1)),
+            filtered(omp_get_max_threads())
+        {}
+
+        NodeId base() const { return base_; }
+
+        // Inserts every vertex v of vertices with keep(v) into the bucket of key[v].
+        template <class Keep>
+        void insert(const std::vector<NodeId> &vertices, const std::vector<NodeId> &key, Keep &&keep)
+        {
+            const int64_t size = vertices.size();
+#pragma omp parallel
+            {
+                auto &mine = local[omp_get_thread_num()];
+#pragma omp for schedule(static) nowait
+                for (int64_t i = 0; i < size; i++)
+                {
+                    NodeId v = vertices[i];
+                    if (keep(v))
+                        mine[slot(key[v])].push_back(v);
+                }
+#pragma omp barrier
+#pragma omp for schedule(dynamic, 1)
+                for (NodeId s = 0; s <= kOpenBuckets; s++)
+                {
+                    for (auto &l : local)
+                    {
+                        buckets[s].insert(buckets[s].end(), l[s].begin(), l[s].end());
+                        l[s].clear();
+                    }
+                }
+            }
+        }
+
+        // Moves the valid entries of the bucket k to out, where valid(v) checks whether v is still in bucket k.
+        template <class Valid>
+        void extract(NodeId k, std::vector<NodeId> &out, Valid &&valid)
+        {
+            auto &bucket = buckets[k - base_];
+            const int64_t size = bucket.size();
+#pragma omp parallel
+            {
+                auto &mine = filtered[omp_get_thread_num()];
+#pragma omp for schedule(static)
+                for (int64_t i = 0; i < size; i++)
+                {
+                    if (valid(bucket[i]))
+                        mine.push_back(bucket[i]);
+                }
+            }
+            concatenate(filtered, out);
+            bucket.clear();
+        }
+
+        // Opens the next window, which starts at the smallest key in the overflow bucket that is still alive.
+        // Returns false if the overflow bucket is empty.
+        template <class Alive>
+        bool next_window(const std::vector<NodeId> &key, Alive &&alive)
+        {
+            std::vector<NodeId> overflow;
+            overflow.swap(buckets[kOpenBuckets]);
+            NodeId min_key = std::numeric_limits<NodeId>::max();
+#pragma omp parallel for reduction(min : min_key)
+            for (size_t i = 0; i < overflow.size(); i++)
+            {
+                if (alive(overflow[i]))
+                    min_key = std::min(min_key, key[overflow[i]]);
+            }
+            if (min_key == std::numeric_limits<NodeId>::max())
+                return false;
+            base_ = min_key;
+            insert(overflow, key, alive);
+            return true;
+        }
+
+    private:
+        NodeId slot(NodeId key) const { return std::min(key - base_, kOpenBuckets); }
+
+        NodeId base_ = 0;
+        std::vector<std::vector<NodeId>> buckets;
+        std::vector<std::vector<std::vector<NodeId>>> local;
+        std::vector<std::vector<NodeId>> filtered;
+    };
+} // namespace BucketPeeling
+
+/**
+ * Exact k-core decomposition by parallel bucketed peeling (Julienne, Dhulipala et al., SPAA 2017).
+ *
+ * The vertices are peeled level by level. On level k, all vertices with remaining degree k are removed at once,
+ * their neighbours' degrees are decremented atomically and neighbours which drop to k form the next frontier of
+ * the same level. Neighbours whose degree changed are moved to their new bucket once per frontier.
+ *
+ * This code is generic over both CGraph and SGraph, the graph has to be undirected.
+ *
+ * @param res    Degeneracy ordering (the peeling order), in rank format (res[v] = position of v) if useRankFormat,
+ *               otherwise in order format (res[i] = i-th vertex).
+ * @param cores  Output, cores[v] = core number of v.
+ * @return the degeneracy of the graph (the largest core number).
+ */
+template <class AnyGraph, bool useRankFormat = false, class Output = std::vector<NodeId>, class Cores = std::vector<NodeId>>
+NodeId getKCoreDecomposition(const AnyGraph &graph, Output &res, Cores &cores)
+{
+    using namespace BucketPeeling;
+
+    const NodeId n = graph.num_nodes();
+    res.resize(n);
+    cores.resize(n);
+    std::vector<NodeId> d(n);       // d[v] = number of neighbours of v which aren't peeled yet
+    std::vector<uint8_t> updated(n); // updated[v] = 1 if d[v] changed in the current frontier
+    std::vector<NodeId> frontier(n);
+#pragma omp parallel for schedule(static, 64)
+    for (NodeId v = 0; v < n; v++)
+    {
+        d[v] = graph.out_degree(v);
+        cores[v] = kUnassigned;
+        updated[v] = 0;
+        frontier[v] = v;
+    }
+    auto alive = [&cores](NodeId v) { return cores[v] == kUnassigned; };
+
+    Buckets buckets;
+    buckets.insert(frontier, d, [](NodeId) { return true; });
+
+    const int num_threads = omp_get_max_threads();
+    std::vector<std::vector<NodeId>> next_local(num_threads);
+    std::vector<std::vector<NodeId>> updated_local(num_threads);
+    std::vector<NodeId> changed;
+
+    NodeId peeled = 0;
+    NodeId degeneracy = 0;
+    NodeId k = 0;
+    while (peeled < n)
+    {
+        if (k == buckets.base() + kOpenBuckets)
+        {
+            if (!buckets.next_window(d, alive))
+                break;
+            k = buckets.base();
+        }
+        buckets.extract(k, frontier, [&](NodeId v) { return alive(v) && d[v] == k; });
+
+        while (!frontier.empty())
+        {
+            const int64_t size = frontier.size();
+            degeneracy = k;
+#pragma omp parallel for schedule(static, 64)
+            for (int64_t i = 0; i < size; i++)
+            {
+                NodeId v = frontier[i];
+                cores[v] = k;
+                if constexpr (useRankFormat)
+                    res[v] = peeled + i; //Result in Rank-Format
+                else
+                    res[peeled + i] = v; //Result in Order-Format
+            }
+            peeled += size;
+
+#pragma omp parallel for schedule(dynamic, 16)
+            for (int64_t i = 0; i < size; i++)
+            {
+                const int t = omp_get_thread_num();
+                for (NodeId w : graph.out_neigh(frontier[i]))
+                {
+                    if (!alive(w))
+                        continue;
+                    NodeId old = fetch_and_add(d[w], -1);
+                    if (old == k + 1)
+                        next_local[t].push_back(w);
+                    else if (old > k + 1 && !updated[w] && compare_and_swap(updated[w], (uint8_t)0, (uint8_t)1))
+                        updated_local[t].push_back(w);
+                }
+            }
+
+            concatenate(updated_local, changed);
+            buckets.insert(changed, d, [&](NodeId w) {
+                updated[w] = 0;
+                return d[w] > k && d[w] < buckets.base() + kOpenBuckets;
+            });
+            concatenate(next_local, frontier);
+        }
+        k++;
+    }
+    return degeneracy;
+}
+
+/**
+ * Core numbers of all vertices, see getKCoreDecomposition.
+ */
+template <class AnyGraph, class Cores = std::vector<NodeId>>
+NodeId getCoreNumbers(const AnyGraph &graph, Cores &cores)
+{
+    std::vector<NodeId> order;
+    return getKCoreDecomposition(graph, order, cores);
+}
+
+/**
+ * Exact degeneracy ordering, see getKCoreDecomposition.
+ */
+template <class AnyGraph, bool useRankFormat = false, class Output = std::vector<NodeId>>
+void getDegeneracyOrderingBucketed(const AnyGraph &graph, Output &res)
+{
+    std::vector<NodeId> cores;
+    getKCoreDecomposition<AnyGraph, useRankFormat>(graph, res, cores);
+}
+} // namespace PpParallel
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../general.h"
+
+#include <stdexcept>
+#include <type_traits>
+
+namespace PpParallel
+{
+namespace Orientation
+{
+    template <class Graph, class = void>
+    struct is_set_graph : std::false_type {};
+
+    template <class Graph>
+    struct is_set_graph<Graph, std::void_t<typename Graph::Set>> : std::true_type {};
+
+    // Strict order of the vertices by (rank, id), so rankings with ties are oriented consistently.
+    template <class Ranking>
+    inline bool precedes(const Ranking &ranking, NodeId u, NodeId v)
+    {
+        return ranking[u] < ranking[v] || (ranking[u] == ranking[v] && u < v);
+    }
+
+    /**
+     * Builds the CSR arrays which contain, for every vertex v, the neighbours w with precedes(v, w) if later is true
+     * and those with precedes(w, v) otherwise. The neighbourhoods are sorted.
+     * If relabel is true, the vertex v and its neighbours w are stored as ranking[v] and ranking[w].
+     */
+    template <class CGraph, class Ranking>
+    void filterCSR(const CGraph &g, const Ranking &ranking, bool relabel, bool later, NodeId ***index, NodeId **neighs)
+    {
+        const int64_t n = g.num_nodes();
+        auto id = [&](NodeId v) -> NodeId { return relabel ? ranking[v] : v; };
+        auto keep = [&](NodeId v, NodeId w) { return later ? precedes(ranking, v, w) : precedes(ranking, w, v); };
+
+        pvector<NodeId> degrees(n);
+#pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeId v = 0; v < n; v++)
+        {
+            NodeId degree = 0;
+            for (NodeId w : g.out_neigh(v))
+                degree += keep(v, w);
+            degrees[id(v)] = degree;
+        }
+
+        pvector<SGOffset> offsets = BuilderBase<NodeId, NodeId, NodeId>::ParallelPrefixSum(degrees);
+        *neighs = new NodeId[offsets[n]];
+        *index = CSRGraph::GenIndex(offsets, *neighs);
+
+        NodeId **idx = *index;
+#pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeId v = 0; v < n; v++)
+        {
+            NodeId *out = idx[id(v)];
+            for (NodeId w : g.out_neigh(v))
+            {
+                if (keep(v, w))
+                    *(out++) = id(w);
+            }
+            if (relabel)
+                std::sort(idx[id(v)], out);
+        }
+    }
+} // namespace Orientation
+
+/**
+ * Orients the undirected graph g along the ranking: the edge {u, v} becomes u -> v if u precedes v, i.e. if
+ * ranking[u] < ranking[v] (ties are broken by the vertex ids). Every neighbourhood is filtered in parallel, the
+ * offsets of the CSR output are computed with a parallel prefix sum.
+ *
+ * With relabel, the oriented graph is in rank space: vertex v becomes ranking[v], which requires the ranking to be a
+ * permutation and places the vertices in the order of the ranking, which usually improves the locality of the
+ * kernels traversing the oriented graph. Otherwise the vertex ids are kept.
+ *
+ * CSRGraph outputs are directed graphs with the in-neighbourhoods (the preceding neighbours), SetGraph outputs only
+ * store the out-neighbourhoods.
+ *
+ * @param ranking Rank format, ranking[v] = rank of v.
+ */
+template <class Graph = CSRGraph, class Ranking = std::vector<NodeId>>
+Graph OrientByRank(const Graph &g, const Ranking &ranking, bool relabel = true)
+{
+    using namespace Orientation;
+
+    const int64_t n = g.num_nodes();
+    if constexpr (is_set_graph<Graph>::value)
+    {
+        using Set = typename Graph::Set;
+        using SetElement = typename Graph::SetElement;
+        std::vector<Set> neighborhoods(n);
+#pragma omp parallel
+        {
+            std::vector<SetElement> neigh;
+#pragma omp for schedule(dynamic, 256)
+            for (NodeId v = 0; v < n; v++)
+            {
+                neigh.clear();
+                for (NodeId w : g.out_neigh(v))
+                {
+                    if (precedes(ranking, v, w))
+                        neigh.push_back(relabel ? ranking[w] : w);
+                }
+                std::sort(neigh.begin(), neigh.end());
+                neighborhoods[relabel ? ranking[v] : v] = Set(neigh.data(), neigh.size());
+            }
+        }
+        return Graph(std::move(neighborhoods));
+    }
+    else
+    {
+        if (g.directed())
+            throw std::invalid_argument("Graph must be undirected");
+
+        NodeId **out_index, **in_index;
+        NodeId *out_neighs, *in_neighs;
+        filterCSR(g, ranking, relabel, true, &out_index, &out_neighs);
+        filterCSR(g, ranking, relabel, false, &in_index, &in_neighs);
+        return Graph(n, out_index, out_neighs, in_index, in_neighs);
+    }
+}
+} // namespace PpParallel
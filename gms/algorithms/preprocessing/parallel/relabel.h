@@ -0,0 +1,151 @@
+#pragma once
+
+#include "../general.h"
+#include "degeneracy_bucketed.h"
+#include "orient.h"
+
+#include <gms/representations/graphs/permuters/permuter_registry.h>
+
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace PpParallel
+{
+/**
+ * Physical relabeling of a graph: vertex v of the original graph is vertex new_ids[v] of the relabeled graph, and
+ * vertex v of the relabeled graph is vertex original_ids[v] of the original graph.
+ */
+struct Relabeling
+{
+    std::vector<NodeId> new_ids;
+    std::vector<NodeId> original_ids;
+
+    Relabeling() = default;
+
+    // new_ids has to be a permutation of the vertices
+    template <class Ranking>
+    explicit Relabeling(const Ranking &ranking) : new_ids(ranking.begin(), ranking.end()), original_ids(ranking.size())
+    {
+        const int64_t n = new_ids.size();
+#pragma omp parallel for schedule(static)
+        for (int64_t v = 0; v < n; v++)
+            original_ids[new_ids[v]] = v;
+    }
+
+    bool empty() const { return new_ids.empty(); }
+};
+
+namespace Relabel
+{
+    // Decreasing degree, ties by decreasing id, i.e. the same relabeling as Builder::RelabelByDegree.
+    template <class Graph>
+    std::vector<NodeId> degreeRanking(const Graph &g)
+    {
+        using DegreeNode = std::pair<int64_t, NodeId>;
+        const int64_t n = g.num_nodes();
+        std::vector<DegreeNode> pairs(n);
+#pragma omp parallel for schedule(static)
+        for (NodeId v = 0; v < n; v++)
+            pairs[v] = {g.out_degree(v), v};
+        __gnu_parallel::sort(pairs.begin(), pairs.end(), std::greater<DegreeNode>());
+        std::vector<NodeId> ranking(n);
+#pragma omp parallel for schedule(static)
+        for (NodeId i = 0; i < n; i++)
+            ranking[pairs[i].second] = i;
+        return ranking;
+    }
+
+    // Orderings available in addition to the permuters, see GMS::Permuters::permuter_names.
+    inline const std::vector<std::string> &orderingNames()
+    {
+        static const std::vector<std::string> names = {"degree", "degeneracy"};
+        return names;
+    }
+
+    inline std::string availableOrderings()
+    {
+        std::string result;
+        for (const auto &name : orderingNames())
+            result += (result.empty() ? "" : ", ") + name;
+        return result + ", " + GMS::Permuters::joined_names(GMS::Permuters::permuter_names());
+    }
+} // namespace Relabel
+
+/**
+ * Computes the relabeling of g for one of the orderings in Relabel::availableOrderings():
+ * - degree: decreasing degree (hubs first),
+ * - degeneracy: the degeneracy ordering of the bucketed k-core decomposition,
+ * - any of the vertex permuters, e.g. rcm, gorder or rabbit_order (community based).
+ *
+ * @return std::nullopt if the ordering is unknown.
+ */
+inline std::optional<Relabeling> computeRelabeling(CSRGraph &g, const std::string &ordering)
+{
+    if (ordering == "degree")
+        return Relabeling(Relabel::degreeRanking(g));
+    if (ordering == "degeneracy")
+    {
+        std::vector<NodeId> ranking;
+        getDegeneracyOrderingBucketed<CSRGraph, true>(g, ranking);
+        return Relabeling(ranking);
+    }
+    auto variant = GMS::Permuters::find_by_name(GMS::Permuters::permuter_names(), ordering);
+    if (!variant)
+        return std::nullopt;
+    CLApp cli(0, nullptr, "dummy");
+    BuilderBase<NodeId, NodeId, NodeId> b(cli);
+    return Relabeling(GMS::Permuters::permutation(b, g, *variant));
+}
+
+/**
+ * Relabels g, vertex v becomes relabeling.new_ids[v]. The neighbourhoods are rebuilt in parallel and sorted.
+ */
+inline CSRGraph relabelGraph(const CSRGraph &g, const Relabeling &relabeling)
+{
+    pvector<NodeId> new_ids(relabeling.new_ids.size());
+    std::copy(relabeling.new_ids.begin(), relabeling.new_ids.end(), new_ids.begin());
+    return BuilderBase<NodeId, NodeId, NodeId>::RelabelByRanking(g, new_ids);
+}
+
+/**
+ * Relabeling stage of the GMS command line, installed with
+ * parser.set_relabeler(PpParallel::relabelByOrdering, PpParallel::Relabel::availableOrderings()).
+ *
+ * @param original_ids set to Relabeling::original_ids, to report per vertex results in the ids of g
+ * @return std::nullopt if the ordering is unknown.
+ */
+inline std::optional<CSRGraph> relabelByOrdering(CSRGraph &g, const std::string &ordering,
+                                                 std::vector<NodeId> &original_ids)
+{
+    auto relabeling = computeRelabeling(g, ordering);
+    if (!relabeling)
+        return std::nullopt;
+    CSRGraph relabeled = relabelGraph(g, *relabeling);
+    original_ids = std::move(relabeling->original_ids);
+    return relabeled;
+}
+
+template <class SGraph, std::enable_if_t<Orientation::is_set_graph<SGraph>::value, int> = 0>
+SGraph relabelGraph(const SGraph &g, const Relabeling &relabeling)
+{
+    using Set = typename SGraph::Set;
+    using SetElement = typename SGraph::SetElement;
+    const int64_t n = g.num_nodes();
+    std::vector<Set> neighborhoods(n);
+#pragma omp parallel
+    {
+        std::vector<SetElement> neigh;
+#pragma omp for schedule(dynamic, 256)
+        for (NodeId v = 0; v < n; v++)
+        {
+            neigh.clear();
+            for (NodeId w : g.out_neigh(v))
+                neigh.push_back(relabeling.new_ids[w]);
+            std::sort(neigh.begin(), neigh.end());
+            neighborhoods[relabeling.new_ids[v]] = Set(neigh.data(), neigh.size());
+        }
+    }
+    return SGraph(std::move(neighborhoods));
+}
+} // namespace PpParallel
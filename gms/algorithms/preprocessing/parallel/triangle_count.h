@@ -6,7 +6,7 @@
 namespace PpParallel {
 
     template<class SGraph>
-    using TriangleCountFn_t = void (*)(const SGraph &graph, pvector<int64_t> &counts);
+    using TriangleCountFn_t = void (*)(const SGraph &graph, pvector<int64_t> &counts, int64_t prefetch_distance);
 
     template<class SGraph, TriangleCountFn_t<SGraph> CountFn = GMS::TriangleCount::Par::vertex_count2_once, class Output = std::vector<NodeId>>
     void triangleCountOrdering(const SGraph &graph, Output &ordering) {
@@ -14,7 +14,7 @@ namespace PpParallel {
         ordering.resize(num_nodes);
 
         pvector<int64_t> counts(num_nodes);
-        CountFn(graph, counts);
+        CountFn(graph, counts, GMS::Prefetch::kDefaultDistance);
 
         for (NodeId u = 0; u < num_nodes; ++u) {
             ordering[u] = u;
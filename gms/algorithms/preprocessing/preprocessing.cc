@@ -15,58 +15,97 @@ using namespace std::placeholders;
 
 
 template <class CGraph>
-void benchmark_suite_csr(const CGraph &g, const CLI::Args &args, std::string graph_name)
+void benchmark_suite_csr(const CGraph &g, const CLI::Args &args, std::string graph_name, size_t samples)
 {
     using namespace PpParallel;
 
+    auto degeneracy_verifier = [samples](const CSRGraph &g, std::vector<NodeId> &result) {
+        return DegeneracyOrderingVerifier::degeneracyOrderingVerifier(g, result, samples);
+    };
+    auto approx_verifier = [samples](const CSRGraph &g, std::vector<NodeId> &result) {
+        return DegeneracyOrderingVerifier::degeneracyOrderingApproxVerifier(g, result, samples);
+    };
+
     auto label = [&](std::string base) { return "ADG_C_" + base + "_" + graph_name; };
 
+    std::cout << "===========================> Degeneracy Bucketed PAR " << graph_name << std::endl;
+    BenchmarkKernel(args, g, preprocessing_wrap_return<CGraph>(getDegeneracyOrderingBucketed<CGraph>),
+                    degeneracy_verifier, "DG_C_Bucketed_" + graph_name);
+
+    // Danisch et al.'s sequential peeling with the three ordered collections. Their ranking gives the first peeled
+    // vertex the highest rank, so it is reversed before it is verified as a degeneracy ordering.
+    auto rank_verifier = [samples](const CSRGraph &g, std::vector<NodeId> &result) {
+        std::vector<NodeId> rank(result.size());
+        for (size_t v = 0; v < result.size(); v++)
+            rank[v] = result.size() - 1 - result[v];
+        return DegeneracyOrderingVerifier::degeneracyOrderingVerifier<true>(g, rank, samples);
+    };
+
+    std::cout << "===========================> Degeneracy Danisch Heap SEQ " << graph_name << std::endl;
+    BenchmarkKernel(args, g, preprocessing_wrap_return<CGraph>(PpSequential::getDegeneracyOrderingDanischHeap<CGraph, std::vector<NodeId>>),
+                    rank_verifier, "DG_C_Danisch-Heap_" + graph_name);
+
+    std::cout << "===========================> Degeneracy Danisch Bubbling SEQ " << graph_name << std::endl;
+    BenchmarkKernel(args, g, preprocessing_wrap_return<CGraph>(PpSequential::getDegeneracyOrderingDanischBubble<CGraph, std::vector<NodeId>>),
+                    rank_verifier, "DG_C_Danisch-Bubbling_" + graph_name);
+
+    std::cout << "===========================> Degeneracy Danisch Bucket SEQ " << graph_name << std::endl;
+    BenchmarkKernel(args, g, preprocessing_wrap_return<CGraph>(PpSequential::getDegeneracyOrderingDanischBucket<CGraph, std::vector<NodeId>>),
+                    rank_verifier, "DG_C_Danisch-Bucket_" + graph_name);
+
     std::cout << "===========================> ADG AVG 0.01" << graph_name << std::endl;
     BenchmarkKernel(args, g,
                     preprocessing_wrap_return<CGraph>(getDegeneracyOrderingApproxCGraph<boundary_function::averageDegree, false, CGraph>, 0.01),
-                    PpVerifier::DegOrderingApproxVerifier<CGraph>, label("AVG_0.01"));
+                    approx_verifier, label("AVG_0.01"));
 
     std::cout << "===========================> ADG AVG 0.1 " << graph_name << std::endl;
     BenchmarkKernel(args, g,
                     preprocessing_wrap_return<CGraph>(getDegeneracyOrderingApproxCGraph<boundary_function::averageDegree, false, CGraph>, 0.1),
-                    PpVerifier::DegOrderingApproxVerifier<CGraph>, label("AVG_0.1"));
+                    approx_verifier, label("AVG_0.1"));
     std::cout << "===========================> ADG AVG 0.5 " << graph_name << std::endl;
     BenchmarkKernel(args, g,
                     preprocessing_wrap_return<CGraph>(getDegeneracyOrderingApproxCGraph<boundary_function::averageDegree, false, CGraph>, 0.5),
-                    PpVerifier::DegOrderingApproxVerifier<CGraph>, label("AVG_0.5"));
+                    approx_verifier, label("AVG_0.5"));
 
     std::cout << "===========================> ADG MIN 0.1 " << graph_name << std::endl;
     BenchmarkKernel(args, g,
                     preprocessing_wrap_return<CGraph>(getDegeneracyOrderingApproxCGraph<boundary_function::minDegree, false, CGraph>, 0.1),
-                    PpVerifier::DegOrderingApproxVerifier<CGraph>, label("MIN_0.1"));
+                    approx_verifier, label("MIN_0.1"));
     std::cout << "===========================> ADG MIN 0.5 " << graph_name << std::endl;
     BenchmarkKernel(args, g,
                     preprocessing_wrap_return<CGraph>(getDegeneracyOrderingApproxCGraph<boundary_function::minDegree, false, CGraph>, 0.5),
-                    PpVerifier::DegOrderingApproxVerifier<CGraph>, label("MIN_0.5"));
+                    approx_verifier, label("MIN_0.5"));
 
     std::cout << "===========================> ADG PMIN 0.1 " << graph_name << std::endl;
     BenchmarkKernel(args, g,
                     preprocessing_wrap_return<CGraph>(getDegeneracyOrderingApproxCGraph<boundary_function::probMinDegree, false, CGraph>, 0.1),
-                    PpVerifier::DegOrderingApproxVerifier<CGraph>, label("PMIN_0.1"));
+                    approx_verifier, label("PMIN_0.1"));
     std::cout << "===========================> ADG PMIN 0.5 " << graph_name << std::endl;
     BenchmarkKernel(args, g,
             preprocessing_wrap_return<CGraph>(getDegeneracyOrderingApproxCGraph<boundary_function::probMinDegree, false, CGraph>, 0.5),
-                    PpVerifier::DegOrderingApproxVerifier<CGraph>, label("PMIN_0.5"));
+                    approx_verifier, label("PMIN_0.5"));
 
     std::cout << "===========================> ADG PMEDIAN 0.1 " << graph_name << std::endl;
     BenchmarkKernel(args, g,
                     preprocessing_wrap_return<CGraph>(getDegeneracyOrderingApproxCGraph<boundary_function::probMedianDegree, false, CGraph>, 0.1),
-                    PpVerifier::DegOrderingApproxVerifier<CGraph>, label("PMED_0.1"));
+                    approx_verifier, label("PMED_0.1"));
     std::cout << "===========================> ADG PMEDIAN 0.5 " << graph_name << std::endl;
     BenchmarkKernel(args, g,
                     preprocessing_wrap_return<CGraph>(getDegeneracyOrderingApproxCGraph<boundary_function::probMedianDegree, false, CGraph>, 0.5),
-                    PpVerifier::DegOrderingApproxVerifier<CGraph>, label("PMED_0.5"));
+                    approx_verifier, label("PMED_0.5"));
 }
 
 template <class SGraph>
-void benchmark_suite_setgraph(const CSRGraph &g, const CLI::Args &args, std::string setgraph_name) {
+void benchmark_suite_setgraph(const CSRGraph &g, const CLI::Args &args, std::string setgraph_name, size_t samples) {
     using namespace PpParallel;
 
+    auto degeneracy_verifier = [samples](const CSRGraph &g, std::vector<NodeId> &result) {
+        return DegeneracyOrderingVerifier::degeneracyOrderingVerifier(g, result, samples);
+    };
+    auto approx_verifier = [samples](const CSRGraph &g, std::vector<NodeId> &result) {
+        return DegeneracyOrderingVerifier::degeneracyOrderingApproxVerifier(g, result, samples);
+    };
+
     auto label = [&](const std::string name) {
         return std::string("PP-") + name + "-" + setgraph_name;
     };
@@ -74,17 +113,21 @@ void benchmark_suite_setgraph(const CSRGraph &g, const CLI::Args &args, std::str
     std::cout << "===========================> Degeneracy Matula SEQ SGraph=" << setgraph_name << ":" << std::endl;
     BenchmarkKernelBk<SGraph>(args, g,
                               preprocessing_wrap_return<SGraph>(PpSequential::getDegeneracyOrderingMatula<SGraph>),
-                              PpVerifier::DegOrderingVerifier, label("Matula-SEQ"));
+                              degeneracy_verifier, label("Matula-SEQ"));
 
     std::cout << "===========================> Degeneracy Approx PAR SGraph=" << setgraph_name << ":" << std::endl;
     BenchmarkKernelBk<SGraph>(
             args, g, preprocessing_wrap_return<SGraph>(PpParallel::getDegeneracyOrderingApproxSGraph<boundary_function::averageDegree, false, SGraph>, 0.001),
-            PpVerifier::DegOrderingApproxVerifier<>, label("ADG-PAR"));
+            approx_verifier, label("ADG-PAR"));
 
     std::cout << "===========================> Degeneracy Matula PAR SGraph=" << setgraph_name << ":" << std::endl;
-    BenchmarkKernelBk<SGraph>(args, g, preprocessing_wrap_return<SGraph>(PpParallel::getDegeneracyOrderingMatula<SGraph>), PpVerifier::DegOrderingVerifier,
+    BenchmarkKernelBk<SGraph>(args, g, preprocessing_wrap_return<SGraph>(PpParallel::getDegeneracyOrderingMatula<SGraph>), degeneracy_verifier,
                               label("Matula-PAR"));
 
+    std::cout << "===========================> Degeneracy Bucketed PAR SGraph=" << setgraph_name << ":" << std::endl;
+    BenchmarkKernelBk<SGraph>(args, g, preprocessing_wrap_return<SGraph>(PpParallel::getDegeneracyOrderingBucketed<SGraph>), degeneracy_verifier,
+                              label("Bucketed-PAR"));
+
     std::cout << "===========================> Degree Parallel PAR SGraph=" << setgraph_name << ":" << std::endl;
     BenchmarkKernelBk<SGraph>(args, g, preprocessing_wrap_return<SGraph>(PpParallel::getDegreeOrdering<SGraph>), PpVerifier::DegreeOrderingVerifier,
                               label("DEG-PAR"));
@@ -98,14 +141,18 @@ void benchmark_suite_setgraph(const CSRGraph &g, const CLI::Args &args, std::str
 
 int main(int argc, char *argv[])
 {
+    CLI::Parser parser;
+    auto param_samples = parser.add_param("verify-samples", std::nullopt, "0",
+                                          "verify the orderings on this many random vertices (0: verify all vertices)");
     // TODO formerly allow_relabel
-    auto [args, g] = CLI::Parser().parse_and_load(argc, argv);
+    auto [args, g] = parser.parse_and_load(argc, argv);
+    const size_t samples = param_samples.to_int();
 
-    benchmark_suite_setgraph<RoaringGraph>(g, args, "RoaringGraph");
+    benchmark_suite_setgraph<RoaringGraph>(g, args, "RoaringGraph", samples);
     // Note: Commented out since it doesn't provide any performance improvements.
-    //benchmark_suite_setgraph<SortedSetGraph>(g, cli, "SortedSetGraph");
+    //benchmark_suite_setgraph<SortedSetGraph>(g, cli, "SortedSetGraph", samples);
 
-    benchmark_suite_csr(g, args, "CSR");
+    benchmark_suite_csr(g, args, "CSR", samples);
 
     CLI::GapbsCompat cli(args);
     Builder builder(cli);
@@ -9,11 +9,13 @@
 #include "sequential/degree.h"
 #include "sequential/degeneracy_matula.h"
 #include "sequential/degeneracy_danisch.h"
-#include "sequential/apply_order.h"
+#include "parallel/core_maintenance.h"
 #include "parallel/degeneracy_approx_csr.h"
 #include "parallel/degeneracy_approx_set.h"
+#include "parallel/degeneracy_bucketed.h"
 #include "parallel/degeneracy_matula.h"
 #include "parallel/degree.h"
+#include "parallel/orient.h"
 #include "parallel/triangle_count.h"
 #include "verifiers/verifiers.h"
 #include "util/wrap.h"
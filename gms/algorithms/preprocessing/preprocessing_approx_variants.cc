@@ -93,6 +93,7 @@ int compareApproxVariations(const CSRGraph &g, int trials)
             std::cout << "\t\t\t Relative Approximation Error: " << coreInfo.relativeError << "\n";
             std::cout << "\t\t\t Fault Rate:                   " << coreInfo.faultRate << "\n";
             std::cout << "\t\t\t Relative Mean Difference:     " << coreInfo.relativeMeanDifference << "\n";
+            std::cout << "\t\t\t Approximation Factor:         " << coreInfo.approximationFactor << "\n";
         }
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <type_traits>
 #include <vector>
 
 #include "../general.h"
@@ -28,22 +29,33 @@ namespace PpSequential
         {
             KV_T kv = orderedColl.PopHead();
             ranking[kv.Key] = g.num_nodes() - (++rcounter);
-            std::vector<KV_T> neighbours(kv.Value);
-            NodeId idx = 0;
-            for(NodeId j : g.out_neigh(kv.Key))
+            if constexpr (std::is_void_v<Comparer_T>)
             {
-                // if node is still in subgraph
-                if(orderedColl.GetIndex(j) != -1)
+                // the bucket queue decreases in O(1) regardless of the order of the neighbours
+                for(NodeId j : g.out_neigh(kv.Key))
                 {
-                    neighbours[idx] = orderedColl.GetKeyValue(j);
-                    idx++;
+                    orderedColl.DecreaseValueOfKey(j);
                 }
             }
-            auto cmp = Comparer_T();
-            std::sort(neighbours.begin(), neighbours.end(), cmp);
-            for(KV_T neighbour : neighbours)
+            else
             {
-                orderedColl.DecreaseValueOfKey(neighbour.Key);
+                std::vector<KV_T> neighbours(kv.Value);
+                NodeId idx = 0;
+                for(NodeId j : g.out_neigh(kv.Key))
+                {
+                    // if node is still in subgraph
+                    if(orderedColl.GetIndex(j) != -1)
+                    {
+                        neighbours[idx] = orderedColl.GetKeyValue(j);
+                        idx++;
+                    }
+                }
+                auto cmp = Comparer_T();
+                std::sort(neighbours.begin(), neighbours.end(), cmp);
+                for(KV_T neighbour : neighbours)
+                {
+                    orderedColl.DecreaseValueOfKey(neighbour.Key);
+                }
             }
         }
     }
@@ -61,4 +73,10 @@ namespace PpSequential
         getDegeneracyOrderingDanisch<coreOrdering::TrackingBubblingArray<NodeId, NodeId>,
                 coreOrdering::NodeComparerMax>(g, ranking);
     }
+
+    template <class CGraph = CSRGraph, class Output = pvector<NodeId>>
+    void getDegeneracyOrderingDanischBucket(const CGraph &g, Output &ranking)
+    {
+        getDegeneracyOrderingDanisch<coreOrdering::TrackingBucketQueue<NodeId, NodeId>, void>(g, ranking);
+    }
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 #ifndef PPLIB_UTIL_ORDEREDCOLLECTION_H
 #define PPLIB_UTIL_ORDEREDCOLLECTION_H
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "auxiliary.h"
 
@@ -275,6 +277,111 @@ namespace coreOrdering
         }
     };
 
+    /**
+     * Bucket queue over non-negative integer values (Batagelj and Zaversnik, 2003).
+     *
+     * The key-value pairs are kept in one array sorted by value, _bucketStart[v] is the first index of the pairs with
+     * value v. DecreaseValueOfKey swaps the pair with the first pair of its bucket and moves the bucket border by one,
+     * so both DecreaseValueOfKey and PopHead are O(1), independent of the size of the buckets.
+     * Values mustn't be decreased below 0.
+     */
+    template<typename Key_T, typename Value_T>
+    class TrackingBucketQueue : public OrderedCollection<
+        Key_T, Value_T>
+    {
+    public:
+        typedef KeyValuePair<Key_T, Value_T> KeyValue_T;
+
+    private:
+        uint _size;
+        KeyValue_T* _keyValue;
+        uint _start;
+        std::vector<int> _keyLocation;
+        std::vector<uint> _bucketStart;
+
+        inline void Swap(const int idxA, const int idxB)
+        {
+            std::swap(_keyLocation[_keyValue[idxA].Key], _keyLocation[_keyValue[idxB].Key]);
+            std::swap(_keyValue[idxA], _keyValue[idxB]);
+        }
+
+    public:
+        // Sorts keyValues in place with a counting sort, the keys have to be in [0, size).
+        TrackingBucketQueue(KeyValue_T* keyValues, uint size)
+        : _size(size), _keyValue(keyValues), _start(0), _keyLocation(size)
+        {
+            Value_T maxValue = 0;
+            for(uint i = 0; i < _size; i++)
+            {
+                maxValue = std::max(maxValue, _keyValue[i].Value);
+            }
+            _bucketStart.assign(maxValue + 2, 0);
+            for(uint i = 0; i < _size; i++)
+            {
+                _bucketStart[_keyValue[i].Value + 1]++;
+            }
+            for(size_t v = 1; v < _bucketStart.size(); v++)
+            {
+                _bucketStart[v] += _bucketStart[v-1];
+            }
+            std::vector<KeyValue_T> sorted(_size);
+            std::vector<uint> next(_bucketStart.begin(), _bucketStart.end() - 1);
+            for(uint i = 0; i < _size; i++)
+            {
+                sorted[next[_keyValue[i].Value]++] = _keyValue[i];
+            }
+            std::copy(sorted.begin(), sorted.end(), _keyValue);
+            for(uint i = 0; i < _size; i++)
+            {
+                _keyLocation[_keyValue[i].Key] = i;
+            }
+        }
+
+        virtual int GetIndex(const Key_T& key) const override
+        {
+            return _keyLocation[key];
+        }
+
+        virtual KeyValue_T GetKeyValue(const Key_T& key) const override
+        {
+            return _keyValue[GetIndex(key)];
+        }
+
+        virtual KeyValue_T& GetKeyValueRef(const Key_T& key) override
+        {
+            return _keyValue[GetIndex(key)];
+        }
+
+        virtual void DecreaseValueOfKey(const Key_T& key) override
+        {
+            int idx = GetIndex(key);
+            if(idx == -1)
+            {
+                return;
+            }
+            Value_T value = _keyValue[idx].Value;
+            // popped pairs in front of _start may still be counted to the bucket
+            uint first = std::max(_bucketStart[value], _start);
+            Swap(first, idx);
+            _bucketStart[value] = first + 1;
+            _keyValue[first].Value--;
+        }
+
+        virtual uint Size() const override
+        {
+            return _size;
+        }
+
+        virtual KeyValue_T PopHead() override
+        {
+            KeyValue_T head = _keyValue[_start];
+            _keyLocation[head.Key] = -1;
+            _start++;
+            _size--;
+            return head;
+        }
+    };
+
 } // end namespace
 
 #endif
\ No newline at end of file
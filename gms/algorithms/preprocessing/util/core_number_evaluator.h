@@ -4,7 +4,11 @@
 #define CORENRVERIFIER_H
 
 #include "gms/algorithms/preprocessing/general.h"
-#include "gms/algorithms/preprocessing/verifiers/degeneracy_verifier.h"
+#include "gms/algorithms/preprocessing/parallel/degeneracy_bucketed.h"
+#include "gms/third_party/gapbs/platform_atomics.h"
+
+#include <numeric>
+#include <random>
 
 namespace CoreNumberEvaluator
 {
@@ -15,6 +19,8 @@ CoreNumber: Is the core number of the graph
 relativeError: Relative approxmiation error (approx - real)/real
 faultRate: What is the proportion of vertices in the order which breaks the ordering, i.e. which have a deg > core Num
 relativeMeanDifference: What is the average relative difference between an outlier and the core Num
+approximationFactor: Core number of the order divided by the core number of the graph
+sampledVertices: Number of vertices the values are based on if they were sampled, 0 if all vertices were evaluated
 */
 struct CoreNumberInfo
 {
@@ -23,6 +29,8 @@ struct CoreNumberInfo
     double relativeError;
     double faultRate;
     double relativeMeanDifference;
+    double approximationFactor = 1.;
+    size_t sampledVertices = 0;
 
     //Auxiliary function to get get average over mutliple runs
     void add(CoreNumberInfo other)
@@ -31,6 +39,7 @@ struct CoreNumberInfo
         relativeError += other.relativeError;
         faultRate += other.faultRate;
         relativeMeanDifference += other.relativeMeanDifference;
+        approximationFactor += other.approximationFactor;
     }
 
     //Auxiliary function to get get average over mutliple runs
@@ -40,6 +49,7 @@ struct CoreNumberInfo
         relativeError /= numberOfRuns;
         faultRate /= numberOfRuns;
         relativeMeanDifference /= numberOfRuns;
+        approximationFactor /= numberOfRuns;
     }
 };
 
@@ -70,94 +80,137 @@ void switchOrderingFormat(const Input &ordering, Output &result)
         result[ordering[v]] = v;
 }
 
+// Rank of every vertex (rank[v] = position of v in the ordering), computed in parallel.
+// Returns false if the ordering isn't a permutation of the n vertices.
 template<bool useRankFormat = false, class Input = std::vector<NodeId>>
-CoreNumberInfo evaluateCoreNrAccuracy(const Input &order, const RoaringGraph &graph, size_t actualCoreNumber)
+bool toRankFormat(const Input &ordering, int64_t n, std::vector<NodeId> &rank)
 {
+    rank.assign(n, -1);
+    if (static_cast<int64_t>(ordering.size()) != n)
+        return false;
+
+    bool permutation = true;
     if constexpr (useRankFormat)
     {
-        std::vector<NodeId> orderFormat(graph.num_nodes());
-        switchOrderingFormat(order, orderFormat);
-        return evaluateCoreNrAccuracy<false>(orderFormat, graph, actualCoreNumber);
+        std::vector<NodeId> owner(n, -1); // owner[i] = vertex at position i
+#pragma omp parallel for reduction(&& : permutation)
+        for (NodeId v = 0; v < n; v++)
+        {
+            NodeId position = ordering[v];
+            rank[v] = position;
+            permutation = permutation && position >= 0 && position < n && compare_and_swap(owner[position], (NodeId)-1, v);
+        }
     }
-    else {
-        size_t coreNumber = actualCoreNumber;
-        unsigned biggerThanCore = 0;
-        unsigned int difAcc = 0;
-
-        RoaringSet visited{};
-
-        for (auto v : order)
+    else
+    {
+#pragma omp parallel for reduction(&& : permutation)
+        for (NodeId i = 0; i < n; i++)
         {
-            auto deg = graph.out_neigh(v)
-                        .difference(visited)
-                        .cardinality();
-
-            if (deg > actualCoreNumber)
-            {
-                coreNumber = std::max(coreNumber, deg);
-                biggerThanCore++;
-                difAcc += deg - actualCoreNumber;
-            }
-
-            visited.union_inplace(v);
+            NodeId v = ordering[i];
+            permutation = permutation && v >= 0 && v < n && compare_and_swap(rank[v], (NodeId)-1, i);
         }
-
-        return {
-            coreNumber,
-            actualCoreNumber,
-            (coreNumber - actualCoreNumber) / (double)actualCoreNumber,
-            (double)biggerThanCore / (double)graph.num_nodes(),
-            (biggerThanCore == 0) ? 0 : ((double)difAcc / (double)biggerThanCore) / (double)actualCoreNumber};
     }
+    return permutation;
 }
 
-//Get The degeneracy/Core Number of an order
-template<bool useRankFormat = false, class Input = std::vector<NodeId>>
-size_t getCoreNumberOfOrder(const Input &order, const RoaringGraph &graph)
-{   
-    if constexpr (useRankFormat)
+// Back-degree of v: the number of neighbours which come after v in the ordering, i.e. the degree of v at the time
+// it is removed. The largest back-degree is the core number of the ordering.
+template<class AnyGraph>
+size_t getBackDegree(const AnyGraph &graph, const std::vector<NodeId> &rank, NodeId v)
+{
+    size_t deg = 0;
+    for (NodeId w : graph.out_neigh(v))
+        deg += rank[w] > rank[v];
+    return deg;
+}
+
+/*
+The vertices whose back-degree is evaluated: all vertices, or, if samples > 0, that many vertices drawn uniformly at
+random (with replacement). The sampled back-degrees only give a lower bound of the core number of the ordering, but
+if none of them exceeds a bound, less than a fraction of about 3 / samples of all vertices exceeds it with
+95% confidence.
+*/
+inline std::vector<NodeId> selectVertices(int64_t n, size_t samples, uint64_t seed)
+{
+    std::vector<NodeId> vertices;
+    if (samples == 0 || n == 0)
     {
-        std::vector<NodeId> orderFormat(graph.num_nodes());
-        switchOrderingFormat(order, orderFormat);
-        return getCoreNumberOfOrder<false>(orderFormat, graph);
+        vertices.resize(n);
+        std::iota(vertices.begin(), vertices.end(), 0);
     }
     else
     {
-        RoaringSet visited{};
-        size_t coreNumber = 0;
-        for (auto v : order)
-        {
-            auto deg = graph.out_neigh(v)
-                        .difference(visited)
-                        .cardinality();
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<NodeId> distribution(0, n - 1);
+        vertices.resize(samples);
+        for (auto &v : vertices)
+            v = distribution(rng);
+    }
+    return vertices;
+}
 
+template<bool useRankFormat = false, class Input = std::vector<NodeId>, class AnyGraph = RoaringGraph>
+CoreNumberInfo evaluateCoreNrAccuracy(const Input &order, const AnyGraph &graph, size_t actualCoreNumber,
+                                      size_t samples = 0, uint64_t seed = 42)
+{
+    std::vector<NodeId> rank;
+    toRankFormat<useRankFormat>(order, graph.num_nodes(), rank);
+    const std::vector<NodeId> vertices = selectVertices(graph.num_nodes(), samples, seed);
+    const int64_t checked = vertices.size();
+
+    size_t coreNumber = actualCoreNumber;
+    size_t biggerThanCore = 0;
+    size_t difAcc = 0;
+#pragma omp parallel for schedule(dynamic, 256) reduction(max : coreNumber) reduction(+ : biggerThanCore, difAcc)
+    for (int64_t i = 0; i < checked; i++)
+    {
+        size_t deg = getBackDegree(graph, rank, vertices[i]);
+        if (deg > actualCoreNumber)
+        {
             coreNumber = std::max(coreNumber, deg);
-            visited.union_inplace(v);
+            biggerThanCore++;
+            difAcc += deg - actualCoreNumber;
         }
-        return coreNumber;
     }
+
+    return {
+        coreNumber,
+        actualCoreNumber,
+        (coreNumber - actualCoreNumber) / (double)actualCoreNumber,
+        (double)biggerThanCore / (double)std::max<int64_t>(checked, 1),
+        (biggerThanCore == 0) ? 0 : ((double)difAcc / (double)biggerThanCore) / (double)actualCoreNumber,
+        actualCoreNumber == 0 ? 1. : (double)coreNumber / (double)actualCoreNumber,
+        samples};
 }
 
-template<bool useRankFormat = false, class Input = std::vector<NodeId>>
-CoreNumberInfo evaluateCoreNrAccuracy(const Input &order, const RoaringGraph &graph)
+//Get The degeneracy/Core Number of an order, i.e. the largest back-degree
+template<bool useRankFormat = false, class Input = std::vector<NodeId>, class AnyGraph = RoaringGraph>
+size_t getCoreNumberOfOrder(const Input &order, const AnyGraph &graph, size_t samples = 0, uint64_t seed = 42)
 {
-    std::vector<NodeId> matulaDegeneracyOrder(graph.num_nodes());
-    PpSequential::getDegeneracyOrderingMatula<RoaringGraph, false>(graph, matulaDegeneracyOrder);
-    if constexpr(useRankFormat)
-    {
-        std::vector<NodeId> orderFormat(graph.num_nodes());
-        switchOrderingFormat(order, orderFormat);
-        return evaluateCoreNrAccuracy<false>(orderFormat, graph, getCoreNumberOfOrder(matulaDegeneracyOrder, graph));
-    }
-    else
-        return evaluateCoreNrAccuracy<false>(order, graph, getCoreNumberOfOrder(matulaDegeneracyOrder, graph));
+    std::vector<NodeId> rank;
+    toRankFormat<useRankFormat>(order, graph.num_nodes(), rank);
+    const std::vector<NodeId> vertices = selectVertices(graph.num_nodes(), samples, seed);
+    const int64_t checked = vertices.size();
+
+    size_t coreNumber = 0;
+#pragma omp parallel for schedule(dynamic, 256) reduction(max : coreNumber)
+    for (int64_t i = 0; i < checked; i++)
+        coreNumber = std::max(coreNumber, getBackDegree(graph, rank, vertices[i]));
+    return coreNumber;
 }
 
-template<bool useRankFormat = false, class Input = std::vector<NodeId>>
-CoreNumberInfo evaluateCoreNrAccuracy(const Input &order, const CSRGraph &graph)
+//Degeneracy of the graph, i.e. the largest core number
+template<class AnyGraph>
+size_t getDegeneracy(const AnyGraph &graph)
+{
+    std::vector<NodeId> cores;
+    return PpParallel::getCoreNumbers(graph, cores);
+}
+
+template<bool useRankFormat = false, class Input = std::vector<NodeId>, class AnyGraph = RoaringGraph>
+CoreNumberInfo evaluateCoreNrAccuracy(const Input &order, const AnyGraph &graph)
 {
-    RoaringGraph rgraph = RoaringGraph::FromCGraph(graph);
-    return evaluateCoreNrAccuracy<useRankFormat>(order, rgraph);
+    return evaluateCoreNrAccuracy<useRankFormat>(order, graph, getDegeneracy(graph));
 }
 
 } // namespace CoreNumberVerifier
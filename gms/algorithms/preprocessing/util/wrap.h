@@ -1,5 +1,7 @@
 #pragma once
 #include <gms/common/types.h>
+#include <cstdio>
+#include <string>
 
 template <class AnyGraph, class Fn>
 constexpr auto preprocessing_wrap_return(Fn fn) {
@@ -19,9 +21,28 @@ constexpr auto preprocessing_wrap_return(Fn fn, double epsilon) {
     };
 }
 
+/**
+ * Preprocessing function with a bound epsilon. The bound value is reported by parameters(), so that BenchmarkKernelBkPP
+ * stores the orderings computed with different values under different keys of the ordering cache.
+ */
 template <class Fn>
-constexpr auto preprocessing_bind(Fn fn, double epsilon) {
-    return [fn, epsilon](const auto &g, auto &output) {
+struct PreprocessingBinding {
+    Fn fn;
+    double epsilon;
+
+    template <class Graph, class Output>
+    void operator()(const Graph &g, Output &output) const {
         fn(g, output, epsilon);
-    };
-}
\ No newline at end of file
+    }
+
+    std::string parameters() const {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "epsilon=%.17g", epsilon);
+        return buffer;
+    }
+};
+
+template <class Fn>
+constexpr auto preprocessing_bind(Fn fn, double epsilon) {
+    return PreprocessingBinding<Fn>{fn, epsilon};
+}
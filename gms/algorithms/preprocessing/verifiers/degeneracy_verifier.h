@@ -4,11 +4,15 @@
 #define DEGENERACYVERIFIER_H
 
 #include "../general.h"
-#include "../sequential/degeneracy_matula.h"
+#include "../parallel/degree.h"
 #include "gms/algorithms/preprocessing/util/core_number_evaluator.h"
 
 #include <gms/common/format.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
 namespace DegeneracyOrderingVerifier
 {
 
@@ -67,49 +71,201 @@ unsigned int getDegeneracy(RoaringGraph graph)
 }
 
 
-bool degegeneracyOrderingVerifier(const CSRGraph &g, std::vector<NodeId> &result)
+/**
+ * Degeneracy computed with the sequential bucket peel of Batagelj and Zaversnik (Matula and Beck) in O(n + m). It
+ * shares no code with the parallel k-core decompositions, so it is the reference they are verified against.
+ */
+template<class CGraph>
+size_t sequentialDegeneracy(const CGraph &g)
 {
-    if(g.num_nodes() != result.size())
-        return false;
+    const int64_t n = g.num_nodes();
+    std::vector<int64_t> degree(n), position(n), vertices(n);
+    int64_t maxDegree = 0;
+    for (NodeId v = 0; v < n; v++)
+    {
+        degree[v] = g.out_degree(v);
+        maxDegree = std::max(maxDegree, degree[v]);
+    }
 
-    const RoaringGraph rgraph = RoaringGraph::FromCGraph(g);
-    auto degeneracy = getDegeneracy(RoaringGraph::FromCGraph(g));
-    RoaringSet visited = {};
-    bool correct = true;
-    for (auto &v : result)
+    // bin[d] = position of the first vertex of degree d in vertices, which is sorted by degree
+    std::vector<int64_t> bin(maxDegree + 1, 0);
+    for (NodeId v = 0; v < n; v++)
+        bin[degree[v]]++;
+    int64_t start = 0;
+    for (int64_t d = 0; d <= maxDegree; d++)
+    {
+        const int64_t count = bin[d];
+        bin[d] = start;
+        start += count;
+    }
+    for (NodeId v = 0; v < n; v++)
     {
-        auto deg = rgraph.out_neigh(v).difference(visited).cardinality();
-        correct = correct && (degeneracy >= deg);
-        visited.union_inplace(v);
+        position[v] = bin[degree[v]]++;
+        vertices[position[v]] = v;
     }
-    return correct;
+    for (int64_t d = maxDegree; d > 0; d--)
+        bin[d] = bin[d - 1];
+    bin[0] = 0;
+
+    size_t degeneracy = 0;
+    for (int64_t i = 0; i < n; i++)
+    {
+        const NodeId v = vertices[i];
+        degeneracy = std::max<size_t>(degeneracy, degree[v]);
+        for (NodeId u : g.out_neigh(v))
+        {
+            if (degree[u] <= degree[v])
+                continue;
+            // move u to the front of its bin, then the bin starts one position later
+            const int64_t du = degree[u], pu = position[u], pw = bin[du];
+            const NodeId w = vertices[pw];
+            if (u != w)
+            {
+                position[u] = pw;
+                vertices[pu] = w;
+                position[w] = pu;
+                vertices[pw] = u;
+            }
+            bin[du]++;
+            degree[u]--;
+        }
+    }
+    return degeneracy;
 }
 
-template<class CGraph = CSRGraph, bool useRankFormat = false>
-bool degeneracyOrderingApproxVerifier(const CGraph &g, std::vector<NodeId> &result)
+/**
+ * Whether the vertices at the positions >= first of the ordering (rank[v] = position of v, order[i] = vertex at
+ * position i) induce a subgraph in which every vertex has at least k neighbours, which proves that the degeneracy is at
+ * least k. With samples > 0, only that many random vertices of the suffix are checked.
+ */
+template<class CGraph>
+bool isCoreSuffix(const CGraph &g, const std::vector<NodeId> &rank, const std::vector<NodeId> &order, NodeId first,
+                  size_t k, size_t samples, uint64_t seed = 42)
 {
-    auto n = g.num_nodes();
-    if(n != result.size())
+    const std::vector<NodeId> positions = CoreNumberEvaluator::selectVertices(g.num_nodes() - first, samples, seed);
+    const int64_t checked = positions.size();
+    bool core = true;
+#pragma omp parallel for schedule(dynamic, 256) reduction(&& : core)
+    for (int64_t i = 0; i < checked; i++)
+    {
+        size_t degree = 0;
+        for (NodeId w : g.out_neigh(order[first + positions[i]]))
+            degree += rank[w] >= first;
+        core = core && degree >= k;
+    }
+    return core;
+}
+
+/**
+ * The degeneracy the back-degrees of an ordering are compared with. The peeling algorithms start the k-core, k being
+ * the largest back-degree, at the first vertex with back-degree k, so this suffix proves that the degeneracy is k
+ * (which is also a lower bound of the largest back-degree of every ordering). That check is parallel and takes O(m).
+ * If the ordering has no such suffix, the degeneracy is computed with sequentialDegeneracy.
+ *
+ * With samples > 0, only the back-degrees and the suffix degrees of sampled vertices are checked (see
+ * CoreNumberEvaluator::selectVertices), so no pass over the whole graph is needed if the sampled suffix is a core.
+ * The result is then a probabilistic lower bound of the degeneracy.
+ *
+ * @param fromSuffix set to whether the degeneracy was proven by the suffix
+ */
+template<class CGraph>
+size_t referenceDegeneracy(const CGraph &g, const std::vector<NodeId> &rank, size_t samples, bool &fromSuffix,
+                           uint64_t seed = 42)
+{
+    const int64_t n = g.num_nodes();
+    const std::vector<NodeId> vertices = CoreNumberEvaluator::selectVertices(n, samples, seed);
+    const int64_t checked = vertices.size();
+    std::vector<size_t> backDegree(checked);
+    size_t largest = 0;
+#pragma omp parallel for schedule(dynamic, 256) reduction(max : largest)
+    for (int64_t i = 0; i < checked; i++)
+    {
+        backDegree[i] = CoreNumberEvaluator::getBackDegree(g, rank, vertices[i]);
+        largest = std::max(largest, backDegree[i]);
+    }
+    NodeId first = n;
+#pragma omp parallel for reduction(min : first)
+    for (int64_t i = 0; i < checked; i++)
+    {
+        if (backDegree[i] == largest)
+            first = std::min(first, rank[vertices[i]]);
+    }
+
+    std::vector<NodeId> order(n);
+#pragma omp parallel for
+    for (NodeId v = 0; v < n; v++)
+        order[rank[v]] = v;
+
+    fromSuffix = first < n && isCoreSuffix(g, rank, order, first, largest, samples, seed + 1);
+    return fromSuffix ? largest : sequentialDegeneracy(g);
+}
+
+// Prints the quality of an ordering which was checked by one of the verifiers below.
+inline void printOrderQuality(const CoreNumberEvaluator::CoreNumberInfo &info, bool fromSuffix)
+{
+    char factor[32];
+    std::snprintf(factor, sizeof(factor), "%.3f", info.approximationFactor);
+    PrintLabel("Max Back-Degree", std::to_string(info.coreNumberOfOrder));
+    PrintLabel("Degeneracy", std::to_string(info.coreNumber));
+    PrintLabel("Degeneracy Proof", fromSuffix ? "core suffix" : "sequential peel");
+    PrintLabel("Approximation Factor", factor);
+    if (info.sampledVertices > 0)
+        PrintLabel("Sampled Vertices", std::to_string(info.sampledVertices));
+}
+
+/**
+ * Checks that result is a degeneracy ordering (in order format) of g, i.e. that no vertex has more than degeneracy
+ * neighbours after it in the ordering. The back-degrees are computed in parallel, the degeneracy is proven by the
+ * ordering or computed independently of the algorithms under test, see referenceDegeneracy.
+ *
+ * @param samples If > 0, only the back-degrees of that many randomly drawn vertices are checked
+ *                (see CoreNumberEvaluator::selectVertices), which is a probabilistic verification.
+ */
+template<bool useRankFormat = false, class CGraph = CSRGraph>
+bool degeneracyOrderingVerifier(const CGraph &g, const std::vector<NodeId> &result, size_t samples)
+{
+    std::vector<NodeId> rank;
+    if (!CoreNumberEvaluator::toRankFormat<useRankFormat>(result, g.num_nodes(), rank))
         return false;
 
-    //Check that all vertices are present in ordering
-    RoaringSet visited = {};
-    for (int v = 0; v < n; v++)
-        visited.add(v);
+    bool fromSuffix = false;
+    const size_t degeneracy = referenceDegeneracy(g, rank, samples, fromSuffix);
+    auto info = CoreNumberEvaluator::evaluateCoreNrAccuracy<true>(rank, g, degeneracy, samples);
+    printOrderQuality(info, fromSuffix);
+    return info.coreNumberOfOrder <= info.coreNumber;
+}
 
-    if(visited.cardinality() != g.num_nodes())
+bool degeneracyOrderingVerifier(const CSRGraph &g, std::vector<NodeId> &result)
+{
+    return degeneracyOrderingVerifier(g, result, 0);
+}
+
+/**
+ * Checks that result is a permutation of the vertices of g whose core number is at most the core number of the degree
+ * ordering, and reports the approximation factor which was achieved. See degeneracyOrderingVerifier for samples.
+ */
+template<class CGraph = CSRGraph, bool useRankFormat = false>
+bool degeneracyOrderingApproxVerifier(const CGraph &g, const std::vector<NodeId> &result, size_t samples)
+{
+    std::vector<NodeId> rank;
+    if (!CoreNumberEvaluator::toRankFormat<useRankFormat>(result, g.num_nodes(), rank))
         return false;
 
     //Check that core Number of order is at least as good as degree ordering
     std::vector<NodeId> degreeOrdering(g.num_nodes());
     PpParallel::getDegreeOrdering(g, degreeOrdering);
-    const RoaringGraph rgraph = RoaringGraph::FromCGraph(g);
-    auto coreNumberDegree = CoreNumberEvaluator::getCoreNumberOfOrder(degreeOrdering, rgraph);
-    auto coreNumberInput = CoreNumberEvaluator::getCoreNumberOfOrder<useRankFormat>(result, rgraph);
-    if(coreNumberInput > coreNumberDegree)
-        return false;
+    auto coreNumberDegree = CoreNumberEvaluator::getCoreNumberOfOrder(degreeOrdering, g);
+    bool fromSuffix = false;
+    const size_t degeneracy = referenceDegeneracy(g, rank, samples, fromSuffix);
+    auto info = CoreNumberEvaluator::evaluateCoreNrAccuracy<true>(rank, g, degeneracy, samples);
+    printOrderQuality(info, fromSuffix);
+    return info.coreNumberOfOrder <= coreNumberDegree;
+}
 
-    return true;
+template<class CGraph = CSRGraph, bool useRankFormat = false>
+bool degeneracyOrderingApproxVerifier(const CGraph &g, std::vector<NodeId> &result)
+{
+    return degeneracyOrderingApproxVerifier<CGraph, useRankFormat>(g, result, 0);
 }
 
 template<bool useRankFormat = false>
@@ -6,7 +6,7 @@
 // TODO consolidate like preprocessing.h
 namespace PpVerifier
 {
-    constexpr bool (&DegOrderingVerifier)(const CSRGraph &g, std::vector<NodeId> &result) = DegeneracyOrderingVerifier::degegeneracyOrderingVerifier;
+    constexpr bool (&DegOrderingVerifier)(const CSRGraph &g, std::vector<NodeId> &result) = DegeneracyOrderingVerifier::degeneracyOrderingVerifier;
     template <class CGraph = CSRGraph>
     constexpr bool (&DegOrderingApproxVerifier)(const CGraph &g, std::vector<NodeId> &result) = DegeneracyOrderingVerifier::degeneracyOrderingApproxVerifier<CGraph>;
     constexpr bool (&DegreeOrderingVerifier)(const CSRGraph &g, std::vector<NodeId> &result) = DegeneracyOrderingVerifier::degreeOrderingVerifier;
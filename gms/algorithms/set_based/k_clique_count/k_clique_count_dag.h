@@ -0,0 +1,156 @@
+#pragma once
+
+#include <gms/representations/graphs/set_graph.h>
+#include <gms/representations/sets/sorted_set_operations.h>
+#include <gms/algorithms/preprocessing/parallel/degeneracy_bucketed.h>
+#include <gms/algorithms/preprocessing/parallel/orient.h>
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace CliqueCountDag
+{
+    // Sets which are sorted arrays (SortedSet), they are intersected by merging instead of lookups.
+    template <class Set>
+    constexpr bool is_sorted_array = std::is_base_of_v<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<decltype(std::declval<const Set &>().begin())>::iterator_category>;
+
+    /**
+     * Cheap necessary condition for the intersection of the candidates with a neighborhood to have at least
+     * `needed` elements, checked before the intersection is computed.
+     */
+    template <class Set>
+    inline bool at_least(size_t candidates, const Set &neigh, size_t needed)
+    {
+        return candidates >= needed && neigh.cardinality() >= needed;
+    }
+
+    // |[begin, end) ∩ neigh| without materializing the intersection.
+    template <class Set, class SetElement>
+    inline size_t intersect_count(const SetElement *begin, const SetElement *end, const Set &neigh)
+    {
+        if constexpr (is_sorted_array<Set>)
+        {
+            return vec_set_intersect_count(begin, end, neigh.begin(), neigh.end());
+        }
+        else
+        {
+            size_t count = 0;
+            for (const SetElement *it = begin; it != end; ++it)
+                count += neigh.contains(*it);
+            return count;
+        }
+    }
+
+    /**
+     * Candidate sets of one thread, one preallocated buffer per level. The candidates of a level are the common
+     * out-neighbors of the vertices chosen so far, sorted by id, i.e. by rank in the oriented graph.
+     */
+    template <class SetElement>
+    class LevelBuffers
+    {
+    public:
+        LevelBuffers(size_t levels, size_t capacity) : _data(levels, std::vector<SetElement>(capacity)), _size(levels, 0) {}
+
+        SetElement *begin(size_t level) { return _data[level].data(); }
+        SetElement *end(size_t level) { return _data[level].data() + _size[level]; }
+        size_t size(size_t level) const { return _size[level]; }
+        void resize(size_t level, size_t size) { _size[level] = size; }
+
+    private:
+        std::vector<std::vector<SetElement>> _data;
+        std::vector<size_t> _size;
+    };
+
+    /**
+     * Counts the cliques of `remaining` more vertices among the candidates of `level`. A candidate v at position i
+     * can only be followed by the candidates behind it that are out-neighbors of v, so each clique is found exactly
+     * once. The last level only counts, with intersect_count, instead of building another candidate set.
+     */
+    template <class SGraph, class SetElement>
+    size_t RecursiveStep(const SGraph &dag, size_t remaining, size_t level, LevelBuffers<SetElement> &buffers)
+    {
+        const SetElement *begin = buffers.begin(level), *end = buffers.end(level);
+        size_t count = 0;
+        if (remaining == 2)
+        {
+            for (const SetElement *it = begin; it != end; ++it)
+                count += intersect_count(it + 1, end, dag.out_neigh(*it));
+            return count;
+        }
+
+        for (const SetElement *it = begin; it != end; ++it)
+        {
+            const auto &neigh = dag.out_neigh(*it);
+            if (!at_least(end - it - 1, neigh, remaining - 1))
+                continue;
+            SetElement *out = buffers.begin(level + 1);
+            for (const SetElement *w = it + 1; w != end; ++w)
+            {
+                if (neigh.contains(*w))
+                    *(out++) = *w;
+            }
+            buffers.resize(level + 1, out - buffers.begin(level + 1));
+            if (buffers.size(level + 1) >= remaining - 1)
+                count += RecursiveStep(dag, remaining - 1, level + 1, buffers);
+        }
+        return count;
+    }
+
+    /**
+     * Set based k-clique counting on the degeneracy oriented graph: every edge points to the vertex later in the
+     * degeneracy ordering, so every clique is reached once, from its first vertex, instead of once per permutation.
+     * The candidate sets live in per thread, per level buffers of the size of the largest out-degree (at most the
+     * degeneracy), so no sets are allocated during the recursion.
+     *
+     * @param ranking degeneracy ordering of the graph in rank format
+     */
+    template <class SGraph>
+    size_t CliqueCount(const SGraph &graph, const std::vector<NodeId> &ranking, size_t k = 4)
+    {
+        using SetElement = typename SGraph::SetElement;
+        const int64_t n = graph.num_nodes();
+        if (k == 1)
+            return n;
+
+        const SGraph dag = PpParallel::OrientByRank(graph, ranking);
+
+        size_t max_degree = 0;
+#pragma omp parallel for reduction(max : max_degree)
+        for (NodeId u = 0; u < n; ++u)
+            max_degree = std::max<size_t>(max_degree, dag.out_degree(u));
+
+        size_t total = 0;
+#pragma omp parallel reduction(+ : total)
+        {
+            LevelBuffers<SetElement> buffers(std::max<size_t>(k - 1, 1), max_degree);
+#pragma omp for schedule(dynamic, 64)
+            for (NodeId u = 0; u < n; ++u)
+            {
+                const auto &neigh = dag.out_neigh(u);
+                if (neigh.cardinality() < k - 1)
+                    continue;
+                SetElement *out = buffers.begin(0);
+                for (NodeId v : neigh)
+                    *(out++) = v;
+                std::sort(buffers.begin(0), out);
+                buffers.resize(0, out - buffers.begin(0));
+                total += k == 2 ? buffers.size(0) : RecursiveStep(dag, k - 1, 0, buffers);
+            }
+        }
+        return total;
+    }
+
+    // Same as CliqueCount(graph, ranking, k) with the ranking computed by getDegeneracyOrderingBucketed.
+    template <class SGraph>
+    size_t CliqueCount(const SGraph &graph, size_t k = 4)
+    {
+        std::vector<NodeId> ranking;
+        if (k > 1)
+            PpParallel::getDegeneracyOrderingBucketed<SGraph, true>(graph, ranking);
+        return CliqueCount(graph, ranking, k);
+    }
+} // namespace CliqueCountDag
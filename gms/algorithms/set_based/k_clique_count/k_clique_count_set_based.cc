@@ -1,18 +1,21 @@
 #include "k_clique_count_set_based.h"
+#include "k_clique_count_dag.h"
 
 #include "gms/third_party/gapbs/benchmark.h"
 #include "gms/third_party/gapbs/command_line.h"
 
 #include <gms/representations/graphs/set_graph.h>
 #include <gms/common/cli/cli.h>
+#include <gms/algorithms/preprocessing/parallel/relabel.h>
 #include <gms/common/benchmark.h>
+#include <gms/algorithms/non_set_based/k_clique_list/clique_counting.h>
 
 using namespace GMS;
 
 // TODO
 //What to compare with?
 template <typename Set, typename SGraph, typename Set2>
-bool CliqueCountVerifier(CSRGraph &g, size_t test_total = 0, size_t k = 4) {
+bool CliqueCountVerifier(const CSRGraph &g, size_t test_total = 0, size_t k = 4) {
     size_t total = CliqueCount<Set, SGraph, Set2>(g, k);
     std::cout << "acc: " << (float)((float)test_total - total) / total * 100 << "\% error: true " << total << " counted " << test_total << std::endl;
     if (total != test_total)
@@ -20,16 +23,55 @@ bool CliqueCountVerifier(CSRGraph &g, size_t test_total = 0, size_t k = 4) {
     return total == test_total;
 }
 
+// Degeneracy ordering of g in rank format, from the ordering cache if it is enabled.
+template <class Graph>
+std::vector<NodeId> degeneracy_ranking(const Graph &g, OrderingCache::CachedOrdering &cache) {
+    std::vector<NodeId> ranking;
+    cache.get(ranking, [&g](std::vector<NodeId> &r) { PpParallel::getDegeneracyOrderingBucketed<Graph, true>(g, r); });
+    cache.print();
+    return ranking;
+}
+
+// Danisch et al.'s node parallel k-clique listing on the degeneracy oriented CSRGraph, the reference for the DAG
+// based set kernels.
+size_t DanischCliqueCount(const CSRGraph &g, const GMS::KClique::CLCliqueApp &cli,
+                          OrderingCache::CachedOrdering &cache) {
+    const std::vector<NodeId> ranking = degeneracy_ranking(g, cache);
+    CSRGraph dag = PpParallel::OrientByRank<CSRGraph>(g, ranking);
+    return GMS::KClique::Par::NP_kclisting<CSRGraph>(dag, cli);
+}
+
 void PrintCliqueStats(const CSRGraph &g, size_t total_cliques) {
     std::cout << total_cliques << " cliques" << std::endl;
 }
 
 int main(int argc, char *argv[]) {
     CLI::Parser parser;
+    parser.set_relabeler(PpParallel::relabelByOrdering, PpParallel::Relabel::availableOrderings());
     // TODO formerly allow_relabel
     auto clique_size = parser.add_param("clique-size", "cs", "4", "the clique size");
     auto [args, g] = parser.parse_and_load(argc, argv);
     size_t k = clique_size.to_int();
+    const GMS::KClique::CLCliqueApp clique_cli(args, clique_size);
+
+    // Danisch et al.'s k-clique listing and the DAG oriented kernels, verified against the undirected set based count,
+    // which finds every clique once per ordering of its k vertices
+    size_t orderings = 1;
+    for (size_t i = 2; i <= k; ++i)
+        orderings *= i;
+    OrderingCache::CachedOrdering degeneracy(args.ordering_cache_mode(), args.ordering_cache, g, "degeneracy");
+    auto danisch = [&clique_cli, &degeneracy](const CSRGraph &g) { return DanischCliqueCount(g, clique_cli, degeneracy); };
+    auto verify_count = [k, orderings](const CSRGraph &g, size_t test_total) {
+        return CliqueCountVerifier<SortedSet, SortedSetGraph, SortedSet>(g, test_total * orderings, k);
+    };
+    auto dag_count = [k, &degeneracy](const auto &sg) {
+        return CliqueCountDag::CliqueCount(sg, degeneracy_ranking(sg, degeneracy), k);
+    };
+
+    BenchmarkKernel(args, g, danisch, verify_count, "Danisch", "CSRGraph");
+    BenchmarkKernelBk<RoaringGraph>(args, g, dag_count, verify_count, "DAG", "RoaringGraph");
+    BenchmarkKernelBk<SortedSetGraph>(args, g, dag_count, verify_count, "DAG", "SortedSetGraph");
+    BenchmarkKernelBk<RobinHoodGraph>(args, g, dag_count, verify_count, "DAG", "RobinHoodGraph");
 
     BenchmarkKernel(args, g, CliqueCount<RoaringSet, RoaringGraph, RoaringSet>,
                             CliqueCountVerifier<RoaringSet, RoaringGraph,RoaringSet>, k,
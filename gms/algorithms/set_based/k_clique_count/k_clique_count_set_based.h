@@ -17,7 +17,7 @@ size_t RecursiveStepCliqueCount(SGraph& graph, const size_t k, const Set &isect)
 }
 
 template <typename Set, typename SGraph, typename Set2>
-size_t CliqueCount(CSRGraph &g, size_t k = 4) {
+size_t CliqueCount(const CSRGraph &g, size_t k = 4) {
     size_t n = g.num_nodes();
     SGraph set_graph = SGraph::FromCGraph(g);
     size_t total = 0;
@@ -0,0 +1,51 @@
+#include "gms/third_party/gapbs/benchmark.h"
+
+#include <gms/common/cli/cli.h>
+#include <gms/algorithms/preprocessing/parallel/relabel.h>
+#include <gms/representations/graphs/set_graph.h>
+#include <gms/common/benchmark.h>
+
+#include "k_truss.h"
+#include "verifier.h"
+
+using namespace GMS;
+using namespace GMS::KTruss;
+
+// the maximum trussness is printed by the verifier, outside of the timed kernel
+bool verify_trussness(const CSRGraph &g, const Par::TrussDecomposition &result) {
+    PrintLabel("Max Trussness", std::to_string(result.max_trussness()));
+    return Verify::trussness(g, result);
+}
+
+template <class SGraph>
+void benchmark_suite(CLI::Args &args, const CSRGraph &g, std::string graphName)
+{
+    auto label = [&](std::string name) {
+        return "k-truss-" + name + "-" + graphName;
+    };
+
+    auto edge_support = [](const SGraph &g) {
+        std::vector<int64_t> support;
+        Par::edge_support(g, support);
+        return support;
+    };
+    auto truss_decomposition = [](const SGraph &g) {
+        return Par::truss_decomposition(g);
+    };
+
+    BenchmarkKernelBk<SGraph>(args, g, edge_support, Verify::edge_support<>, label("edge-support-par"));
+    BenchmarkKernelBk<SGraph>(args, g, truss_decomposition, verify_trussness, label("decomposition-par"));
+}
+
+int main(int argc, char *argv[])
+{
+    CLI::Parser parser;
+    parser.set_relabeler(PpParallel::relabelByOrdering, PpParallel::Relabel::availableOrderings());
+    auto [args, g] = parser.parse_and_load(argc, argv);
+
+    benchmark_suite<RoaringGraph>(args, g, "RoaringGraph");
+    benchmark_suite<SortedSetGraph>(args, g, "SortedSetGraph");
+    benchmark_suite<RobinHoodGraph>(args, g, "RobinHoodGraph");
+
+    return 0;
+}
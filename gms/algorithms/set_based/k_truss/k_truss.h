@@ -0,0 +1,4 @@
+#pragma once
+
+#include "parallel/edge_support.h"
+#include "parallel/truss_decomposition.h"
@@ -0,0 +1,82 @@
+#pragma once
+#include <gms/common/types.h>
+#include <gms/algorithms/set_based/triangle_count/parallel/edge_partitioned.h>
+#include <algorithm>
+#include <vector>
+#include <omp.h>
+
+namespace GMS::KTruss::Par {
+
+/**
+ * Ids of the undirected edges: the edge {u, v} with u < v has the id offsets[u] + i if v is the i-th smallest
+ * neighbor of u greater than u, i.e. the ids are the CSR offsets of the upper triangle of the adjacency matrix.
+ */
+struct EdgeIndex {
+    pvector<SGOffset> offsets;
+    std::vector<NodeId> sources;
+    std::vector<NodeId> targets;   // sorted per source
+
+    EdgeIndex() = default;
+
+    template <class Graph>
+    explicit EdgeIndex(const Graph &graph) {
+        const int64_t n = graph.num_nodes();
+        pvector<NodeId> degrees(n);
+#pragma omp parallel for schedule(dynamic, 64)
+        for (NodeId u = 0; u < n; ++u) {
+            NodeId degree = 0;
+            for (NodeId v : graph.out_neigh(u))
+                degree += u < v;
+            degrees[u] = degree;
+        }
+        offsets = TriangleCount::Par::EdgePartition::prefix_sum(degrees);
+
+        const int64_t m = offsets[n];
+        sources.resize(m);
+        targets.resize(m);
+#pragma omp parallel for schedule(dynamic, 64)
+        for (NodeId u = 0; u < n; ++u) {
+            SGOffset e = offsets[u];
+            for (NodeId v : graph.out_neigh(u)) {
+                if (u < v) {
+                    sources[e] = u;
+                    targets[e++] = v;
+                }
+            }
+            std::sort(targets.begin() + offsets[u], targets.begin() + e);
+        }
+    }
+
+    int64_t num_nodes() const { return offsets.size() - 1; }
+    int64_t num_edges() const { return targets.size(); }
+
+    /** Id of the edge {u, v}, -1 if there is no such edge. */
+    int64_t find(NodeId u, NodeId v) const {
+        if (v < u)
+            std::swap(u, v);
+        auto begin = targets.begin() + offsets[u], end = targets.begin() + offsets[u + 1];
+        auto it = std::lower_bound(begin, end, v);
+        return it != end && *it == v ? it - targets.begin() : -1;
+    }
+};
+
+/**
+ * Computes the support of every edge, i.e. the number of triangles it is part of, as |N(u) ∩ N(v)|. The supports
+ * are indexed by the edge ids of index.
+ */
+template <class SGraph, class Output = std::vector<int64_t>>
+void edge_support(const SGraph &graph, const EdgeIndex &index, Output &support) {
+    const int64_t m = index.num_edges();
+    support.resize(m);
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (int64_t e = 0; e < m; ++e) {
+        support[e] = graph.out_neigh(index.sources[e]).intersect_count(graph.out_neigh(index.targets[e]));
+    }
+}
+
+template <class SGraph, class Output = std::vector<int64_t>>
+void edge_support(const SGraph &graph, Output &support) {
+    edge_support(graph, EdgeIndex(graph), support);
+}
+
+}
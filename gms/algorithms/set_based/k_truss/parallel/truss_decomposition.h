@@ -0,0 +1,154 @@
+#pragma once
+#include <gms/common/types.h>
+#include <gms/third_party/gapbs/platform_atomics.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <omp.h>
+#include "edge_support.h"
+
+namespace GMS::KTruss::Par {
+
+/**
+ * Trussness of every edge: the edge with id e is part of the k-truss for all k <= trussness[e], where the k-truss is
+ * the maximal subgraph in which every edge is part of at least k - 2 triangles.
+ */
+struct TrussDecomposition {
+    EdgeIndex edges;
+    std::vector<NodeId> trussness;
+
+    NodeId max_trussness() const {
+        return trussness.empty() ? 0 : *std::max_element(trussness.begin(), trussness.end());
+    }
+
+    /** Number of edges of the k-truss. */
+    int64_t truss_size(NodeId k) const {
+        return std::count_if(trussness.begin(), trussness.end(), [k](NodeId t) { return t >= k; });
+    }
+};
+
+namespace Peeling {
+
+// Appends the edges of values which satisfy pred to out, in parallel.
+template <class Pred>
+void collect(int64_t m, std::vector<int64_t> &out, Pred &&pred) {
+    out.clear();
+#pragma omp parallel
+    {
+        std::vector<int64_t> local;
+#pragma omp for schedule(static) nowait
+        for (int64_t e = 0; e < m; ++e) {
+            if (pred(e))
+                local.push_back(e);
+        }
+#pragma omp critical
+        out.insert(out.end(), local.begin(), local.end());
+    }
+}
+
+/**
+ * Removes one triangle from the support of e, which is above level. If the support drops to level, e is appended to
+ * next, it is never lowered below level.
+ */
+inline void decrement(std::vector<int64_t> &support, int64_t e, int64_t level, std::vector<int64_t> &next) {
+    if (support[e] <= level)
+        return;
+    const int64_t old = fetch_and_add(support[e], -1);
+    if (old == level + 1)
+        next.push_back(e);
+    else if (old <= level)
+        fetch_and_add(support[e], 1);
+}
+
+} // namespace Peeling
+
+/**
+ * Parallel bucketed k-truss decomposition (PKT, Kabir and Madduri, 2017). The edges are peeled level by level: the
+ * frontier are the remaining edges with the smallest support, they are removed in parallel and the supports of the
+ * other two edges of each of their triangles, found by intersecting the neighborhoods of the endpoints, are
+ * decremented. Edges whose support drops to the current level form the next frontier of the same level.
+ *
+ * A triangle with several edges in the frontier is only accounted for once: if two of its edges are removed, the
+ * one with the smaller id decrements the third, if all three are removed there is nothing to update.
+ */
+template <class SGraph>
+TrussDecomposition truss_decomposition(const SGraph &graph) {
+    TrussDecomposition result;
+    result.edges = EdgeIndex(graph);
+    const EdgeIndex &index = result.edges;
+    const int64_t m = index.num_edges();
+
+    std::vector<int64_t> support;
+    edge_support(graph, index, support);
+    result.trussness.assign(m, 0);
+
+    std::vector<uint8_t> processed(m, 0), in_current(m, 0);
+    std::vector<int64_t> current, next;
+    int64_t remaining = m;
+    while (remaining > 0) {
+        // skip the empty levels
+        int64_t level = std::numeric_limits<int64_t>::max();
+#pragma omp parallel for schedule(static) reduction(min:level)
+        for (int64_t e = 0; e < m; ++e) {
+            if (!processed[e])
+                level = std::min(level, support[e]);
+        }
+        Peeling::collect(m, current, [&](int64_t e) { return !processed[e] && support[e] == level; });
+
+        while (!current.empty()) {
+            const int64_t size = current.size();
+#pragma omp parallel for schedule(static)
+            for (int64_t i = 0; i < size; ++i)
+                in_current[current[i]] = 1;
+
+            next.clear();
+#pragma omp parallel
+            {
+                std::vector<int64_t> local;
+#pragma omp for schedule(dynamic, 64) nowait
+                for (int64_t i = 0; i < size; ++i) {
+                    const int64_t e = current[i];
+                    const NodeId u = index.sources[e], v = index.targets[e];
+                    const auto &neigh_u = graph.out_neigh(u);
+                    const auto &neigh_v = graph.out_neigh(v);
+                    const bool u_smaller = neigh_u.cardinality() <= neigh_v.cardinality();
+                    const auto &smaller = u_smaller ? neigh_u : neigh_v;
+                    const auto &larger = u_smaller ? neigh_v : neigh_u;
+                    for (NodeId w : smaller) {
+                        if (!larger.contains(w))
+                            continue;
+                        const int64_t e1 = index.find(u, w), e2 = index.find(v, w);
+                        if (processed[e1] || processed[e2])
+                            continue;
+                        const bool current1 = in_current[e1], current2 = in_current[e2];
+                        if (!current1 && !current2) {
+                            Peeling::decrement(support, e1, level, local);
+                            Peeling::decrement(support, e2, level, local);
+                        } else if (current1 && !current2) {
+                            if (e < e1)
+                                Peeling::decrement(support, e2, level, local);
+                        } else if (!current1 && current2) {
+                            if (e < e2)
+                                Peeling::decrement(support, e1, level, local);
+                        }
+                    }
+                }
+#pragma omp critical
+                next.insert(next.end(), local.begin(), local.end());
+            }
+
+#pragma omp parallel for schedule(static)
+            for (int64_t i = 0; i < size; ++i) {
+                const int64_t e = current[i];
+                processed[e] = 1;
+                in_current[e] = 0;
+                result.trussness[e] = level + 2;
+            }
+            remaining -= size;
+            std::swap(current, next);
+        }
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <vector>
+#include <gms/third_party/gapbs/benchmark.h>
+#include "k_truss.h"
+
+namespace GMS::KTruss::Verify {
+
+// The common neighbors of u and v, the neighborhoods of a CSRGraph are sorted.
+inline std::vector<NodeId> common_neighbors(const CSRGraph &g, NodeId u, NodeId v) {
+    std::vector<NodeId> common;
+    std::set_intersection(g.out_neigh(u).begin(), g.out_neigh(u).end(), g.out_neigh(v).begin(),
+                          g.out_neigh(v).end(), std::back_inserter(common));
+    return common;
+}
+
+/**
+ * Simple serial truss decomposition for verification: the edge with the smallest support is removed one at a time.
+ */
+inline std::vector<NodeId> compute_trussness(const CSRGraph &g, const Par::EdgeIndex &index) {
+    const int64_t m = index.num_edges();
+    std::vector<int64_t> support(m);
+    std::set<std::pair<int64_t, int64_t>> queue;
+    for (int64_t e = 0; e < m; ++e) {
+        support[e] = common_neighbors(g, index.sources[e], index.targets[e]).size();
+        queue.emplace(support[e], e);
+    }
+
+    std::vector<NodeId> trussness(m, 0);
+    std::vector<bool> removed(m, false);
+    int64_t level = 0;
+    while (!queue.empty()) {
+        const auto [s, e] = *queue.begin();
+        queue.erase(queue.begin());
+        level = std::max(level, s);
+        trussness[e] = level + 2;
+        removed[e] = true;
+        const NodeId u = index.sources[e], v = index.targets[e];
+        for (NodeId w : common_neighbors(g, u, v)) {
+            const int64_t e1 = index.find(u, w), e2 = index.find(v, w);
+            if (removed[e1] || removed[e2])
+                continue;
+            for (int64_t f : {e1, e2}) {
+                queue.erase({support[f], f});
+                queue.emplace(--support[f], f);
+            }
+        }
+    }
+    return trussness;
+}
+
+/**
+ * Verification of the edge supports against std::set_intersection, the supports are indexed by the ids of
+ * Par::EdgeIndex.
+ */
+template <class Output = std::vector<int64_t>>
+bool edge_support(const CSRGraph &g, const Output &test_support) {
+    const Par::EdgeIndex index(g);
+    if (static_cast<int64_t>(test_support.size()) != index.num_edges()) {
+        std::cout << "number of edges " << index.num_edges() << " != " << test_support.size() << std::endl;
+        return false;
+    }
+    for (int64_t e = 0; e < index.num_edges(); ++e) {
+        const int64_t support = common_neighbors(g, index.sources[e], index.targets[e]).size();
+        if (support != test_support[e]) {
+            std::cerr << "support of edge {" << index.sources[e] << ", " << index.targets[e]
+                      << "}, expected = " << support << ", actual = " << test_support[e] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Verification of the trussness of every edge using the simple serial implementation.
+ */
+inline bool trussness(const CSRGraph &g, const Par::TrussDecomposition &test) {
+    const Par::EdgeIndex index(g);
+    if (test.edges.num_edges() != index.num_edges()) {
+        std::cout << "number of edges " << index.num_edges() << " != " << test.edges.num_edges() << std::endl;
+        return false;
+    }
+    const std::vector<NodeId> expected = compute_trussness(g, index);
+    for (int64_t e = 0; e < index.num_edges(); ++e) {
+        const NodeId u = index.sources[e], v = index.targets[e];
+        const int64_t test_e = test.edges.find(u, v);
+        if (test_e < 0 || test.trussness[test_e] != expected[e]) {
+            std::cerr << "trussness of edge {" << u << ", " << v << "}, expected = " << expected[e]
+                      << ", actual = " << (test_e < 0 ? -1 : test.trussness[test_e]) << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+}
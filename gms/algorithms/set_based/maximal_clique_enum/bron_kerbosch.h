@@ -12,6 +12,7 @@
 #include "parallel/eppsteinPAR.h"
 #include "parallel/EppsteinSubGraph.h"
 #include "parallel/EppsteinSubGraphAdaptive.h"
+#include "parallel/pivoter.h"
 
 namespace BkSequential
 {
@@ -31,13 +32,13 @@ template <class SGraph = RoaringGraph>
 constexpr auto BkEppsteinDegree = BkEppsteinPar::mce<PpParallel::getDegreeOrdering<SGraph, true>, SGraph>;
 
 template <class SGraph = RoaringGraph>
-constexpr auto BkEppsteinDegeneracy = BkEppsteinPar::mce<PpSequential::getDegeneracyOrderingMatula<SGraph, true>, SGraph>;
+constexpr auto BkEppsteinDegeneracy = BkEppsteinPar::mce<PpParallel::getDegeneracyOrderingBucketed<SGraph, true>, SGraph>;
 
 template <class SGraph>
 constexpr auto BkEppsteinSubGraphDegree = BkEppsteinSubGraph::mce<PpParallel::getDegreeOrdering<SGraph, true>, SGraph>;
 
 template <class SGraph>
-constexpr auto BkEppsteinSubGraphDegeneracy = BkEppsteinSubGraph::mce<PpSequential::getDegeneracyOrderingMatula<SGraph, true>, SGraph>;
+constexpr auto BkEppsteinSubGraphDegeneracy = BkEppsteinSubGraph::mce<PpParallel::getDegeneracyOrderingBucketed<SGraph, true>, SGraph>;
 
 // TODO alias for SubGraphAdaptive
 
@@ -54,7 +55,7 @@ constexpr auto BkEppstein = BkEppsteinPar::mceBench<SGraph>;
 Templates overview:
 --------------------
 Expand := BkTomita::expand | BkTomitaPAR::expand
-PreProcessing := No | PpParallel::getDegeneracyOrderingMatula | PpParallel::getDegeneracyOrderingApprox
+PreProcessing := No | PpParallel::getDegeneracyOrderingBucketed | PpParallel::getDegeneracyOrderingApprox
 Scheduling := Regular Dynamic | Alternating
 */
 
@@ -0,0 +1,79 @@
+#include <gms/common/types.h>
+#include <gms/common/cli/cli.h>
+#include <gms/algorithms/preprocessing/parallel/relabel.h>
+#include <gms/common/benchmark.h>
+#include <gms/representations/graphs/set_graph.h>
+#include <gms/algorithms/set_based/k_clique_count/k_clique_count_dag.h>
+
+#include "bron_kerbosch.h"
+
+using namespace GMS;
+
+using PivoterCounts = BkPivoter::CliqueCounts<BkPivoter::uint128>;
+
+// Compares the counts up to maxK with the DAG based k-clique counting and checks the per vertex counts by their sum.
+template <class SGraph>
+bool verifyPivoter(const CSRGraph &g, const PivoterCounts &counts, size_t maxK)
+{
+    counts.print();
+    const SGraph graph = SGraph::FromCGraph(g);
+    for (size_t k = 1; k <= maxK; k++)
+    {
+        const size_t expected = CliqueCountDag::CliqueCount(graph, k);
+        if (counts.count(k) != expected)
+        {
+            std::cout << k << "-cliques: " << expected << " != " << BkPivoter::toString(counts.count(k)) << std::endl;
+            return false;
+        }
+    }
+    if (counts.perVertexK > 0)
+    {
+        BkPivoter::uint128 sum = 0;
+        for (auto c : counts.perVertex)
+            sum += c;
+        if (sum != counts.perVertexK * counts.count(counts.perVertexK))
+        {
+            std::cout << "sum of the per vertex " << counts.perVertexK << "-clique counts " << BkPivoter::toString(sum)
+                      << " != " << counts.perVertexK << " * " << BkPivoter::toString(counts.count(counts.perVertexK))
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class SGraph>
+void benchmark_suite(const CLI::Args &args, const CSRGraph &g, const std::string setgraph_name, size_t perVertexK,
+                     size_t verifyK, OrderingCache::CachedOrdering &degeneracy)
+{
+    auto pivoter = [perVertexK, &degeneracy](const SGraph &graph) {
+        pvector<NodeId> ordering(graph.num_nodes());
+        degeneracy.get(ordering, [&graph](pvector<NodeId> &r) {
+            PpParallel::getDegeneracyOrderingBucketed<SGraph, true>(graph, r);
+        });
+        degeneracy.print();
+        return BkPivoter::count(graph, ordering, perVertexK);
+    };
+    auto verify = [verifyK](const CSRGraph &g, const PivoterCounts &counts) {
+        return verifyPivoter<SGraph>(g, counts, verifyK);
+    };
+    BenchmarkKernelBk<SGraph>(args, g, pivoter, verify, "Pivoter", setgraph_name);
+}
+
+int main(int argc, char *argv[])
+{
+    CLI::Parser parser;
+    parser.set_relabeler(PpParallel::relabelByOrdering, PpParallel::Relabel::availableOrderings());
+    auto per_vertex = parser.add_param("per-vertex", std::nullopt, "0", "also count the k-cliques of every vertex for this k (0: off)");
+    auto verify_size = parser.add_param("verify-clique-size", std::nullopt, "5", "verify the counts up to this clique size");
+    auto [args, g] = parser.parse_and_load(argc, argv);
+    size_t perVertexK = per_vertex.to_int();
+    size_t verifyK = verify_size.to_int();
+
+    OrderingCache::CachedOrdering degeneracy(args.ordering_cache_mode(), args.ordering_cache, g, "degeneracy");
+    benchmark_suite<RoaringGraph>(args, g, "RoaringGraph", perVertexK, verifyK, degeneracy);
+    benchmark_suite<SortedSetGraph>(args, g, "SortedSetGraph", perVertexK, verifyK, degeneracy);
+    benchmark_suite<RobinHoodGraph>(args, g, "RobinHoodGraph", perVertexK, verifyK, degeneracy);
+
+    return 0;
+}
@@ -23,6 +23,7 @@ void runSubGraphs(const CLI::Args &args, const CSRGraph &g)
     std::cout << "---------------------------------------- Eppstein ADG SG-Adaptive-----------------------------------------------\n";
     BenchmarkKernelBkPP<SGraph>(args, g,
                                 preprocessing_bind(PpParallel::getDegeneracyOrderingApproxSGraph<PpParallel::boundary_function::averageDegree, true, SGraph, pvector<NodeId>>, 0.001),
+                                "approx-degeneracy-average-degree",
                                 BkEppsteinSubGraphAdaptive::mceBench<10, SGraph>, BkVerifier::BronKerboschVerifier<SGraph>,
                                 "BK-GMS-ADG-S");
     BkHelper::printCountAndReset();
@@ -35,6 +36,7 @@ void runEppstein(const CLI::Args &args, const CSRGraph &g)
     std::cout << "---------------------------------------- Eppstein ADG -----------------------------------------------\n";
     BenchmarkKernelBkPP<SGraph>(args, g,
                                 preprocessing_bind(PpParallel::getDegeneracyOrderingApproxSGraph<PpParallel::boundary_function::averageDegree, true, SGraph, pvector<NodeId>>, 0.001),
+                                "approx-degeneracy-average-degree",
                                 BkEppsteinPar::mceBench<SGraph>, BkVerifier::BronKerboschVerifier<SGraph>,
                                 "BK-GMS-ADG");
     BkHelper::printCountAndReset();
@@ -42,7 +44,7 @@ void runEppstein(const CLI::Args &args, const CSRGraph &g)
     std::cout << "---------------------------------------------------------------------------------------------------\n";
     std::cout << "---------------------------------------- Eppstein Degree -----------------------------------------------\n";
     BenchmarkKernelBkPP<SGraph>(args, g,
-                                PpParallel::getDegreeOrdering<SGraph, true, pvector<NodeId>>,
+                                PpParallel::getDegreeOrdering<SGraph, true, pvector<NodeId>>, "degree",
                                 BkEppsteinPar::mceBench<SGraph>, BkVerifier::BronKerboschVerifier<SGraph>,
                                 "BK-GMS-DEG");
     BkHelper::printCountAndReset();
@@ -50,7 +52,7 @@ void runEppstein(const CLI::Args &args, const CSRGraph &g)
     std::cout << "---------------------------------------------------------------------------------------------------\n";
     std::cout << "---------------------------------------- Eppstein Degeneracy -----------------------------------------------\n";
     BenchmarkKernelBkPP<SGraph>(args, g,
-                                PpSequential::getDegeneracyOrderingMatula<SGraph, true, pvector<NodeId>>,
+                                PpParallel::getDegeneracyOrderingBucketed<SGraph, true, pvector<NodeId>>, "degeneracy",
                                 BkEppsteinPar::mceBench<SGraph>, BkVerifier::BronKerboschVerifier<SGraph>,
                                 "BK-GMS-DGR");
     BkHelper::printCountAndReset();
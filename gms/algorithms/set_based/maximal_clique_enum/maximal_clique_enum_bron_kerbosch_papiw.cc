@@ -32,7 +32,7 @@ int main(int argc, char *argv[])
         std::cout << "This build was compiled with the Count flag..." << std::endl;
 
     BenchmarkKernelBkPP<RoaringGraph>(args, g,
-                                      PpSequential::getDegeneracyOrderingMatula<RoaringGraph, true, pvector<NodeId>>,
+                                      PpParallel::getDegeneracyOrderingBucketed<RoaringGraph, true, pvector<NodeId>>, "degeneracy",
                                       BkEppsteinPar::mceBench<RoaringGraph>, BkVerifier::BronKerboschVerifier<RoaringGraph>,
                                       "BK-GMS-DGR");
     BkHelper::printCountAndReset();
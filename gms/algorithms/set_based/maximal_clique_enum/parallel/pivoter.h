@@ -0,0 +1,208 @@
+#pragma once
+
+#include "../general.h"
+#include "../sequential/tomita.h"
+#include <gms/algorithms/preprocessing/parallel/degeneracy_bucketed.h>
+#include <string>
+
+namespace BkPivoter
+{
+    // 128 bit unsigned integer, the default accumulator: the number of cliques of a graph overflows 64 bits already
+    // for a single clique of about 70 vertices.
+    using uint128 = unsigned __int128;
+
+    template <class Count_T>
+    std::string toString(Count_T value)
+    {
+        if constexpr (std::is_same_v<Count_T, uint128>)
+        {
+            if (value == 0)
+                return "0";
+            std::string digits;
+            for (; value > 0; value /= 10)
+                digits.push_back('0' + static_cast<int>(value % 10));
+            return std::string(digits.rbegin(), digits.rend());
+        }
+        else
+        {
+            return std::to_string(value);
+        }
+    }
+
+    /**
+     * total[k] = number of k-cliques for all k from 0 to the size of the largest clique (total[0] = 1 for the empty
+     * clique). If requested, perVertex[v] is the number of perVertexK-cliques which contain v.
+     */
+    template <class Count_T = uint128>
+    struct CliqueCounts
+    {
+        std::vector<Count_T> total;
+        std::vector<Count_T> perVertex;
+        size_t perVertexK = 0;
+
+        Count_T count(size_t k) const { return k < total.size() ? total[k] : Count_T(0); }
+        size_t maxCliqueSize() const { return total.empty() ? 0 : total.size() - 1; }
+
+        void print() const
+        {
+            for (size_t k = 1; k < total.size(); k++)
+                std::cout << k << "-cliques: " << toString(total[k]) << std::endl;
+        }
+    };
+
+    // binomials[n][k] = n choose k for n up to maxN
+    template <class Count_T>
+    std::vector<std::vector<Count_T>> binomialTable(size_t maxN)
+    {
+        std::vector<std::vector<Count_T>> binomials(maxN + 1);
+        for (size_t n = 0; n <= maxN; n++)
+        {
+            binomials[n].assign(n + 1, Count_T(1));
+            for (size_t k = 1; k < n; k++)
+                binomials[n][k] = binomials[n - 1][k - 1] + binomials[n - 1][k];
+        }
+        return binomials;
+    }
+
+    /**
+     * State of the succinct clique tree traversal of one thread: the held vertices are part of every clique of the
+     * current subtree, each subset of the pivots can be added to them.
+     */
+    template <class Count_T>
+    struct Traversal
+    {
+        const std::vector<std::vector<Count_T>> &binomials;
+        std::vector<Count_T> total;
+        std::vector<Count_T> perVertex;
+        size_t perVertexK;
+        std::vector<NodeId> held;
+        std::vector<NodeId> pivots;
+
+        // Every leaf of the tree represents the cliques held + any subset of the pivots, each of them exactly once.
+        void leaf()
+        {
+            const size_t h = held.size(), p = pivots.size();
+            for (size_t j = 0; j <= p; j++)
+                total[h + j] += binomials[p][j];
+            if (perVertexK == 0 || perVertexK < h || perVertexK > h + p)
+                return;
+            const size_t missing = perVertexK - h;
+            for (NodeId v : held)
+                perVertex[v] += binomials[p][missing];
+            if (missing > 0)
+            {
+                for (NodeId v : pivots)
+                    perVertex[v] += binomials[p - 1][missing - 1];
+            }
+        }
+    };
+
+    /*
+    cand:   vertices which extend all cliques of the current subtree (==P)
+    The pivot u maximizes |cand ∩ N(u)|. Every clique either contains a vertex of cand \ N(u) or is a clique of
+    cand ∩ N(u), possibly with u. The vertices of cand \ N(u) other than u are held in their branch and removed from
+    cand afterwards, u itself is added as a pivot, so the cliques of cand ∩ N(u) with and without u share one
+    subtree. (Jain and Seshadhri, The Power of Pivoting for Exact Clique Counting, WSDM 2020)
+    */
+    template <class SGraph, class Set, class Count_T>
+    void expand(Set &cand, const SGraph &graph, Traversal<Count_T> &state)
+    {
+        if (cand.cardinality() == 0)
+        {
+            state.leaf();
+            return;
+        }
+
+        const Set fini;
+        const NodeId pivot = BkTomita::findPivot(cand, fini, graph);
+        auto ext = cand.difference(graph.out_neigh(pivot));
+
+        for (auto q : ext)
+        {
+            auto candNew = cand.intersect(graph.out_neigh(q));
+            auto &stack = q == pivot ? state.pivots : state.held;
+            stack.push_back(q);
+            expand(candNew, graph, state);
+            stack.pop_back();
+            cand.difference_inplace(q);
+        }
+    }
+
+    /**
+     * Counts the cliques of every size in one pass (Pivoter). The outer loop is Eppstein's: every vertex v is the
+     * first vertex, in the degeneracy ordering, of the cliques counted from it, the candidates are its later
+     * neighbours. The vertices are processed in parallel, every thread accumulates into its own counters.
+     *
+     * @param ordering degeneracy ordering of the graph in rank format
+     * @param perVertexK if not 0, also counts the perVertexK-cliques of every vertex
+     */
+    template <class SGraph, class Count_T = uint128, class Set = typename SGraph::Set, class Ordering>
+    CliqueCounts<Count_T> count(const SGraph &graph, const Ordering &ordering, size_t perVertexK = 0)
+    {
+        const NodeId n = graph.num_nodes();
+
+        // the largest clique has at most degeneracy + 1 vertices
+        NodeId maxLater = 0;
+#pragma omp parallel for reduction(max : maxLater)
+        for (NodeId v = 0; v < n; v++)
+        {
+            NodeId later = 0;
+            for (NodeId w : graph.out_neigh(v))
+                later += ordering[w] > ordering[v];
+            maxLater = std::max(maxLater, later);
+        }
+        const auto binomials = binomialTable<Count_T>(maxLater + 1);
+
+        CliqueCounts<Count_T> result;
+        result.total.assign(maxLater + 2, Count_T(0));
+        result.perVertexK = perVertexK;
+        if (perVertexK > 0)
+            result.perVertex.assign(n, Count_T(0));
+
+#pragma omp parallel
+        {
+            Traversal<Count_T> state{binomials, std::vector<Count_T>(maxLater + 2, Count_T(0)), {}, perVertexK, {}, {}};
+            if (perVertexK > 0)
+                state.perVertex.assign(n, Count_T(0));
+            std::vector<NodeId> later;
+
+#pragma omp for schedule(dynamic)
+            for (NodeId v = 0; v < n; v++)
+            {
+                later.clear();
+                for (NodeId w : graph.out_neigh(v))
+                {
+                    if (ordering[w] > ordering[v])
+                        later.push_back(w);
+                }
+                std::sort(later.begin(), later.end());
+                Set cand(later.data(), later.size());
+                state.held.push_back(v);
+                expand(cand, graph, state);
+                state.held.pop_back();
+            }
+
+#pragma omp critical
+            {
+                for (size_t k = 0; k < state.total.size(); k++)
+                    result.total[k] += state.total[k];
+                for (size_t v = 0; v < state.perVertex.size(); v++)
+                    result.perVertex[v] += state.perVertex[v];
+            }
+        }
+        // the empty clique
+        result.total[0] = 1;
+        while (result.total.size() > 1 && result.total.back() == 0)
+            result.total.pop_back();
+        return result;
+    }
+
+    // Same as count(graph, ordering, perVertexK) with the ordering computed by Order(graph, ordering).
+    template <const auto Order, class SGraph, class Count_T = uint128, class Set = typename SGraph::Set>
+    CliqueCounts<Count_T> count(const SGraph &graph, size_t perVertexK = 0)
+    {
+        pvector<NodeId> ordering(graph.num_nodes());
+        Order(graph, ordering);
+        return count<SGraph, Count_T, Set>(graph, ordering, perVertexK);
+    }
+} // namespace BkPivoter
@@ -0,0 +1,205 @@
+#pragma once
+#include <gms/common/types.h>
+#include <gms/common/estimate.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include <omp.h>
+#include "total.h"
+
+namespace GMS::TriangleCount::Approx {
+
+using Estimation::Budget;
+using Estimation::Estimate;
+
+namespace detail {
+
+    template <class Set, class = void>
+    struct is_random_access : std::false_type {};
+
+    template <class Set>
+    struct is_random_access<Set, std::void_t<typename std::iterator_traits<
+        decltype(std::declval<const Set&>().begin())>::iterator_category>>
+        : std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<
+            decltype(std::declval<const Set&>().begin())>::iterator_category> {};
+
+    /**
+     * The i-th neighbour of a vertex in O(1). The neighborhoods of sets without random access iterators (RoaringSet,
+     * RobinHoodSet) are copied into one array once, the others are accessed in place.
+     */
+    template <class SGraph>
+    class NeighborArrays {
+        static constexpr bool kInPlace = is_random_access<typename SGraph::Set>::value;
+
+    public:
+        explicit NeighborArrays(const SGraph &graph) : graph(graph) {
+            if constexpr (!kInPlace) {
+                const int64_t n = graph.num_nodes();
+                offsets.resize(n + 1);
+                offsets[0] = 0;
+                for (NodeId v = 0; v < n; ++v)
+                    offsets[v + 1] = offsets[v] + graph.out_degree(v);
+                neighbors.resize(offsets[n]);
+#pragma omp parallel for schedule(dynamic, 256)
+                for (NodeId v = 0; v < n; ++v)
+                    std::copy(graph.out_neigh(v).begin(), graph.out_neigh(v).end(), neighbors.begin() + offsets[v]);
+            }
+        }
+
+        NodeId operator()(NodeId v, int64_t i) const {
+            if constexpr (kInPlace)
+                return graph.out_neigh(v).begin()[i];
+            else
+                return neighbors[offsets[v] + i];
+        }
+
+    private:
+        const SGraph &graph;
+        std::vector<int64_t> offsets;
+        std::vector<NodeId> neighbors;
+    };
+
+    /**
+     * The subgraph with the edges {u, v} for which keep(u, v) is true, keep has to be symmetric.
+     */
+    template <class SGraph, class Keep>
+    SGraph filter_edges(const SGraph &graph, Keep &&keep) {
+        using Set = typename SGraph::Set;
+        using SetElement = typename SGraph::SetElement;
+        const int64_t n = graph.num_nodes();
+        std::vector<Set> neighborhoods(n);
+#pragma omp parallel
+        {
+            std::vector<SetElement> neigh;
+#pragma omp for schedule(dynamic, 256)
+            for (NodeId u = 0; u < n; ++u) {
+                neigh.clear();
+                for (NodeId v : graph.out_neigh(u)) {
+                    if (keep(u, v))
+                        neigh.push_back(v);
+                }
+                std::sort(neigh.begin(), neigh.end());
+                neighborhoods[u] = Set(neigh.data(), neigh.size());
+            }
+        }
+        return SGraph(std::move(neighborhoods));
+    }
+
+} // namespace detail
+
+/**
+ * DOULION (Tsourakakis et al., KDD 2009): every edge is kept with probability p, the triangles of the sparsified
+ * graph are counted exactly with Par::count_total and scaled by 1 / p^3. The trials are repeated with independent
+ * samples until the confidence interval meets the budget.
+ */
+template <class SGraph>
+Estimate doulion(const SGraph &graph, double p, const Budget &budget = Budget()) {
+    return Estimation::repeat_trials(budget, [&](int64_t round) {
+        const uint64_t seed = Estimation::mix(budget.seed ^ Estimation::mix(round));
+        const uint64_t threshold = static_cast<uint64_t>(p * 18446744073709551615.0);
+        SGraph sparse = detail::filter_edges(graph, [&](NodeId u, NodeId v) {
+            const uint64_t a = std::min(u, v), b = std::max(u, v);
+            return Estimation::mix(seed ^ (a << 32 | b)) <= threshold;
+        });
+        return Par::count_total(sparse) / (p * p * p);
+    });
+}
+
+/**
+ * Color-based sampling (Pagh and Tsourakakis, IPL 2012): every vertex gets one of num_colors colors, only the
+ * monochromatic edges are kept and the triangles of the sparsified graph are counted exactly and scaled by
+ * num_colors^2. Compared to DOULION, the edges of a triangle are kept together with probability 1 / num_colors^2.
+ */
+template <class SGraph>
+Estimate color_sampling(const SGraph &graph, int64_t num_colors, const Budget &budget = Budget()) {
+    const int64_t n = graph.num_nodes();
+    std::vector<uint32_t> colors(n);
+    return Estimation::repeat_trials(budget, [&](int64_t round) {
+        const uint64_t seed = Estimation::mix(budget.seed ^ Estimation::mix(round));
+#pragma omp parallel for schedule(static)
+        for (NodeId u = 0; u < n; ++u)
+            colors[u] = Estimation::mix(seed ^ u) % num_colors;
+        SGraph sparse = detail::filter_edges(graph, [&](NodeId u, NodeId v) { return colors[u] == colors[v]; });
+        return static_cast<double>(Par::count_total(sparse)) * num_colors * num_colors;
+    });
+}
+
+/**
+ * Wedge sampling (Seshadhri et al., SDM 2013): wedges (paths of length two) are sampled uniformly at random, the
+ * fraction of closed wedges estimates the transitivity 3T / W, where W is the number of wedges. The wedges are
+ * sampled in parallel batches until the (binomial) confidence interval meets the budget.
+ *
+ * @return the estimate of the transitivity (the global clustering coefficient).
+ */
+template <class SGraph>
+Estimate transitivity(const SGraph &graph, const Budget &budget = Budget(), double *num_wedges = nullptr) {
+    const int64_t n = graph.num_nodes();
+    // wedges[v] = prefix sum of the number of wedges centered at the vertices < v
+    std::vector<double> wedges(n + 1, 0.);
+    for (NodeId v = 0; v < n; ++v) {
+        const double d = graph.out_degree(v);
+        wedges[v + 1] = wedges[v] + d * (d - 1) / 2;
+    }
+    if (num_wedges != nullptr)
+        *num_wedges = wedges[n];
+
+    Estimate estimate;
+    estimate.confidence = budget.confidence;
+    if (wedges[n] == 0)
+        return estimate;
+
+    const double start = omp_get_wtime();
+    const detail::NeighborArrays<SGraph> neighbor_at(graph);
+    const int64_t batch = 1 << 14;
+    int64_t samples = 0, closed = 0;
+    for (int64_t round = 0;; ++round) {
+        int64_t batch_closed = 0;
+        const int num_threads = omp_get_max_threads();
+#pragma omp parallel reduction(+:batch_closed)
+        {
+            std::mt19937_64 rng(Estimation::mix(budget.seed ^ Estimation::mix(round * num_threads + omp_get_thread_num())));
+            std::uniform_real_distribution<double> position(0., wedges[n]);
+#pragma omp for schedule(static)
+            for (int64_t i = 0; i < batch; ++i) {
+                const NodeId v = std::upper_bound(wedges.begin(), wedges.end(), position(rng)) - wedges.begin() - 1;
+                const int64_t d = graph.out_degree(v);
+                std::uniform_int_distribution<int64_t> neighbor(0, d - 1);
+                int64_t a = neighbor(rng), b = neighbor(rng);
+                while (a == b)
+                    b = neighbor(rng);
+                batch_closed += graph.out_neigh(neighbor_at(v, a)).contains(neighbor_at(v, b));
+            }
+        }
+        samples += batch;
+        closed += batch_closed;
+
+        const double half_width = Estimation::binomial_estimate(closed, samples, budget.confidence, estimate);
+        estimate.seconds = omp_get_wtime() - start;
+        if (closed > 0 && half_width <= budget.relative_error * estimate.value)
+            break;
+        if (budget.seconds > 0 && estimate.seconds >= budget.seconds)
+            break;
+        // there are (almost) no closed wedges, the relative error can't be reached
+        if (samples >= 1024 * batch)
+            break;
+    }
+    return estimate;
+}
+
+/**
+ * Triangle count estimated by wedge sampling, T = transitivity * W / 3.
+ */
+template <class SGraph>
+Estimate wedge_sampling(const SGraph &graph, const Budget &budget = Budget()) {
+    double num_wedges = 0;
+    Estimate estimate = transitivity(graph, budget, &num_wedges);
+    estimate.value *= num_wedges / 3;
+    estimate.lower *= num_wedges / 3;
+    estimate.upper *= num_wedges / 3;
+    return estimate;
+}
+
+}
@@ -0,0 +1,204 @@
+#pragma once
+#include <gms/common/types.h>
+#include <gms/representations/sets/sorted_set.h>
+#include <algorithm>
+#include <vector>
+#include <omp.h>
+#include <unistd.h>
+
+#include "edge_partitioned.h"
+
+namespace GMS::TriangleCount::Par {
+
+namespace Blocked {
+
+// Used if the size of the last level cache can't be queried.
+constexpr int64_t kDefaultLLCBytes = 8 << 20;
+
+// Rows of a tile per work item of count_total_blocked.
+constexpr size_t kRowsPerTask = 256;
+
+/** Size of the last level cache in bytes. */
+inline int64_t llc_bytes() {
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    const long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (l3 > 0)
+        return l3;
+#endif
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    const long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (l2 > 0)
+        return l2;
+#endif
+    return kDefaultLLCBytes;
+}
+
+/**
+ * Cuts the vertex ids into consecutive ranges [boundaries[i], boundaries[i + 1]) such that the edges u -> v (u < v)
+ * into a range take about block_bytes, estimated as the number of these edges times sizeof(NodeId).
+ */
+template <class Graph>
+std::vector<NodeId> block_boundaries(const Graph &graph, int64_t block_bytes) {
+    const int64_t n = graph.num_nodes();
+    pvector<NodeId> lower(n);
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (NodeId v = 0; v < n; ++v) {
+        NodeId count = 0;
+        for (NodeId u : graph.out_neigh(v))
+            count += u < v;
+        lower[v] = count;
+    }
+    const pvector<SGOffset> edges = EdgePartition::prefix_sum(lower);
+    const int64_t edges_per_block = std::max<int64_t>(1, block_bytes / static_cast<int64_t>(sizeof(NodeId)));
+    const int64_t num_blocks = std::max<int64_t>(1, (edges[n] + edges_per_block - 1) / edges_per_block);
+
+    // range i starts at the first vertex whose incoming edges don't all fit into the ranges before it
+    std::vector<NodeId> boundaries(num_blocks + 1);
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 1; i < num_blocks; ++i)
+        boundaries[i] = std::upper_bound(edges.begin(), edges.begin() + n, i * edges_per_block) - edges.begin() - 1;
+    boundaries[0] = 0;
+    boundaries[num_blocks] = n;
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+    return boundaries;
+}
+
+} // namespace Blocked
+
+/**
+ * The upper triangle of the adjacency matrix (the edges u -> v with u < v) cut into 2D tiles: the vertex ids are split
+ * into ranges, and tile (R, C) with R <= C holds, for every vertex u of range R with a neighbour in range C, the set of
+ * these neighbours. The ranges are chosen such that the tiles of one column range take about block_bytes.
+ * Built in parallel, once, before the counting is timed.
+ *
+ * @tparam Set set type of the rows, e.g. SortedSet, RoaringSet or RobinHoodSet
+ */
+template <class Set = SortedSet>
+class BlockedGraph {
+public:
+    struct Tile {
+        std::vector<NodeId> rows; // increasing vertex ids
+        std::vector<Set> sets;    // sets[i] is the row of vertex rows[i]
+
+        bool empty() const { return rows.empty(); }
+    };
+
+    /**
+     * @param block_bytes the size of the tiles of a column range, 0 uses half of the last level cache
+     */
+    template <class Graph>
+    explicit BlockedGraph(const Graph &graph, int64_t block_bytes = 0)
+        : n_(graph.num_nodes()),
+          boundaries_(Blocked::block_boundaries(graph, block_bytes > 0 ? block_bytes : Blocked::llc_bytes() / 2)),
+          tiles_(num_blocks() * (num_blocks() + 1) / 2) {
+        const int64_t k = num_blocks();
+        // every row range is built by one thread, which owns its tiles
+#pragma omp parallel
+        {
+            std::vector<NodeId> upper;
+#pragma omp for schedule(dynamic, 1)
+            for (int64_t r = 0; r < k; ++r) {
+                for (NodeId u = block_begin(r); u < block_end(r); ++u) {
+                    upper.clear();
+                    for (NodeId v : graph.out_neigh(u)) {
+                        if (u < v)
+                            upper.push_back(v);
+                    }
+                    std::sort(upper.begin(), upper.end());
+                    auto begin = upper.begin();
+                    for (int64_t c = r; begin != upper.end(); ++c) {
+                        const auto end = std::lower_bound(begin, upper.end(), block_end(c));
+                        if (begin != end) {
+                            Tile &t = tile(r, c);
+                            t.rows.push_back(u);
+                            t.sets.emplace_back(&*begin, end - begin);
+                        }
+                        begin = end;
+                    }
+                }
+            }
+        }
+    }
+
+    int64_t num_nodes() const { return n_; }
+    int64_t num_blocks() const { return boundaries_.size() - 1; }
+    NodeId block_begin(int64_t block) const { return boundaries_[block]; }
+    NodeId block_end(int64_t block) const { return boundaries_[block + 1]; }
+
+    // Tile of the rows in range r and the columns in range c, r <= c.
+    const Tile &tile(int64_t r, int64_t c) const { return tiles_[index(r, c)]; }
+
+private:
+    int64_t n_;
+    std::vector<NodeId> boundaries_;
+    std::vector<Tile> tiles_; // upper triangle of the tile matrix, row by row
+
+    Tile &tile(int64_t r, int64_t c) { return tiles_[index(r, c)]; }
+
+    size_t index(int64_t r, int64_t c) const {
+        const int64_t k = num_blocks();
+        return r * k - r * (r - 1) / 2 + (c - r);
+    }
+};
+
+/**
+ * Cache blocked triangle counting for graphs whose neighborhoods don't fit into the last level cache. The triangle
+ * u < v < w with u, v and w in the ranges A <= B <= C is counted for the tile triple (A, B, C), as the intersection
+ * of the rows of u and v in the tiles (A, C) and (B, C), for every v in the row of u in tile (A, B). Only the triples
+ * of non-empty tiles are visited. The column ranges C are processed one after the other, all threads working on the
+ * triples of the same column range, so the tiles (B, C) which are randomly accessed stay in the cache.
+ *
+ * The ranges are consecutive ids, so the graph should be relabeled for locality first (e.g. with --relabel).
+ */
+template <class Set>
+size_t count_total_blocked(const BlockedGraph<Set> &tiles) {
+    using Tile = typename BlockedGraph<Set>::Tile;
+    struct Task {
+        int64_t a, b;
+        size_t first, last; // rows of tile (a, b)
+    };
+
+    const int64_t k = tiles.num_blocks();
+    size_t total = 0;
+    std::vector<Task> tasks;
+    for (int64_t c = 0; c < k; ++c) {
+        tasks.clear();
+        for (int64_t a = 0; a <= c; ++a) {
+            if (tiles.tile(a, c).empty())
+                continue;
+            for (int64_t b = a; b <= c; ++b) {
+                const Tile &ab = tiles.tile(a, b);
+                if (ab.empty() || tiles.tile(b, c).empty())
+                    continue;
+                for (size_t first = 0; first < ab.rows.size(); first += Blocked::kRowsPerTask)
+                    tasks.push_back({a, b, first, std::min(first + Blocked::kRowsPerTask, ab.rows.size())});
+            }
+        }
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(+:total)
+        for (size_t t = 0; t < tasks.size(); ++t) {
+            const Task &task = tasks[t];
+            const Tile &ab = tiles.tile(task.a, task.b);
+            const Tile &ac = tiles.tile(task.a, c);
+            const Tile &bc = tiles.tile(task.b, c);
+            // the rows of both ab and ac, merged
+            size_t j = std::lower_bound(ac.rows.begin(), ac.rows.end(), ab.rows[task.first]) - ac.rows.begin();
+            for (size_t i = task.first; i < task.last && j < ac.rows.size(); ++i) {
+                while (j < ac.rows.size() && ac.rows[j] < ab.rows[i])
+                    ++j;
+                if (j == ac.rows.size() || ac.rows[j] != ab.rows[i])
+                    continue;
+                const Set &row_u = ac.sets[j];
+                // not every set type iterates in increasing order, so the row of each v is binary searched
+                for (NodeId v : ab.sets[i]) {
+                    const auto row_v = std::lower_bound(bc.rows.begin(), bc.rows.end(), v);
+                    if (row_v != bc.rows.end() && *row_v == v)
+                        total += row_u.intersect_count(bc.sets[row_v - bc.rows.begin()]);
+                }
+            }
+        }
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <gms/common/types.h>
+#include <cstdio>
+#include <vector>
+#include <omp.h>
+#include "oriented.h"
+
+namespace GMS::TriangleCount::Par {
+
+/** Graph wide results of local_clustering. */
+struct ClusteringSummary {
+    size_t triangles = 0;
+    double wedges = 0.;
+    double average_clustering = 0.;   // mean of the local coefficients, vertices of degree < 2 count as 0
+    double transitivity = 0.;         // 3 * triangles / wedges
+
+    void print() const {
+        std::printf("%-21s%zu\n", "Triangles:", triangles);
+        std::printf("%-21s%.6f\n", "Average Clustering:", average_clustering);
+        std::printf("%-21s%.6f\n", "Transitivity:", transitivity);
+    }
+};
+
+namespace Oriented {
+
+// Calls fn(w) for every w in both sorted ranges.
+template <class Fn>
+void merge_for_each(const NodeId *a, const NodeId *a_end, const NodeId *b, const NodeId *b_end, Fn &&fn) {
+    while (a != a_end && b != b_end) {
+        if (*a < *b) {
+            ++a;
+        } else if (*b < *a) {
+            ++b;
+        } else {
+            fn(*a);
+            ++a;
+            ++b;
+        }
+    }
+}
+
+} // namespace Oriented
+
+/**
+ * Computes the local clustering coefficient 2 t(v) / (d(v) (d(v) - 1)) of every vertex together with the average
+ * clustering and the transitivity in one pass over the oriented triangle enumeration (see count_total_oriented).
+ * Every triangle is found once and credited to its three vertices in a private integer array per thread, like
+ * vertex_count2_edge_partitioned, which needs num_threads * n counters besides the orientation. The counts are
+ * summed up and divided once in the loop that computes the summary.
+ *
+ * @param coefficients resized to the number of vertices, indexed by the vertex ids of graph
+ */
+template <class Graph, class Output = std::vector<double>>
+ClusteringSummary local_clustering(const Graph &graph, Output &coefficients,
+                                   OrientationRank rank = OrientationRank::Degeneracy) {
+    const int64_t n = graph.num_nodes();
+    const std::vector<NodeId> ranking = orientation_ranking(graph, rank);
+    const Oriented::ForwardAdjacency fw(graph, ranking);
+    const int num_threads = omp_get_max_threads();
+    std::vector<std::vector<int64_t>> local(num_threads);  // indexed by rank
+#pragma omp parallel num_threads(num_threads)
+    local[omp_get_thread_num()].assign(n, 0);
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        std::vector<int64_t> &triangles = local[omp_get_thread_num()];
+#pragma omp for schedule(dynamic, 64)
+        for (NodeId u = 0; u < n; ++u) {
+            if (fw.degree(u) < 2)
+                continue;
+            int64_t count_u = 0;
+            for (const NodeId *it = fw.begin(u); it != fw.end(u); ++it) {
+                int64_t count_v = 0;
+                Oriented::merge_for_each(it + 1, fw.end(u), fw.begin(*it), fw.end(*it), [&](NodeId w) {
+                    ++count_v;
+                    ++triangles[w];
+                });
+                count_u += count_v;
+                triangles[*it] += count_v;
+            }
+            triangles[u] += count_u;
+        }
+    }
+
+    coefficients.resize(n);
+    ClusteringSummary summary;
+    int64_t triangles3 = 0;
+    double wedges = 0, sum = 0;
+#pragma omp parallel for schedule(static) reduction(+:triangles3, wedges, sum)
+    for (NodeId v = 0; v < n; ++v) {
+        const double d = graph.out_degree(v);
+        const double pairs = d * (d - 1) / 2;
+        int64_t count = 0;
+        for (int t = 0; t < num_threads; ++t)
+            count += local[t][ranking[v]];
+        triangles3 += count;
+        wedges += pairs;
+        coefficients[v] = pairs > 0 ? count / pairs : 0.;
+        sum += coefficients[v];
+    }
+    summary.triangles = static_cast<size_t>(triangles3 / 3);
+    summary.wedges = wedges;
+    summary.average_clustering = n > 0 ? sum / n : 0.;
+    summary.transitivity = wedges > 0 ? static_cast<double>(triangles3) / wedges : 0.;
+    return summary;
+}
+
+}
@@ -0,0 +1,228 @@
+#pragma once
+#include <gms/common/types.h>
+#include <gms/third_party/gapbs/util.h>
+#include <algorithm>
+#include <cassert>
+#include <cinttypes>
+#include <cstdio>
+#include <vector>
+#include <omp.h>
+
+namespace GMS::TriangleCount::Par {
+
+/**
+ * Work done by every thread of an edge partitioned kernel, see count_total_edge_partitioned.
+ */
+struct WorkStatistics {
+    std::vector<int64_t> edges;   // number of intersections
+    std::vector<int64_t> cost;    // estimated cost of the intersections
+    std::vector<double> seconds;  // time spent in the intersections
+
+    void reset(int num_threads) {
+        edges.assign(num_threads, 0);
+        cost.assign(num_threads, 0);
+        seconds.assign(num_threads, 0.);
+    }
+
+    /** Maximum over mean of the time per thread, 1 means perfect balance. */
+    double imbalance() const {
+        if (seconds.empty())
+            return 1.;
+        double max = *std::max_element(seconds.begin(), seconds.end());
+        double sum = 0;
+        for (double s : seconds)
+            sum += s;
+        return sum > 0 ? max * seconds.size() / sum : 1.;
+    }
+
+    /** Prints the work histogram, one line per thread. */
+    void print() const {
+        for (size_t t = 0; t < seconds.size(); ++t) {
+            std::printf("Thread %-14zu %10" PRId64 " edges %14" PRId64 " cost %9.5f s\n", t, edges[t], cost[t], seconds[t]);
+        }
+        std::printf("%-21s%3.5lf\n", "Work Imbalance:", imbalance());
+    }
+};
+
+namespace EdgePartition {
+
+// Number of chunks per thread, the chunks are scheduled dynamically to even out the errors of the cost estimate.
+constexpr int64_t kChunksPerThread = 8;
+
+/** Exclusive prefix sum of values, with the total as the last of values.size() + 1 entries. */
+template <class T>
+pvector<SGOffset> prefix_sum(const pvector<T> &values) {
+    const int64_t size = values.size();
+    const int num_blocks = omp_get_max_threads();
+    const int64_t block_size = (size + num_blocks - 1) / num_blocks;
+    std::vector<SGOffset> block_sums(num_blocks + 1, 0);
+    pvector<SGOffset> prefix(size + 1);
+#pragma omp parallel for schedule(static, 1)
+    for (int block = 0; block < num_blocks; ++block) {
+        SGOffset sum = 0;
+        for (int64_t i = block * block_size; i < std::min(size, (block + 1) * block_size); ++i)
+            sum += values[i];
+        block_sums[block + 1] = sum;
+    }
+    for (int block = 0; block < num_blocks; ++block)
+        block_sums[block + 1] += block_sums[block];
+#pragma omp parallel for schedule(static, 1)
+    for (int block = 0; block < num_blocks; ++block) {
+        SGOffset sum = block_sums[block];
+        for (int64_t i = block * block_size; i < std::min(size, (block + 1) * block_size); ++i) {
+            prefix[i] = sum;
+            sum += values[i];
+        }
+    }
+    prefix[size] = block_sums[num_blocks];
+    return prefix;
+}
+
+/**
+ * The edges {u, v} with u < v in CSR layout: the edges of u are targets[offsets[u], offsets[u + 1]). cost is the
+ * prefix sum of the estimated intersection cost deg(u) + deg(v) of the edges, so the edge ranges can be cut into
+ * chunks of equal cost, also within the neighborhood of a hub.
+ */
+struct UpperEdges {
+    pvector<SGOffset> offsets;
+    std::vector<NodeId> targets;
+    pvector<SGOffset> cost;
+
+    template <class SGraph>
+    explicit UpperEdges(const SGraph &graph) {
+        const int64_t n = graph.num_nodes();
+        pvector<NodeId> degrees(n);
+#pragma omp parallel for schedule(dynamic, 64)
+        for (NodeId u = 0; u < n; ++u) {
+            NodeId degree = 0;
+            for (NodeId v : graph.out_neigh(u))
+                degree += u < v;
+            degrees[u] = degree;
+        }
+        offsets = prefix_sum(degrees);
+
+        const int64_t m = offsets[n];
+        targets.resize(m);
+        pvector<NodeId> edge_cost(m);
+#pragma omp parallel for schedule(dynamic, 64)
+        for (NodeId u = 0; u < n; ++u) {
+            SGOffset e = offsets[u];
+            const NodeId degree_u = graph.out_degree(u);
+            for (NodeId v : graph.out_neigh(u)) {
+                if (u < v) {
+                    targets[e] = v;
+                    edge_cost[e] = degree_u + graph.out_degree(v);
+                    ++e;
+                }
+            }
+        }
+        cost = prefix_sum(edge_cost);
+    }
+
+    int64_t num_edges() const { return targets.size(); }
+
+    /** First edge of the chunk-th of num_chunks chunks of equal cost. */
+    SGOffset chunk_begin(int64_t chunk, int64_t num_chunks) const {
+        const SGOffset total = cost[num_edges()];
+        const SGOffset target = static_cast<SGOffset>(static_cast<double>(total) * chunk / num_chunks);
+        return std::lower_bound(cost.begin(), cost.end() - 1, target) - cost.begin();
+    }
+};
+
+/**
+ * Calls fn(thread, u, v, |N(u) ∩ N(v)|) for every edge {u, v} with u < v. The edge list is cut into chunks of
+ * equal estimated cost which are scheduled dynamically, the work of every thread is recorded in stats (if given).
+ */
+template <class SGraph, class Fn>
+void for_each_edge_balanced(const SGraph &graph, const UpperEdges &edges, WorkStatistics *stats, Fn &&fn) {
+    const int num_threads = omp_get_max_threads();
+    const int64_t num_chunks = std::max<int64_t>(1, num_threads * kChunksPerThread);
+    if (stats != nullptr)
+        stats->reset(num_threads);
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        const int t = omp_get_thread_num();
+        int64_t edge_count = 0;
+        SGOffset cost = 0;
+        double seconds = 0.;
+#pragma omp for schedule(dynamic, 1)
+        for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+            const SGOffset begin = edges.chunk_begin(chunk, num_chunks);
+            const SGOffset end = edges.chunk_begin(chunk + 1, num_chunks);
+            if (begin == end)
+                continue;
+            double start = omp_get_wtime();
+            NodeId u = std::upper_bound(edges.offsets.begin(), edges.offsets.end(), begin) - edges.offsets.begin() - 1;
+            for (SGOffset e = begin; e < end; ++e) {
+                while (edges.offsets[u + 1] <= e)
+                    ++u;
+                const NodeId v = edges.targets[e];
+                fn(t, u, v, graph.out_neigh(u).intersect_count(graph.out_neigh(v)));
+            }
+            seconds += omp_get_wtime() - start;
+            edge_count += end - begin;
+            cost += edges.cost[end] - edges.cost[begin];
+        }
+        if (stats != nullptr) {
+            stats->edges[t] = edge_count;
+            stats->cost[t] = cost;
+            stats->seconds[t] = seconds;
+        }
+    }
+}
+
+} // namespace EdgePartition
+
+/**
+ * Edge-centric triangle counting for skewed degree distributions. The edges {u, v} with u < v are cut into chunks
+ * of equal estimated intersection cost (a prefix sum over deg(u) + deg(v)), so the edges of a hub are spread over
+ * all threads instead of being processed by the thread which owns the hub.
+ *
+ * @param stats if not null, the work of every thread is recorded there.
+ */
+template <class SGraph>
+size_t count_total_edge_partitioned(const SGraph &graph, WorkStatistics *stats = nullptr) {
+    const EdgePartition::UpperEdges edges(graph);
+    const int num_threads = omp_get_max_threads();
+    std::vector<size_t> totals(num_threads * 8, 0); // padded against false sharing
+    EdgePartition::for_each_edge_balanced(graph, edges, stats, [&](int t, NodeId, NodeId, size_t count) {
+        totals[t * 8] += count;
+    });
+    size_t total = 0;
+    for (int t = 0; t < num_threads; ++t)
+        total += totals[t * 8];
+    assert(total % 3 == 0);
+    return total / 3;
+}
+
+/**
+ * Computes 2 times the number of triangles for each vertex, like vertex_count2_once, on the balanced edge
+ * partition. The counts are accumulated in a private array per thread instead of atomics and summed up in parallel
+ * at the end, which needs num_threads * n counters.
+ */
+template <class SGraph, class Output = std::vector<int64_t>>
+void vertex_count2_edge_partitioned(const SGraph &graph, Output &counts, WorkStatistics *stats = nullptr) {
+    const int64_t n = graph.num_nodes();
+    const EdgePartition::UpperEdges edges(graph);
+    const int num_threads = omp_get_max_threads();
+    std::vector<std::vector<int64_t>> local(num_threads);
+#pragma omp parallel num_threads(num_threads)
+    local[omp_get_thread_num()].assign(n, 0);
+
+    EdgePartition::for_each_edge_balanced(graph, edges, stats, [&](int t, NodeId u, NodeId v, size_t count) {
+        local[t][u] += count;
+        local[t][v] += count;
+    });
+
+    counts.resize(n);
+#pragma omp parallel for schedule(static)
+    for (NodeId u = 0; u < n; ++u) {
+        int64_t count = 0;
+        for (int t = 0; t < num_threads; ++t)
+            count += local[t][u];
+        counts[u] = count;
+    }
+}
+
+}
@@ -0,0 +1,291 @@
+#pragma once
+#include <gms/common/types.h>
+#include <gms/algorithms/preprocessing/parallel/degeneracy_bucketed.h>
+#include <gms/algorithms/preprocessing/parallel/degree.h>
+#include <gms/algorithms/preprocessing/parallel/orient.h>
+#include <gms/representations/graphs/prefetch.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace GMS::TriangleCount::Par {
+
+/** Rank along which the edges are oriented, every edge points to the higher ranked endpoint. */
+enum class OrientationRank {
+    Degree,     // increasing degree, the out-degrees are in O(sqrt(m))
+    Degeneracy  // degeneracy ordering, the out-degrees are at most the degeneracy
+};
+
+/** How the out-neighborhoods N+(u) and N+(v) of an oriented edge u -> v are intersected. */
+enum class Intersection {
+    Auto,       // choose one of the methods below per vertex u with a cost model
+    Merge,      // linear merge of the sorted neighborhoods
+    Galloping,  // exponential search of the elements of the smaller neighborhood in the larger one
+    Bitmap,     // per-thread dense bitmap of N+(u), probed with N+(v)
+    Hash        // per-thread hash set of N+(u), probed with N+(v)
+};
+
+inline std::string to_string(Intersection method) {
+    switch (method) {
+        case Intersection::Merge: return "merge";
+        case Intersection::Galloping: return "galloping";
+        case Intersection::Bitmap: return "bitmap";
+        case Intersection::Hash: return "hash";
+        default: return "auto";
+    }
+}
+
+namespace Oriented {
+
+/**
+ * Sorted out-neighborhoods of the oriented graph in rank space, i.e. vertex u is ranking[u] and all out-neighbors of
+ * a vertex have a higher id. Built in parallel from any CSRGraph or SetGraph.
+ */
+class ForwardAdjacency {
+public:
+    template <class Graph, class Ranking>
+    ForwardAdjacency(const Graph &g, const Ranking &ranking) : n_(g.num_nodes()) {
+        PpParallel::Orientation::filterCSR(g, ranking, true, true, &index_, &neighs_);
+    }
+
+    ForwardAdjacency(const ForwardAdjacency &) = delete;
+    ForwardAdjacency &operator=(const ForwardAdjacency &) = delete;
+
+    ~ForwardAdjacency() {
+        delete[] index_;
+        delete[] neighs_;
+    }
+
+    int64_t num_nodes() const { return n_; }
+    const NodeId *begin(NodeId u) const { return index_[u]; }
+    const NodeId *end(NodeId u) const { return index_[u + 1]; }
+    int64_t degree(NodeId u) const { return index_[u + 1] - index_[u]; }
+
+private:
+    int64_t n_;
+    NodeId **index_ = nullptr;
+    NodeId *neighs_ = nullptr;
+};
+
+inline size_t merge_count(const NodeId *a, const NodeId *a_end, const NodeId *b, const NodeId *b_end) {
+    size_t count = 0;
+    while (a != a_end && b != b_end) {
+        if (*a < *b) {
+            ++a;
+        } else if (*b < *a) {
+            ++b;
+        } else {
+            ++count;
+            ++a;
+            ++b;
+        }
+    }
+    return count;
+}
+
+// Searches every element of [a, a_end) in the larger [b, b_end) with an exponential search from the last match.
+inline size_t galloping_count(const NodeId *a, const NodeId *a_end, const NodeId *b, const NodeId *b_end) {
+    if (a_end - a > b_end - b) {
+        std::swap(a, b);
+        std::swap(a_end, b_end);
+    }
+    size_t count = 0;
+    for (; a != a_end && b != b_end; ++a) {
+        // all elements in front of b are smaller than *a, the first one >= *a is in [lo, lo + step]
+        const NodeId *lo = b;
+        int64_t step = 1;
+        while (lo + step < b_end && lo[step] < *a) {
+            lo += step;
+            step *= 2;
+        }
+        b = std::lower_bound(lo, std::min(lo + step, b_end), *a);
+        if (b != b_end && *b == *a) {
+            ++count;
+            ++b;
+        }
+    }
+    return count;
+}
+
+class Bitmap {
+public:
+    void resize(int64_t n) {
+        if (words_.empty())
+            words_.assign(n / 64 + 1, 0);
+    }
+    void set(NodeId v) { words_[v >> 6] |= uint64_t(1) << (v & 63); }
+    // Clears the whole word of v, only used to clear all bits which were set.
+    void clear(NodeId v) { words_[v >> 6] = 0; }
+    bool test(NodeId v) const { return (words_[v >> 6] >> (v & 63)) & 1; }
+
+private:
+    std::vector<uint64_t> words_;
+};
+
+/** Open addressing hash set with linear probing, reused for every vertex of a thread. */
+class HashSet {
+public:
+    static constexpr NodeId kEmpty = -1;
+
+    void build(const NodeId *begin, const NodeId *end) {
+        int bits = 4;
+        while ((size_t(1) << bits) < 2 * static_cast<size_t>(end - begin))
+            bits++;
+        shift_ = 32 - bits;
+        mask_ = (size_t(1) << bits) - 1;
+        const size_t capacity = mask_ + 1;
+        slots_.assign(capacity, kEmpty);
+        for (const NodeId *it = begin; it != end; ++it) {
+            size_t s = hash(*it);
+            while (slots_[s] != kEmpty)
+                s = (s + 1) & mask_;
+            slots_[s] = *it;
+        }
+    }
+
+    bool contains(NodeId v) const {
+        for (size_t s = hash(v);; s = (s + 1) & mask_) {
+            if (slots_[s] == v)
+                return true;
+            if (slots_[s] == kEmpty)
+                return false;
+        }
+    }
+
+private:
+    // multiplicative hashing, the high bits of the product are the well mixed ones
+    size_t hash(NodeId v) const { return (static_cast<uint32_t>(v) * 2654435761u) >> shift_; }
+
+    std::vector<NodeId> slots_;
+    size_t mask_ = 0;
+    int shift_ = 32;
+};
+
+// Relative costs per element of the cost model, measured against the bitmap probes on Kronecker graphs (scale 17).
+constexpr double kMergeCost = 4.;
+constexpr double kGallopingCost = 6.;      // per search step
+constexpr double kBitmapProbeCost = 1.;    // if the bitmap fits into the cache
+constexpr double kBitmapMissCost = 8.;     // otherwise, about one cache miss per probe
+constexpr double kHashBuildCost = 8.;
+constexpr double kHashProbeCost = 8.;
+constexpr int64_t kBitmapCacheBytes = 1 << 20;
+
+/**
+ * Chooses the cheapest intersection method for all edges u -> v. N+(u) is only intersected with the part behind v,
+ * the bitmap and the hash set are built once and then probed with every N+(v).
+ */
+inline Intersection choose(const ForwardAdjacency &fw, NodeId u, bool bitmap_cached) {
+    const int64_t d = fw.degree(u);
+    double merge = 0, galloping = 0, probes = 0;
+    int64_t i = 0;
+    for (const NodeId *it = fw.begin(u); it != fw.end(u); ++it, ++i) {
+        const double rest = d - i - 1;
+        const double dv = fw.degree(*it);
+        probes += dv;
+        merge += rest + dv;
+        const double small = std::min(rest, dv), large = std::max(rest, dv);
+        galloping += small * (1 + std::log2(1 + large / (small + 1)));
+    }
+    const double costs[] = {
+        kMergeCost * merge,
+        kGallopingCost * galloping,
+        2 * d + (bitmap_cached ? kBitmapProbeCost : kBitmapMissCost) * probes,
+        kHashBuildCost * d + kHashProbeCost * probes
+    };
+    const Intersection methods[] = {Intersection::Merge, Intersection::Galloping, Intersection::Bitmap,
+                                    Intersection::Hash};
+    return methods[std::min_element(std::begin(costs), std::end(costs)) - std::begin(costs)];
+}
+
+/** Number of triangles u < v < w with v, w in N+(u), using the given method. */
+inline size_t count_vertex(const ForwardAdjacency &fw, NodeId u, Intersection method, Bitmap &bitmap,
+                           HashSet &hash) {
+    const NodeId *begin = fw.begin(u), *end = fw.end(u);
+    size_t count = 0;
+    switch (method) {
+        case Intersection::Merge:
+        case Intersection::Galloping: {
+            auto intersect = method == Intersection::Merge ? merge_count : galloping_count;
+            for (const NodeId *it = begin; it != end; ++it) {
+                count += intersect(it + 1, end, fw.begin(*it), fw.end(*it));
+            }
+            break;
+        }
+        case Intersection::Bitmap: {
+            bitmap.resize(fw.num_nodes());
+            for (const NodeId *it = begin; it != end; ++it)
+                bitmap.set(*it);
+            for (const NodeId *it = begin; it != end; ++it) {
+                for (const NodeId *w = fw.begin(*it); w != fw.end(*it); ++w)
+                    count += bitmap.test(*w);
+            }
+            for (const NodeId *it = begin; it != end; ++it)
+                bitmap.clear(*it);
+            break;
+        }
+        default: {
+            hash.build(begin, end);
+            for (const NodeId *it = begin; it != end; ++it) {
+                for (const NodeId *w = fw.begin(*it); w != fw.end(*it); ++w)
+                    count += hash.contains(*w);
+            }
+            break;
+        }
+    }
+    return count;
+}
+
+} // namespace Oriented
+
+/**
+ * Computes the ranking of the vertices (in rank format) along which count_total_oriented orients the edges.
+ */
+template <class Graph>
+std::vector<NodeId> orientation_ranking(const Graph &graph, OrientationRank rank) {
+    std::vector<NodeId> ranking;
+    if (rank == OrientationRank::Degree)
+        PpParallel::getDegreeOrdering<Graph, true>(graph, ranking);
+    else
+        PpParallel::getDegeneracyOrderingBucketed<Graph, true>(graph, ranking);
+    return ranking;
+}
+
+/**
+ * Forward triangle counting: every edge is oriented towards the higher ranked endpoint, so every triangle is found
+ * exactly once, from its lowest ranked vertex u, as w in N+(u) ∩ N+(v) for v in N+(u). Compared to count_total, the
+ * intersections are over the (much smaller) out-neighborhoods and the result isn't divided by 3.
+ *
+ * Works for CSRGraph and all SetGraph types, the oriented graph is built as sorted arrays in rank space.
+ *
+ * @param method the intersection method, Intersection::Auto chooses one per vertex with a cost model
+ * @param prefetch_distance the out-neighborhood of the vertex this many positions ahead is prefetched
+ */
+template <class Graph>
+size_t count_total_oriented(const Graph &graph, OrientationRank rank = OrientationRank::Degeneracy,
+                            Intersection method = Intersection::Auto,
+                            int64_t prefetch_distance = Prefetch::kDefaultDistance) {
+    const Oriented::ForwardAdjacency fw(graph, orientation_ranking(graph, rank));
+    const int64_t n = fw.num_nodes();
+    const bool bitmap_cached = n / 8 <= Oriented::kBitmapCacheBytes;
+
+    size_t total = 0;
+#pragma omp parallel reduction(+:total)
+    {
+        Oriented::Bitmap bitmap;
+        Oriented::HashSet hash;
+#pragma omp for schedule(dynamic, 64)
+        for (NodeId u = 0; u < n; ++u) {
+            if (prefetch_distance > 0 && u + prefetch_distance < n) {
+                Prefetch::prefetch_address(fw.begin(u + prefetch_distance));
+            }
+            if (fw.degree(u) < 2)
+                continue;
+            Intersection m = method == Intersection::Auto ? Oriented::choose(fw, u, bitmap_cached) : method;
+            total += Oriented::count_vertex(fw, u, m, bitmap, hash);
+        }
+    }
+    return total;
+}
+
+}
@@ -1,18 +1,22 @@
 #pragma once
 #include <gms/common/types.h>
+#include <gms/representations/graphs/prefetch.h>
 #include <cassert>
 
 namespace GMS::TriangleCount::Par {
 
+/**
+ * @param prefetch_distance the set of the neighbor this many positions ahead in neigh_u is prefetched
+ */
 template<class SGraph>
-size_t count_total(const SGraph &graph) {
+size_t count_total(const SGraph &graph, int64_t prefetch_distance = Prefetch::kDefaultDistance) {
     size_t n = graph.num_nodes();
 
     size_t total = 0;
 #pragma omp parallel for schedule(static, 17) reduction(+:total)
     for (NodeId u = 0; u < n; ++u) {
         const auto &neigh_u = graph.out_neigh(u);
-        for (NodeId v : neigh_u) {
+        for (NodeId v : prefetch_range(graph, neigh_u, prefetch_distance)) {
             if (u < v) {
                 total += neigh_u.intersect_count(graph.out_neigh(v));
             }
@@ -23,4 +27,4 @@ size_t count_total(const SGraph &graph) {
     return total / 3;
 }
 
-}
\ No newline at end of file
+}
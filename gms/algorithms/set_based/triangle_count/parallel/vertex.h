@@ -1,5 +1,6 @@
 #pragma once
 #include <gms/common/types.h>
+#include <gms/representations/graphs/prefetch.h>
 
 namespace GMS::TriangleCount::Par {
 
@@ -10,16 +11,17 @@ namespace GMS::TriangleCount::Par {
  * @tparam Output
  * @param graph
  * @param counts
+ * @param prefetch_distance the set of the neighbor this many positions ahead in neigh_u is prefetched
  */
 template<class SGraph, class Output = std::vector<int64_t>>
-void vertex_count2(const SGraph &graph, Output &counts) {
+void vertex_count2(const SGraph &graph, Output &counts, int64_t prefetch_distance = Prefetch::kDefaultDistance) {
     int64_t num_nodes = graph.num_nodes();
     counts.resize(num_nodes);
 #pragma omp parallel for schedule(static, 9)
     for (NodeId u = 0; u < num_nodes; ++u) {
         int64_t count = 0;
         const auto &neigh_u = graph.out_neigh(u);
-        for (NodeId v : neigh_u) {
+        for (NodeId v : prefetch_range(graph, neigh_u, prefetch_distance)) {
             count += neigh_u.intersect_count(graph.out_neigh(v));
         }
         counts[u] = count;
@@ -28,14 +30,15 @@ void vertex_count2(const SGraph &graph, Output &counts) {
 
 // This version only computes intersections once but still counts 2 times
 template<class SGraph, class Output = std::vector<int64_t>>
-void vertex_count2_once(const SGraph &graph, Output &counts) {
+void vertex_count2_once(const SGraph &graph, Output &counts,
+                        int64_t prefetch_distance = Prefetch::kDefaultDistance) {
     int64_t num_nodes = graph.num_nodes();
     counts.resize(num_nodes);
 #pragma omp parallel for schedule(dynamic, 9)
     for (NodeId u = 0; u < num_nodes; ++u) {
         int64_t count = 0;
         const auto &neigh_u = graph.out_neigh(u);
-        for (NodeId v : neigh_u) {
+        for (NodeId v : prefetch_range(graph, neigh_u, prefetch_distance)) {
             if (u < v) {
                 int64_t c = neigh_u.intersect_count(graph.out_neigh(v));
                 count += c;
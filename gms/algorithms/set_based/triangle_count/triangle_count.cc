@@ -1,8 +1,11 @@
 #include "gms/third_party/gapbs/benchmark.h"
 
 #include <gms/common/cli/cli.h>
+#include <gms/algorithms/preprocessing/parallel/relabel.h>
 #include <gms/representations/graphs/set_graph.h>
+#include <gms/representations/graphs/prefetch.h>
 #include <gms/common/benchmark.h>
+#include <gms/common/papi/papiw.h>
 
 #include "triangle_count.h"
 #include "verifier.h"
@@ -19,30 +22,187 @@ constexpr auto output_wrap(Fn fn) {
     };
 }
 
+// Measures the last level cache accesses and misses of fn with PAPIW (a no-op if built without PAPI). The counters of
+// the last trial are printed with PAPIW::PRINT after the benchmark, outside of the timed kernel.
+template <class Fn>
+auto with_llc_counters(Fn fn) {
+    return [fn{std::move(fn)}](const auto &g) {
+        PAPIW::INIT_PARALLEL(PAPI_L3_TCA, PAPI_L3_TCM);
+        PAPIW::START();
+        auto result = fn(g);
+        PAPIW::STOP();
+        return result;
+    };
+}
+
+// Forward triangle counting with every intersection method, oriented by degree and by degeneracy. It only runs on
+// the CSRGraph, since the oriented adjacency is the same flat array for every input representation.
+template <class Label>
+void benchmark_oriented(CLI::Args &args, const CSRGraph &g, Label &&label, int64_t prefetch_distance)
+{
+    const std::pair<Par::OrientationRank, std::string> ranks[] = {
+        {Par::OrientationRank::Degree, "degree"}, {Par::OrientationRank::Degeneracy, "degeneracy"}};
+    const Par::Intersection methods[] = {Par::Intersection::Auto, Par::Intersection::Merge,
+                                         Par::Intersection::Galloping, Par::Intersection::Bitmap,
+                                         Par::Intersection::Hash};
+    for (const auto &[rank, rank_name] : ranks) {
+        for (Par::Intersection method : methods) {
+            auto total_oriented = [rank = rank, method, prefetch_distance](const CSRGraph &g) {
+                return Par::count_total_oriented(g, rank, method, prefetch_distance);
+            };
+            std::string name = "total-oriented-" + rank_name + "-" + Par::to_string(method);
+            BenchmarkKernel(args, g, total_oriented, Verify::total_count, label(name));
+        }
+    }
+}
+
+struct ApproxSettings {
+    Approx::Budget budget;
+    double doulion_p;
+    int64_t colors;
+};
+
+// Sampling based estimates, they pass the verification if they are within 3 times the error target.
+template <class SGraph, class Label>
+void benchmark_approximate(CLI::Args &args, const CSRGraph &g, Label &&label, const ApproxSettings &settings)
+{
+    auto verify = [&settings](const CSRGraph &g, const Approx::Estimate &estimate) {
+        return Verify::approximate_total_count(g, estimate, 3 * settings.budget.relative_error);
+    };
+    auto doulion = [&settings](const SGraph &g) {
+        return Approx::doulion(g, settings.doulion_p, settings.budget);
+    };
+    auto color_sampling = [&settings](const SGraph &g) {
+        return Approx::color_sampling(g, settings.colors, settings.budget);
+    };
+    auto wedge_sampling = [&settings](const SGraph &g) {
+        return Approx::wedge_sampling(g, settings.budget);
+    };
+    BenchmarkKernelBk<SGraph>(args, g, doulion, verify, label("total-approx-doulion"));
+    BenchmarkKernelBk<SGraph>(args, g, color_sampling, verify, label("total-approx-color"));
+    BenchmarkKernelBk<SGraph>(args, g, wedge_sampling, verify, label("total-approx-wedge"));
+}
+
+template <class Graph>
+std::pair<Par::ClusteringSummary, std::vector<double>> local_clustering(const Graph &g) {
+    std::vector<double> coefficients;
+    Par::ClusteringSummary summary = Par::local_clustering(g, coefficients);
+    return {summary, std::move(coefficients)};
+}
+
+bool verify_edge_partitioned_total(const CSRGraph &g, const std::pair<size_t, Par::WorkStatistics> &result) {
+    result.second.print();
+    return Verify::total_count(g, result.first);
+}
+
+bool verify_edge_partitioned_vertex(const CSRGraph &g, const std::pair<std::vector<int64_t>, Par::WorkStatistics> &result) {
+    result.second.print();
+    return Verify::vertex_count<2>(g, result.first);
+}
+
+bool verify_clustering(const CSRGraph &g, const std::pair<Par::ClusteringSummary, std::vector<double>> &result) {
+    return Verify::clustering(g, result.first, result.second);
+}
+
+// Cache blocked counting on tiles of the set type of SGraph, with the last level cache counters of the unblocked
+// count_total on the same set type for comparison.
+template <class SGraph, class Label>
+void benchmark_blocked(CLI::Args &args, const CSRGraph &g, Label &&label, int64_t block_bytes, int64_t prefetch_distance)
+{
+    auto total_par = [prefetch_distance](const SGraph &g) {
+        return Par::count_total(g, prefetch_distance);
+    };
+    BenchmarkKernelBk<SGraph>(args, g, with_llc_counters(total_par), Verify::total_count, label("total-unblocked-par"));
+    PAPIW::PRINT();
+
+    // the tiles are built once, outside of the timed kernel
+    const Par::BlockedGraph<typename SGraph::Set> tiles(g, block_bytes);
+    PrintLabel("Column Ranges", std::to_string(tiles.num_blocks()));
+    auto total_blocked = [&tiles](const CSRGraph &) {
+        return Par::count_total_blocked(tiles);
+    };
+    BenchmarkKernel(args, g, with_llc_counters(total_blocked), Verify::total_count, label("total-blocked-par"));
+    PAPIW::PRINT();
+}
+
 template <class SGraph>
-void benchmark_suite(CLI::Args &args, const CSRGraph &g, std::string graphName)
+void benchmark_suite(CLI::Args &args, const CSRGraph &g, std::string graphName, int64_t prefetch_distance,
+                     int64_t block_bytes, const ApproxSettings &approx)
 {
     auto label = [&](std::string name) {
         return "tc-" + name + "-" + graphName;
     };
+    if (prefetch_distance == Prefetch::kAutoDistance) {
+        prefetch_distance = Prefetch::calibrate_distance(SGraph::FromCGraph(g));
+    }
+    PrintLabel("Prefetch Distance", std::to_string(prefetch_distance));
+
+    auto total_par = [prefetch_distance](const SGraph &g) {
+        return Par::count_total(g, prefetch_distance);
+    };
+    auto vertex_count2_par = [prefetch_distance](const SGraph &g, std::vector<int64_t> &counts) {
+        Par::vertex_count2(g, counts, prefetch_distance);
+    };
+    auto vertex_count2_once_par = [prefetch_distance](const SGraph &g, std::vector<int64_t> &counts) {
+        Par::vertex_count2_once(g, counts, prefetch_distance);
+    };
+    // the work histogram is printed by the verifiers, outside of the timed kernel
+    auto total_edge_partitioned = [](const SGraph &g) {
+        Par::WorkStatistics stats;
+        size_t total = Par::count_total_edge_partitioned(g, &stats);
+        return std::make_pair(total, std::move(stats));
+    };
+    auto vertex_count2_edge_partitioned = [](const SGraph &g) {
+        Par::WorkStatistics stats;
+        std::vector<int64_t> counts;
+        Par::vertex_count2_edge_partitioned(g, counts, &stats);
+        return std::make_pair(std::move(counts), std::move(stats));
+    };
 
     // Total count
     BenchmarkKernelBk<SGraph>(args, g, Seq::count_total<SGraph>, Verify::total_count, label("total-seq"));
-    BenchmarkKernelBk<SGraph>(args, g, Par::count_total<SGraph>, Verify::total_count, label("total-par"));
+    BenchmarkKernelBk<SGraph>(args, g, total_par, Verify::total_count, label("total-par"));
+    BenchmarkKernelBk<SGraph>(args, g, total_edge_partitioned, verify_edge_partitioned_total, label("total-edge-partitioned-par"));
+    benchmark_approximate<SGraph>(args, g, label, approx);
+    benchmark_blocked<SGraph>(args, g, label, block_bytes, prefetch_distance);
+
+    // Clustering coefficients
+    BenchmarkKernelBk<SGraph>(args, g, local_clustering<SGraph>, verify_clustering, label("local-clustering-par"));
 
     // Vertex count
     BenchmarkKernelBk<SGraph>(args, g, output_wrap<SGraph>(Seq::vertex_count2<SGraph>), Verify::vertex_count<2>, label("vertex-count2-seq"));
-    BenchmarkKernelBk<SGraph>(args, g, output_wrap<SGraph>(Par::vertex_count2<SGraph>), Verify::vertex_count<2>, label("vertex-count2-par"));
-    BenchmarkKernelBk<SGraph>(args, g, output_wrap<SGraph>(Par::vertex_count2_once<SGraph>), Verify::vertex_count<2>, label("vertex-count2-once-par"));
+    BenchmarkKernelBk<SGraph>(args, g, output_wrap<SGraph>(vertex_count2_par), Verify::vertex_count<2>, label("vertex-count2-par"));
+    BenchmarkKernelBk<SGraph>(args, g, output_wrap<SGraph>(vertex_count2_once_par), Verify::vertex_count<2>, label("vertex-count2-once-par"));
+    BenchmarkKernelBk<SGraph>(args, g, vertex_count2_edge_partitioned, verify_edge_partitioned_vertex, label("vertex-count2-edge-partitioned-par"));
 }
 
 int main(int argc, char *argv[])
 {
-    auto [args, g] = CLI::Parser().parse_and_load(argc, argv);
+    CLI::Parser parser;
+    parser.set_relabeler(PpParallel::relabelByOrdering, PpParallel::Relabel::availableOrderings());
+    auto param_prefetch = parser.add_param("prefetch", std::nullopt, "0", "prefetch distance of the parallel kernels (0: off, -1: calibrate per graph type)");
+    auto param_block_bytes = parser.add_param("block-bytes", std::nullopt, "0", "tile bytes per column range of the cache blocked kernel (0: half of the LLC)");
+    auto param_approx_error = parser.add_param("approx-error", std::nullopt, "0.05", "relative error target of the approximate counts");
+    auto param_approx_confidence = parser.add_param("approx-confidence", std::nullopt, "0.95", "confidence level of the error target");
+    auto param_approx_time = parser.add_param("approx-time", std::nullopt, "0", "time budget in seconds of the approximate counts (0: no limit)");
+    auto param_approx_p = parser.add_param("approx-p", std::nullopt, "0.5", "edge sampling probability of DOULION");
+    auto param_approx_colors = parser.add_param("approx-colors", std::nullopt, "4", "number of colors of the color based sampling");
+    auto [args, g] = parser.parse_and_load(argc, argv);
+    int64_t prefetch_distance = param_prefetch.to_int();
+    int64_t block_bytes = param_block_bytes.to_int();
+    ApproxSettings approx;
+    approx.budget.relative_error = param_approx_error.to_double();
+    approx.budget.confidence = param_approx_confidence.to_double();
+    approx.budget.seconds = param_approx_time.to_double();
+    approx.doulion_p = param_approx_p.to_double();
+    approx.colors = param_approx_colors.to_int();
 
-    benchmark_suite<RoaringGraph>(args, g, "RoaringGraph");
-    benchmark_suite<SortedSetGraph>(args, g, "SortedSetGraph");
-    benchmark_suite<RobinHoodGraph>(args, g, "RobinHoodGraph");
+    benchmark_suite<RoaringGraph>(args, g, "RoaringGraph", prefetch_distance, block_bytes, approx);
+    benchmark_suite<SortedSetGraph>(args, g, "SortedSetGraph", prefetch_distance, block_bytes, approx);
+    benchmark_suite<RobinHoodGraph>(args, g, "RobinHoodGraph", prefetch_distance, block_bytes, approx);
+    benchmark_oriented(args, g, [](std::string name) { return "tc-" + name + "-CSRGraph"; },
+                       Prefetch::resolve_distance(g, prefetch_distance));
+    BenchmarkKernel(args, g, local_clustering<CSRGraph>, verify_clustering, "tc-local-clustering-par-CSRGraph");
 
     return 0;
 }
@@ -3,4 +3,9 @@
 #include "sequential/total.h"
 #include "sequential/vertex.h"
 #include "parallel/total.h"
+#include "parallel/approximate.h"
+#include "parallel/blocked.h"
+#include "parallel/edge_partitioned.h"
+#include "parallel/oriented.h"
+#include "parallel/clustering.h"
 #include "parallel/vertex.h"
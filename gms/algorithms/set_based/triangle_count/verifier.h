@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cmath>
 #include <vector>
 #include <iostream>
 #include <gms/third_party/gapbs/benchmark.h>
 #include <gms/representations/graphs/set_graph.h>
+#include "parallel/approximate.h"
+#include "parallel/clustering.h"
 
 namespace GMS::TriangleCount::Verify {
 
@@ -41,6 +44,20 @@ bool total_count(const CSRGraph &g, size_t test_total) {
     return total == test_total;
 }
 
+/**
+ * Verification of an approximate count: passes if the estimate is within max_relative_error of the exact count.
+ */
+bool approximate_total_count(const CSRGraph &g, const Approx::Estimate &estimate, double max_relative_error) {
+    const double total = compute_total_count(g);
+    const double error = total > 0 ? std::abs(estimate.value - total) / total : estimate.value;
+    estimate.print();
+    std::printf("%-21s%.1f\n", "Exact:", total);
+    std::printf("%-21s%.4f\n", "Relative Error:", error);
+    if (estimate.lower > total || estimate.upper < total)
+        std::cout << "exact count outside of the confidence interval" << std::endl;
+    return error <= max_relative_error;
+}
+
 template <int DivideBy = 1, class Output = std::vector<int64_t>>
 bool vertex_count(const CSRGraph &graph, const Output &test_counts) {
     int64_t num_nodes = graph.num_nodes();
@@ -83,4 +100,46 @@ bool vertex_count(const CSRGraph &graph, const Output &test_counts) {
     int64_t total_true = compute_total_count(graph);
     return total_true * 3 == total_test;
 }
-}
\ No newline at end of file
+
+/**
+ * Verification of the local clustering coefficients and the summary of local_clustering against the per vertex
+ * counts of a simple serial implementation.
+ */
+template <class Output = std::vector<double>>
+bool clustering(const CSRGraph &graph, const Par::ClusteringSummary &summary, const Output &coefficients) {
+    const int64_t num_nodes = graph.num_nodes();
+    const RoaringGraph rgraph = RoaringGraph::FromCGraph(graph);
+    double sum = 0, wedges = 0, triangles3 = 0;
+    for (NodeId u = 0; u < num_nodes; ++u) {
+        int64_t count = 0;
+        const auto &neigh_u = rgraph.out_neigh(u);
+        for (NodeId v : neigh_u) {
+            count += neigh_u.intersect_count(rgraph.out_neigh(v));
+        }
+        count /= 2;
+        const double d = graph.out_degree(u);
+        const double pairs = d * (d - 1) / 2;
+        const double expected = pairs > 0 ? count / pairs : 0.;
+        if (std::abs(coefficients[u] - expected) > 1e-9) {
+            std::cerr << "clustering coefficient of node u " << u << ", expected = " << expected
+                      << ", actual = " << coefficients[u] << std::endl;
+            return false;
+        }
+        sum += expected;
+        wedges += pairs;
+        triangles3 += count;
+    }
+
+    const size_t total = compute_total_count(graph);
+    const double average = num_nodes > 0 ? sum / num_nodes : 0.;
+    const double transitivity = wedges > 0 ? triangles3 / wedges : 0.;
+    summary.print();
+    if (summary.triangles != total || std::abs(summary.average_clustering - average) > 1e-9 ||
+        std::abs(summary.transitivity - transitivity) > 1e-9) {
+        std::cout << "expected " << total << " triangles, average clustering " << average << ", transitivity "
+                  << transitivity << std::endl;
+        return false;
+    }
+    return true;
+}
+}
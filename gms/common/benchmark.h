@@ -1,10 +1,13 @@
 #pragma once
 
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <gms/third_party/gapbs/util.h>
 #include <gms/third_party/gapbs/timer.h>
 
 #include "cli/args.h"
+#include "ordering_cache.h"
 
 // This file contains various versions of BenchmarkKernel functions, inspired by the original GAPBS BenchmarkKernel
 // function, which has been renamed to BenchmarkKernelLegacy (in `third_party/gapbs/benchmark.h`), but with several
@@ -15,6 +18,14 @@
 
 namespace GMS {
 
+/** Whether a preprocessing function reports the runtime parameters bound to it (e.g. preprocessing_bind). */
+template <class PPFunc, class = void>
+struct has_bound_parameters : std::false_type {};
+
+template <class PPFunc>
+struct has_bound_parameters<PPFunc, std::void_t<decltype(std::string(std::declval<const PPFunc&>().parameters()))>>
+        : std::true_type {};
+
 // Calls (and times) GAPBSF according to command line arguments
 template <typename GraphT_, typename GAPBSFunc,
         typename VerifierFunc, class... print_T>
@@ -138,10 +149,13 @@ void BenchmarkKernelBk(const CLI::Args &args, const GraphT_ &g,
 
 //Added by Zur 11.02.2020,
 // allows to choose set-based kernel as well as preprocessing function.
+// The ordering computed by preprocess is kept in the ordering cache under its name `ordering` (e.g. "degeneracy") and
+// the parameters bound to preprocess, see OrderingCache::CachedOrdering.
 template <typename GraphExec, typename GraphT_, typename GAPBSFunc, typename PPFunc,
         typename VerifierFunc, class... print_T>
 void BenchmarkKernelBkPP(const CLI::Args &args, const GraphT_ &g,
                          PPFunc preprocess,
+                         const std::string &ordering,
                          GAPBSFunc GAPBSF,
                          VerifierFunc verify,
                          print_T... printInfo)
@@ -151,6 +165,9 @@ void BenchmarkKernelBkPP(const CLI::Args &args, const GraphT_ &g,
     double total_seconds = 0;
     double pp_total_seconds = 0;
     double vv_total_seconds = 0;
+    // loaded orderings don't measure the preprocessing, their time is averaged separately
+    double pp_load_seconds = 0;
+    int pp_loads = 0;
     Timer trial_timer;
 
     //Building Roaring Graph
@@ -159,15 +176,26 @@ void BenchmarkKernelBkPP(const CLI::Args &args, const GraphT_ &g,
     trial_timer.Stop();
     PrintTime("GraphExec buildTime", trial_timer.Seconds());
 
+    std::string parameters;
+    if constexpr (has_bound_parameters<PPFunc>::value)
+        parameters = preprocess.parameters();
+    OrderingCache::CachedOrdering cache(args.ordering_cache_mode(), args.ordering_cache, g, ordering, parameters);
+
     for (int iter = 0; iter < args.num_trials; iter++) {
         // do preprocessing
-        trial_timer.Start();
         pvector<NodeId> order(rgraph.num_nodes());
-        preprocess(rgraph, order);
-        trial_timer.Stop();
-        PrintTime("Preprocess Time", trial_timer.Seconds());
-        const double preprocTime = trial_timer.Seconds();
-        pp_total_seconds += trial_timer.Seconds();
+        cache.get(order, [&](pvector<NodeId> &ranks) { preprocess(rgraph, ranks); });
+        const double preprocTime = cache.seconds();
+        PrintTime("Preprocess Time", preprocTime);
+        if (cache.loaded()) {
+            pp_load_seconds += preprocTime;
+            pp_loads++;
+        } else {
+            pp_total_seconds += preprocTime;
+        }
+        const std::string ppSource = cache.source();
+        if (cache.enabled())
+            PrintLabel("Preprocess Source", ppSource);
 
         trial_timer.Start();
         auto result = GAPBSF(rgraph, order);
@@ -185,12 +213,21 @@ void BenchmarkKernelBkPP(const CLI::Args &args, const GraphT_ &g,
             const double verifyTime = trial_timer.Seconds();
             vv_total_seconds += trial_timer.Seconds();
 
-            PrintBenchmarkOutput("@@@", trialTime, verifyMark, verifyTime, preprocTime, printInfo...);
+            if (cache.enabled())
+                PrintBenchmarkOutput("@@@", trialTime, verifyMark, verifyTime, preprocTime, ppSource, printInfo...);
+            else
+                PrintBenchmarkOutput("@@@", trialTime, verifyMark, verifyTime, preprocTime, printInfo...);
         } else {
-            PrintBenchmarkOutput("@@@", trialTime, preprocTime, printInfo...);
+            if (cache.enabled())
+                PrintBenchmarkOutput("@@@", trialTime, preprocTime, ppSource, printInfo...);
+            else
+                PrintBenchmarkOutput("@@@", trialTime, preprocTime, printInfo...);
         }
     }
-    PrintTime("Average pp Time", pp_total_seconds / args.num_trials);
+    if (pp_loads < args.num_trials)
+        PrintTime("Average pp Time", pp_total_seconds / (args.num_trials - pp_loads));
+    if (pp_loads > 0)
+        PrintTime("Average pp Load Time", pp_load_seconds / pp_loads);
     PrintTime("Average Time", total_seconds / args.num_trials);
     PrintTime("Average Verification Time", vv_total_seconds / args.num_trials);
 }
@@ -2,6 +2,7 @@
 
 #include "parameter.h"
 #include "../format.h"
+#include "../ordering_cache.h"
 #include <gms/third_party/gapbs/benchmark.h>
 #include <cassert>
 
@@ -23,6 +24,8 @@ namespace GMS::CLI {
             verify = false;
             num_trials = 3;
             threads = 0;
+            ordering_cache_refresh = false;
+            relabel = "auto";
             error = 0;
         }
 
@@ -37,8 +40,37 @@ namespace GMS::CLI {
         int64_t num_trials;
         int64_t threads;
         GraphSpec graph_spec;
+        // directory of the persistent ordering store, empty if disabled (see ordering_cache.h)
+        std::string ordering_cache;
+        bool ordering_cache_refresh;
+        // ordering used to relabel the input graph, see Parser::parse_and_load
+        std::string relabel;
+        // original_ids[v] = id of vertex v in the input graph, empty if the graph wasn't relabeled
+        std::vector<NodeId> original_ids;
         int error;
 
+        NodeId original_id(NodeId v) const {
+            return original_ids.empty() ? v : original_ids[v];
+        }
+
+        // Reorders per vertex values of the (relabeled) graph such that they are indexed by the original ids.
+        template <class Values>
+        Values to_original_ids(const Values &values) const {
+            if (original_ids.empty())
+                return Values(values.begin(), values.end());
+            Values result(values.size());
+            #pragma omp parallel for
+            for (size_t v = 0; v < values.size(); v++)
+                result[original_ids[v]] = values[v];
+            return result;
+        }
+
+        OrderingCache::Mode ordering_cache_mode() const {
+            if (ordering_cache.empty())
+                return OrderingCache::Mode::Off;
+            return ordering_cache_refresh ? OrderingCache::Mode::Refresh : OrderingCache::Mode::Reuse;
+        }
+
         void print() const {
             std::string msg_num_threads = (threads == 0) ? "Use OpenMP default" : std::to_string(threads);
 
@@ -48,6 +80,9 @@ namespace GMS::CLI {
                 << "    Verify: " << (verify ? "true" : "false") << "\n"
                 << "    Num trials: " << num_trials << "\n"
                 << "    Num threads: " << msg_num_threads << "\n"
+                << "    Relabel: " << relabel << "\n"
+                << "    Ordering cache: " << OrderingCache::to_string(ordering_cache_mode())
+                << (ordering_cache.empty() ? "" : " (" + ordering_cache + ")") << "\n"
                 << "  Input:" << "\n"
                 << "    Source: " << (graph_spec.is_generator ? "Generator" : "File") << "\n"
                 << "    Name: " << graph_spec.name << std::endl;
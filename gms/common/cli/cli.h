@@ -4,6 +4,10 @@
 #include <gms/third_party/clipp.h>
 #include "gms/common/format.h"
 
+#include <algorithm>
+#include <functional>
+#include <optional>
+
 #include "parameter.h"
 #include "args.h"
 #include "compat.h"
@@ -15,10 +19,46 @@ namespace GMS::CLI
     using clipp::value;
 
     class Parser {
+    public:
+        /**
+         * Relabels the graph by the named ordering, std::nullopt if the ordering is unknown. original_ids[v] is set
+         * to the id in g of vertex v of the relabeled graph.
+         */
+        using Relabeler = std::function<std::optional<CSRGraph>(CSRGraph &g, const std::string &ordering,
+                                                                std::vector<NodeId> &original_ids)>;
+
     private:
         std::vector<ParamSpec> param_specs;
         clipp::group custom_params;
         bool allow_directed_ = false;
+        Relabeler relabeler_ = relabel_by_degree;
+        std::string relabel_orderings_ = "degree";
+
+        // Decreasing degree (hubs first), the only ordering without a relabeler installed by set_relabeler.
+        static std::optional<CSRGraph> relabel_by_degree(CSRGraph &g, const std::string &ordering,
+                                                         std::vector<NodeId> &original_ids) {
+            if (ordering != "degree")
+                return std::nullopt;
+            using DegreeNode = std::pair<int64_t, NodeId>;
+            const NodeId n = g.num_nodes();
+            std::vector<DegreeNode> pairs(n);
+            #pragma omp parallel for
+            for (NodeId v = 0; v < n; v++)
+                pairs[v] = {g.out_degree(v), v};
+            std::sort(pairs.begin(), pairs.end(), std::greater<DegreeNode>());
+            pvector<NodeId> new_ids(n);
+            original_ids.resize(n);
+            #pragma omp parallel for
+            for (NodeId i = 0; i < n; i++) {
+                new_ids[pairs[i].second] = i;
+                original_ids[i] = pairs[i].second;
+            }
+            return Builder::RelabelByRanking(g, new_ids);
+        }
+
+        std::string relabel_choices() const {
+            return "auto, none, " + relabel_orderings_;
+        }
 
     public:
         /**
@@ -33,6 +73,19 @@ namespace GMS::CLI
             allow_directed_ = allow;
         }
 
+        /**
+         * @brief Orderings for --relabel, replacing the built-in degree relabeling.
+         *
+         * The orderings are implemented outside of gms/common, e.g. PpParallel::relabelByOrdering.
+         *
+         * @param relabeler Relabels the graph by the named ordering.
+         * @param orderings Names of all orderings of relabeler, for the help text.
+         */
+        void set_relabeler(Relabeler relabeler, const std::string &orderings) {
+            relabeler_ = std::move(relabeler);
+            relabel_orderings_ = orderings;
+        }
+
         /**
          * Define a benchmark specific parameter.
          *
@@ -83,7 +136,13 @@ namespace GMS::CLI
             auto cli = (
                 option("-v", "--verify").set(args.verify).doc("perform a basic verification of the computation"),
                 option("-t", "--threads").doc("specify the number of threads used") & value("threads", args.threads),
-                option("-n", "--num-trials").doc("number of iterations for the benchmark") & value("trials", args.num_trials)
+                option("-n", "--num-trials").doc("number of iterations for the benchmark") & value("trials", args.num_trials),
+                option("--relabel").doc("relabel the input graph by an ordering: " + relabel_choices())
+                    & value("ordering", args.relabel),
+                option("--ordering-cache").doc("load preprocessing results from (and store them in) the given directory")
+                    & value("directory", args.ordering_cache),
+                option("--refresh-ordering-cache").set(args.ordering_cache_refresh)
+                    .doc("recompute the preprocessing and overwrite the entries in the ordering cache")
             );
 
             if (custom_params.size() > 0) {
@@ -170,13 +229,25 @@ namespace GMS::CLI
                 std::exit(100);
             }
 
-            // TODO this should be improved in a further commit
-            bool allow_relabel = true;
-            if (allow_relabel && WorthRelabelling(g)) {
-                g = Builder::RelabelByDegree(g);
+            if (args.relabel == "auto") {
+                // TODO this should be improved in a further commit
+                args.relabel = WorthRelabelling(g) ? "degree" : "none";
+            }
+            if (args.relabel != "none") {
+                Timer t;
+                t.Start();
+                std::optional<CSRGraph> relabeled = relabeler_(g, args.relabel, args.original_ids);
+                if (!relabeled) {
+                    std::cerr << "unknown ordering " << args.relabel << " (available: " << relabel_choices() << ")"
+                              << std::endl;
+                    std::exit(100);
+                }
+                g = std::move(*relabeled);
+                t.Stop();
+                PrintTime("Relabel Time", t.Seconds());
                 std::cout
                     << "---------\n"
-                    << "NOTE: The input graph got relabeled.\n"
+                    << "NOTE: The input graph got relabeled (" << args.relabel << ").\n"
                     << "---------" << std::endl;
             }
 
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include <omp.h>
+
+// Building blocks of the sampling based estimators: error budgets, estimates with confidence intervals and the
+// stopping rules shared by the approximate kernels.
+namespace GMS::Estimation {
+
+/**
+ * Stopping criteria of the approximate kernels: sampling stops as soon as the confidence interval is within
+ * relative_error of the estimate, or when the time budget (if positive) is used up.
+ */
+struct Budget {
+    double relative_error = 0.05;
+    double confidence = 0.95;
+    double seconds = 0.;   // 0: no time limit
+    uint64_t seed = 42;
+};
+
+/** An estimate with its confidence interval. */
+struct Estimate {
+    double value = 0.;
+    double lower = 0.;
+    double upper = 0.;
+    double confidence = 0.;
+    int64_t samples = 0;   // number of trials or samples
+    double seconds = 0.;
+
+    double relative_half_width() const {
+        return value > 0 ? (upper - lower) / 2 / value : INFINITY;
+    }
+
+    void print() const {
+        std::printf("%-21s%.1f\n", "Estimate:", value);
+        std::printf("%-21s[%.1f, %.1f] (%.0f%%)\n", "Confidence Interval:", lower, upper, 100 * confidence);
+        std::printf("%-21s%lld\n", "Samples:", static_cast<long long>(samples));
+    }
+};
+
+// SplitMix64 finalizer, used to derive independent seeds and hash based samples.
+inline uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Two sided quantile of the standard normal distribution for the confidence level (Acklam's approximation of the
+// inverse CDF, relative error below 1.2e-9).
+inline double z_value(double confidence) {
+    const double p = 1 - (1 - confidence) / 2;
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    if (p > 1 - 0.02425) {
+        const double q = std::sqrt(-2 * std::log(1 - p));
+        return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+    const double q = p - 0.5, r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+// Two sided quantile of Student's t distribution with df degrees of freedom for the confidence level: exact for one
+// and two degrees of freedom, otherwise the Cornish-Fisher expansion around z_value (Abramowitz and Stegun 26.7.5,
+// below 1% relative error for df >= 3).
+inline double t_value(double confidence, int64_t df) {
+    const double pi = 3.14159265358979323846;
+    const double p = 1 - (1 - confidence) / 2;
+    if (df <= 1)
+        return std::tan(pi * (p - 0.5));
+    if (df == 2)
+        return (2 * p - 1) / std::sqrt(2 * p * (1 - p));
+    const double z = z_value(confidence), z2 = z * z, n = static_cast<double>(df);
+    const double g1 = (z2 + 1) * z / 4;
+    const double g2 = ((5 * z2 + 16) * z2 + 3) * z / 96;
+    const double g3 = (((3 * z2 + 19) * z2 + 17) * z2 - 15) * z / 384;
+    const double g4 = ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945) * z / 92160;
+    return z + g1 / n + g2 / (n * n) + g3 / (n * n * n) + g4 / (n * n * n * n);
+}
+
+/**
+ * Repeats the independent, unbiased estimator trial(round) until the t confidence interval of the mean is within the
+ * budget. The interval is only trusted once min_trials trials were nonzero: trials of sparse samples are often all
+ * zero, which says nothing about the variance. At most max_trials trials are run.
+ */
+template <class Trial>
+Estimate repeat_trials(const Budget &budget, Trial &&trial, int64_t min_trials = 3, int64_t max_trials = 1024) {
+    const double start = omp_get_wtime();
+    double sum = 0, sum_squares = 0;
+    int64_t nonzero = 0;
+    Estimate estimate;
+    estimate.confidence = budget.confidence;
+    for (int64_t r = 1; r <= max_trials; ++r) {
+        const double x = trial(r);
+        sum += x;
+        sum_squares += x * x;
+        nonzero += x != 0;
+        const double mean = sum / r;
+        const double variance = r > 1 ? std::max(0., (sum_squares - r * mean * mean) / (r - 1)) : 0.;
+        const double half_width = r > 1 ? t_value(budget.confidence, r - 1) * std::sqrt(variance / r) : INFINITY;
+        estimate.value = mean;
+        estimate.lower = std::max(0., mean - half_width);
+        estimate.upper = mean + half_width;
+        estimate.samples = r;
+        estimate.seconds = omp_get_wtime() - start;
+        if (r >= min_trials && nonzero >= min_trials && half_width <= budget.relative_error * mean)
+            break;
+        if (budget.seconds > 0 && estimate.seconds >= budget.seconds && r >= 2)
+            break;
+    }
+    return estimate;
+}
+
+/**
+ * Estimate of a proportion from successes out of samples Bernoulli trials, with the normal approximation of the
+ * binomial confidence interval (the variance is bounded below by 1 / samples, so that no successes don't give an
+ * empty interval).
+ *
+ * @return the half width of the interval
+ */
+inline double binomial_estimate(int64_t successes, int64_t samples, double confidence, Estimate &estimate) {
+    const double p = samples > 0 ? static_cast<double>(successes) / samples : 0.;
+    const double half_width = samples > 0
+        ? z_value(confidence) * std::sqrt(std::max(p * (1 - p), 1. / samples) / samples) : 1.;
+    estimate.value = p;
+    estimate.lower = std::max(0., p - half_width);
+    estimate.upper = std::min(1., p + half_width);
+    estimate.confidence = confidence;
+    estimate.samples = samples;
+    return half_width;
+}
+
+} // namespace GMS::Estimation
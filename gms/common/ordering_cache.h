@@ -0,0 +1,378 @@
+#pragma once
+
+#include "types.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gms/third_party/gapbs/timer.h>
+#include <gms/third_party/gapbs/util.h>
+
+// Persistent store for vertex orderings (in rank format) and core numbers.
+//
+// Entries are keyed by a content hash of the graph together with the explicit name and the parameters of the ordering
+// algorithm, so benchmark runs on the same input can skip the preprocessing. Every entry is a single file in the
+// cache directory, which is mapped into memory when it's loaded.
+
+namespace GMS::OrderingCache {
+
+enum class Mode {
+    Off,     // always compute the ordering
+    Reuse,   // load the ordering if it is in the store, compute and store it otherwise
+    Refresh  // compute the ordering and overwrite the entry in the store
+};
+
+namespace detail {
+    // splitmix64 finalizer
+    inline uint64_t mix(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    inline uint64_t hash_string(const std::string &s) {
+        // FNV-1a
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    inline std::string hex(uint64_t x) {
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(x));
+        return buffer;
+    }
+
+    constexpr char kMagic[8] = {'G', 'M', 'S', 'O', 'R', 'D', '0', '1'};
+
+    struct Header {
+        char magic[8];
+        uint64_t fingerprint;
+        int64_t num_nodes;
+        uint64_t key_length;   // length of the key string which follows the header
+        uint64_t has_cores;
+    };
+
+    // Offset of the payload, the key string is padded to a multiple of 8 bytes.
+    inline size_t payload_offset(size_t key_length) {
+        return sizeof(Header) + (key_length + 7) / 8 * 8;
+    }
+} // namespace detail
+
+/**
+ * Content hash of a graph, computed in parallel. The hash covers the number of vertices and the (ordered) adjacency
+ * list of every vertex, so it doesn't depend on the representation of the graph or on the number of threads.
+ */
+template <class Graph>
+uint64_t fingerprint(const Graph &g) {
+    const int64_t n = g.num_nodes();
+    uint64_t h = 0;
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(+ : h)
+    for (int64_t v = 0; v < n; v++) {
+        uint64_t local = detail::mix(v);
+        for (NodeId u : g.out_neigh(v)) {
+            local = detail::mix(local ^ static_cast<uint64_t>(u));
+        }
+        h += detail::mix(local ^ (static_cast<uint64_t>(g.out_degree(v)) << 32));
+    }
+    return detail::mix(h ^ detail::mix(n) ^ g.directed());
+}
+
+struct Key {
+    uint64_t graph;          // see fingerprint
+    std::string algorithm;
+    std::string parameters;
+
+    std::string to_string() const {
+        return algorithm + "|" + parameters;
+    }
+
+    std::string file_name() const {
+        return detail::hex(graph) + "-" + detail::hex(detail::hash_string(to_string())) + ".gmsord";
+    }
+};
+
+/**
+ * Read-only view of an entry of the store, backed by a private memory mapping of the file.
+ */
+class Entry {
+public:
+    Entry(void *data, size_t size, size_t offset, int64_t num_nodes, bool has_cores) :
+        data_(data), size_(size), offset_(offset), num_nodes_(num_nodes), has_cores_(has_cores) {}
+
+    Entry(const Entry &) = delete;
+    Entry &operator=(const Entry &) = delete;
+    Entry(Entry &&other) noexcept :
+        data_(other.data_), size_(other.size_), offset_(other.offset_), num_nodes_(other.num_nodes_),
+        has_cores_(other.has_cores_) {
+        other.data_ = nullptr;
+    }
+    Entry &operator=(Entry &&other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        offset_ = other.offset_;
+        num_nodes_ = other.num_nodes_;
+        has_cores_ = other.has_cores_;
+        return *this;
+    }
+
+    ~Entry() {
+        if (data_ != nullptr)
+            munmap(data_, size_);
+    }
+
+    int64_t num_nodes() const { return num_nodes_; }
+    bool has_cores() const { return has_cores_; }
+
+    // ranks()[v] = position of v in the ordering
+    const NodeId *ranks() const {
+        return reinterpret_cast<const NodeId *>(static_cast<const char *>(data_) + offset_);
+    }
+
+    // cores()[v] = core number of v, only valid if has_cores()
+    const NodeId *cores() const {
+        return has_cores_ ? ranks() + num_nodes_ : nullptr;
+    }
+
+    template <class Output>
+    void copy_ranks(Output &out) const {
+        out.resize(num_nodes_);
+        const NodeId *r = ranks();
+        #pragma omp parallel for schedule(static)
+        for (int64_t v = 0; v < num_nodes_; v++)
+            out[v] = r[v];
+    }
+
+    template <class Output>
+    void copy_cores(Output &out) const {
+        out.resize(num_nodes_);
+        const NodeId *c = cores();
+        #pragma omp parallel for schedule(static)
+        for (int64_t v = 0; v < num_nodes_; v++)
+            out[v] = c[v];
+    }
+
+private:
+    void *data_;
+    size_t size_;
+    size_t offset_;
+    int64_t num_nodes_;
+    bool has_cores_;
+};
+
+class Store {
+public:
+    explicit Store(std::string directory) : directory_(std::move(directory)) {
+        if (!directory_.empty() && mkdir(directory_.c_str(), 0755) != 0 && errno != EEXIST) {
+            std::cerr << "ordering cache: cannot create " << directory_ << ": " << std::strerror(errno) << std::endl;
+        }
+    }
+
+    const std::string &directory() const { return directory_; }
+
+    std::string path(const Key &key) const {
+        return directory_ + "/" + key.file_name();
+    }
+
+    /**
+     * Maps the entry for key into memory.
+     * Returns std::nullopt if there is no entry or if it doesn't match the key and the number of vertices.
+     */
+    std::optional<Entry> load(const Key &key, int64_t num_nodes) const {
+        const std::string file = path(key);
+        int fd = open(file.c_str(), O_RDONLY);
+        if (fd < 0)
+            return std::nullopt;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(detail::Header)) {
+            close(fd);
+            return std::nullopt;
+        }
+        const size_t size = st.st_size;
+        void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+            return std::nullopt;
+
+        detail::Header header;
+        std::memcpy(&header, data, sizeof(header));
+        const std::string expected_key = key.to_string();
+        const size_t offset = detail::payload_offset(header.key_length);
+        const size_t arrays = header.has_cores ? 2 : 1;
+        bool valid = std::memcmp(header.magic, detail::kMagic, sizeof(detail::kMagic)) == 0
+                && header.fingerprint == key.graph
+                && header.num_nodes == num_nodes
+                && header.key_length == expected_key.size()
+                && size == offset + arrays * num_nodes * sizeof(NodeId)
+                && std::memcmp(static_cast<const char *>(data) + sizeof(header), expected_key.data(),
+                               expected_key.size()) == 0;
+        if (!valid) {
+            std::cerr << "ordering cache: ignoring invalid entry " << file << std::endl;
+            munmap(data, size);
+            return std::nullopt;
+        }
+        return std::make_optional<Entry>(data, size, offset, num_nodes, header.has_cores != 0);
+    }
+
+    /**
+     * Writes the ranks (and optionally the core numbers) of the num_nodes vertices to the entry for key.
+     * The file is written to a temporary name first and then renamed, so concurrent readers never see partial
+     * entries. Returns false if the entry couldn't be written.
+     */
+    bool save_arrays(const Key &key, int64_t num_nodes, const NodeId *ranks, const NodeId *cores = nullptr) const {
+        const std::string file = path(key);
+        const std::string tmp = file + ".tmp." + std::to_string(getpid());
+        std::FILE *out = std::fopen(tmp.c_str(), "wb");
+        if (out == nullptr) {
+            std::cerr << "ordering cache: cannot write " << tmp << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        const std::string key_string = key.to_string();
+        detail::Header header;
+        std::memcpy(header.magic, detail::kMagic, sizeof(detail::kMagic));
+        header.fingerprint = key.graph;
+        header.num_nodes = num_nodes;
+        header.key_length = key_string.size();
+        header.has_cores = cores != nullptr;
+        const std::vector<char> padding(detail::payload_offset(key_string.size()) - sizeof(header) - key_string.size(), 0);
+
+        bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1
+                && std::fwrite(key_string.data(), 1, key_string.size(), out) == key_string.size()
+                && std::fwrite(padding.data(), 1, padding.size(), out) == padding.size()
+                && std::fwrite(ranks, sizeof(NodeId), num_nodes, out) == static_cast<size_t>(num_nodes)
+                && (cores == nullptr || std::fwrite(cores, sizeof(NodeId), num_nodes, out) == static_cast<size_t>(num_nodes));
+        ok = (std::fclose(out) == 0) && ok;
+        if (!ok || std::rename(tmp.c_str(), file.c_str()) != 0) {
+            std::cerr << "ordering cache: cannot write " << file << std::endl;
+            std::remove(tmp.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    template <class Ranks>
+    bool save(const Key &key, const Ranks &ranks) const {
+        return save_arrays(key, ranks.size(), ranks.data());
+    }
+
+    template <class Ranks, class Cores>
+    bool save(const Key &key, const Ranks &ranks, const Cores &cores) const {
+        return save_arrays(key, ranks.size(), ranks.data(), cores.data());
+    }
+
+private:
+    std::string directory_;
+};
+
+/**
+ * One ordering (in rank format) of one graph, and optionally its core numbers, taken from the store if possible.
+ * The entry is identified by the fingerprint of the graph and the explicit name of the ordering (e.g. "degeneracy"),
+ * so all benchmarks which use the same ordering of the same input share it. Loading an entry doesn't measure the
+ * preprocessing, so the time to load an entry and the time to compute a missing one are reported separately.
+ */
+class CachedOrdering {
+public:
+    template <class Graph>
+    CachedOrdering(Mode mode, const std::string &directory, const Graph &g, std::string ordering,
+                   std::string parameters = "") :
+            num_nodes_(g.num_nodes()), refresh_(mode == Mode::Refresh) {
+        if (mode != Mode::Off) {
+            store_.emplace(directory);
+            key_ = Key{fingerprint(g), std::move(ordering), std::move(parameters)};
+        }
+    }
+
+    bool enabled() const { return store_.has_value(); }
+
+    /**
+     * Fills ranks from the store, or with compute(ranks) if there is no entry (or the mode is Refresh), and stores
+     * the computed ranks.
+     */
+    template <class Ranks, class Compute>
+    void get(Ranks &ranks, Compute &&compute) {
+        fetch(ranks, static_cast<std::vector<NodeId> *>(nullptr), [&](Ranks &r, std::vector<NodeId> *) { compute(r); });
+    }
+
+    /**
+     * Same as get(ranks, compute) with the core numbers, computed with compute(ranks, cores). Entries without core
+     * numbers are computed again.
+     */
+    template <class Ranks, class Cores, class Compute>
+    void get(Ranks &ranks, Cores &cores, Compute &&compute) {
+        fetch(ranks, &cores, [&](Ranks &r, Cores *c) { compute(r, *c); });
+    }
+
+    // Whether the last get loaded the entry from the store.
+    bool loaded() const { return loaded_; }
+    // Time to load or to compute the ordering in the last get, the time to store it is not included.
+    double seconds() const { return seconds_; }
+    const char *source() const { return loaded_ ? "cache" : "computed"; }
+
+    void print() const {
+        if (!enabled())
+            return;
+        PrintLabel("Ordering Source", source());
+        PrintTime(loaded_ ? "Ordering Load Time" : "Ordering Compute Time", seconds_);
+    }
+
+private:
+    int64_t num_nodes_;
+    bool refresh_;
+    std::optional<Store> store_;
+    Key key_;
+    bool loaded_ = false;
+    double seconds_ = 0;
+
+    template <class Ranks, class Cores, class Compute>
+    void fetch(Ranks &ranks, Cores *cores, Compute &&compute) {
+        Timer timer;
+        timer.Start();
+        loaded_ = false;
+        if (store_ && !refresh_) {
+            std::optional<Entry> entry = store_->load(key_, num_nodes_);
+            if (entry && (cores == nullptr || entry->has_cores())) {
+                entry->copy_ranks(ranks);
+                if (cores != nullptr)
+                    entry->copy_cores(*cores);
+                loaded_ = true;
+            }
+        }
+        if (!loaded_)
+            compute(ranks, cores);
+        timer.Stop();
+        seconds_ = timer.Seconds();
+
+        if (store_ && !loaded_) {
+            const bool saved = cores == nullptr ? store_->save(key_, ranks) : store_->save(key_, ranks, *cores);
+            // refresh the entry once, the following calls reuse it
+            if (saved)
+                refresh_ = false;
+        }
+    }
+};
+
+inline const char *to_string(Mode mode) {
+    switch (mode) {
+        case Mode::Reuse: return "reuse";
+        case Mode::Refresh: return "refresh";
+        default: return "off";
+    }
+}
+
+} // namespace GMS::OrderingCache
@@ -0,0 +1,574 @@
+#ifndef GRAPHSETS_COMPRESSED_REFERENCE_COMPRESSED_H
+#define GRAPHSETS_COMPRESSED_REFERENCE_COMPRESSED_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "coders-utils/varint_utils.h"
+#include <gms/representations/graphs/prefetch.h>
+
+/**
+ * Reference compression in the spirit of WebGraph (Boldi and Vigna, WWW 2004).
+ *
+ * Every neighbourhood N(v) is encoded relative to the neighbourhood of a reference vertex v - r within a window of
+ * preceding vertices:
+ *   [deg] [r] ([#blocks] [block]*)? [#intervals] ([left] [length - kMinIntervalLength])* [residual]*
+ * The blocks alternately copy and skip runs of the reference list (starting with a copy block), the elements after
+ * the last block are skipped. The remaining neighbours are stored as intervals of consecutive ids and as residual
+ * gaps. The first interval and the first residual are stored relative to v (zig-zag), all other values as gaps to
+ * their predecessor. All values are byte-based varints.
+ *
+ * Reference chains are at most kMaxReferenceDepth long, hence the iterator decodes the chain lazily with a fixed
+ * amount of state and without allocations.
+ */
+class ReferenceCompressedGraph {
+public:
+    static constexpr int kMaxReferenceDepth = 3;
+    static constexpr uint64_t kMinIntervalLength = 4;
+
+    class CompressedNeighbourhood {
+    public:
+        class iterator: public std::iterator<
+                std::input_iterator_tag, // iterator_category
+                NodeId,                  // value_type
+                NodeId,                  // difference_type
+                const NodeId*,           // pointer
+                NodeId                  // reference
+        >{
+            static constexpr int64_t none = std::numeric_limits<int64_t>::max();
+
+            // Decoding state of one neighbourhood of the reference chain.
+            struct Level {
+                int64_t vertex;
+
+                const unsigned char* block_pos;
+                uint64_t blocks_left;
+                uint64_t block_remaining;
+                bool in_copy;
+
+                const unsigned char* interval_pos;
+                uint64_t intervals_left;
+                uint64_t interval_remaining;
+                int64_t interval_next;
+                int64_t interval_end;
+
+                const unsigned char* residual_pos;
+                uint64_t residuals_left;
+                int64_t residual_prev;
+
+                int64_t next_copy;
+                int64_t next_interval;
+                int64_t next_residual;
+            };
+
+            const unsigned char* adj_data;
+            const uint64_t* offsets;
+            uint64_t current_neigh;
+            int64_t neigh;
+            Level levels[kMaxReferenceDepth + 1];
+
+            static int64_t from_zigzag(uint64_t x) {
+                return (x & 1) ? -(int64_t)(x >> 1) - 1 : (int64_t)(x >> 1);
+            }
+
+            static uint64_t read(const unsigned char*& pos) {
+                uint64_t x = 0;
+                pos += fromVarint(const_cast<unsigned char*>(pos), &x);
+                return x;
+            }
+
+            void init(int d, int64_t x) {
+                Level &l = levels[d];
+                l.vertex = x;
+                l.next_copy = l.next_interval = l.next_residual = none;
+                const unsigned char* pos = adj_data + offsets[x];
+                uint64_t degree = read(pos);
+                if (degree == 0) {
+                    return;
+                }
+
+                uint64_t reference = read(pos);
+                uint64_t copied = 0;
+                l.blocks_left = 0;
+                if (reference > 0) {
+                    l.blocks_left = read(pos);
+                    l.block_pos = pos;
+                    for (uint64_t i = 0; i < l.blocks_left; ++i) {
+                        uint64_t block = read(pos);
+                        copied += (i % 2 == 0) ? block : 0;
+                    }
+                    l.block_remaining = 0;
+                    l.in_copy = false;
+                    init(d + 1, x - reference);
+                }
+
+                l.intervals_left = read(pos);
+                l.interval_pos = pos;
+                l.interval_remaining = 0;
+                l.interval_end = none;
+                uint64_t in_intervals = 0;
+                for (uint64_t i = 0; i < l.intervals_left; ++i) {
+                    read(pos);
+                    in_intervals += read(pos) + kMinIntervalLength;
+                }
+
+                l.residual_pos = pos;
+                l.residuals_left = degree - copied - in_intervals;
+                l.residual_prev = none;
+
+                if (reference > 0) {
+                    l.next_copy = pull_copy(d);
+                }
+                l.next_interval = pull_interval(l);
+                l.next_residual = pull_residual(l);
+            }
+
+            int64_t pull_copy(int d) {
+                Level &l = levels[d];
+                while (true) {
+                    while (l.block_remaining == 0) {
+                        if (l.blocks_left == 0) {
+                            return none;
+                        }
+                        l.block_remaining = read(l.block_pos);
+                        l.blocks_left--;
+                        l.in_copy = !l.in_copy;
+                    }
+                    int64_t x = advance(d + 1);
+                    l.block_remaining--;
+                    if (l.in_copy) {
+                        return x;
+                    }
+                }
+            }
+
+            static int64_t pull_interval(Level &l) {
+                if (l.interval_remaining > 0) {
+                    l.interval_remaining--;
+                    return l.interval_next++;
+                }
+                if (l.intervals_left == 0) {
+                    return none;
+                }
+                uint64_t gap = read(l.interval_pos);
+                int64_t left = (l.interval_end == none) ? l.vertex + from_zigzag(gap) : l.interval_end + 1 + gap;
+                uint64_t length = read(l.interval_pos) + kMinIntervalLength;
+                l.intervals_left--;
+                l.interval_end = left + length - 1;
+                l.interval_next = left + 1;
+                l.interval_remaining = length - 1;
+                return left;
+            }
+
+            static int64_t pull_residual(Level &l) {
+                if (l.residuals_left == 0) {
+                    return none;
+                }
+                uint64_t gap = read(l.residual_pos);
+                l.residuals_left--;
+                l.residual_prev = (l.residual_prev == none) ? l.vertex + from_zigzag(gap) : l.residual_prev + 1 + gap;
+                return l.residual_prev;
+            }
+
+            // Returns the next neighbour of the neighbourhood at level d of the reference chain.
+            int64_t advance(int d) {
+                Level &l = levels[d];
+                int64_t x;
+                if (l.next_copy < l.next_interval && l.next_copy < l.next_residual) {
+                    x = l.next_copy;
+                    l.next_copy = pull_copy(d);
+                } else if (l.next_interval < l.next_residual) {
+                    x = l.next_interval;
+                    l.next_interval = pull_interval(l);
+                } else {
+                    x = l.next_residual;
+                    l.next_residual = pull_residual(l);
+                }
+                return x;
+            }
+
+        public:
+            explicit iterator(uint64_t v, const unsigned char* adj_data, const uint64_t* offsets,
+                              uint64_t current_neigh, uint64_t nr_neighs) {
+                this->adj_data = adj_data;
+                this->offsets = offsets;
+                this->current_neigh = current_neigh;
+                this->neigh = 0;
+                if (current_neigh < nr_neighs) {
+                    init(0, v);
+                    this->neigh = advance(0);
+                }
+            }
+
+
+            iterator& operator++() {
+                this->current_neigh++;
+                this->neigh = advance(0);
+                return *this;
+            }
+
+
+            iterator operator++(int) {
+                iterator retval = *this;
+                ++(*this);
+                return retval;
+            }
+
+
+            bool operator==(const iterator &other) const {
+                return this->current_neigh == other.current_neigh;
+            }
+
+
+            bool operator!=(const iterator &other) const {
+                return this->current_neigh != other.current_neigh;
+            }
+
+
+            reference operator*() const {
+                return this->neigh;
+            }
+        };
+
+    private:
+        uint64_t nr_neighs = 0;
+        const unsigned char* adj_data;
+        const uint64_t* offsets;
+        NodeId n;
+
+    public:
+        CompressedNeighbourhood(NodeId n, const unsigned char* adj_data, const uint64_t* offsets) {
+            this->n = n;
+            this->adj_data = adj_data;
+            this->offsets = offsets;
+            fromVarint(const_cast<unsigned char*>(&adj_data[offsets[n]]), &nr_neighs);
+        }
+
+        iterator begin() const {
+            return iterator(this->n, this->adj_data, this->offsets, 0, nr_neighs);
+        }
+
+        iterator end() const {
+            return iterator(this->n, this->adj_data, this->offsets, nr_neighs, nr_neighs);
+        }
+    };
+
+
+public:
+
+    uint64_t* new_offsets_in;
+    uint64_t* new_offsets_out;
+    unsigned char* new_adj_data_out;
+    unsigned char* new_adj_data_in;
+
+    ReferenceCompressedGraph(int64_t num_nodes, int64_t num_edges, bool directed,
+            uint64_t* new_offsets_out,
+            uint64_t* new_offsets_in,
+            unsigned char* new_adj_data_out,
+            unsigned char* new_adj_data_in) {
+
+        this->num_nodes_ = num_nodes;
+        this->num_edges_ = num_edges;
+        this->directed_ = directed;
+
+        this->new_offsets_out = new_offsets_out;
+        this->new_offsets_in = new_offsets_in;
+        this->new_adj_data_out = new_adj_data_out;
+        this->new_adj_data_in = new_adj_data_in;
+    }
+
+    ReferenceCompressedGraph(const ReferenceCompressedGraph &) = delete;
+    ReferenceCompressedGraph &operator=(const ReferenceCompressedGraph &) = delete;
+
+    ReferenceCompressedGraph(ReferenceCompressedGraph &&g) :
+        new_offsets_in(g.new_offsets_in),
+        new_offsets_out(g.new_offsets_out),
+        new_adj_data_out(g.new_adj_data_out),
+        new_adj_data_in(g.new_adj_data_in),
+        directed_(g.directed_),
+        num_nodes_(g.num_nodes_),
+        num_edges_(g.num_edges_)
+    {
+        g.new_offsets_out = nullptr;
+        g.new_offsets_in = nullptr;
+        g.new_adj_data_out = nullptr;
+        g.new_adj_data_in = nullptr;
+    }
+
+    ~ReferenceCompressedGraph() {
+        // Undirected graphs share the out- and in-data.
+        if (new_offsets_in != new_offsets_out) delete[] new_offsets_in;
+        if (new_adj_data_in != new_adj_data_out) delete[] new_adj_data_in;
+        delete[] new_offsets_out;
+        delete[] new_adj_data_out;
+    }
+
+    /**
+     * Encodes a graph with sorted neighbourhoods. The vertices are split into chunks which are encoded in parallel,
+     * references do not cross chunk borders.
+     *
+     * @param window Number of preceding vertices considered as reference.
+     * @param max_reference_depth Maximum length of a reference chain, at most kMaxReferenceDepth.
+     */
+    template <class CGraph>
+    static ReferenceCompressedGraph FromCGraph(const CGraph &graph, int64_t window = 7,
+                                               int max_reference_depth = kMaxReferenceDepth) {
+        max_reference_depth = std::min(max_reference_depth, kMaxReferenceDepth);
+        uint64_t *offsets_out, *offsets_in;
+        unsigned char *adj_data_out, *adj_data_in;
+        encode(graph, false, window, max_reference_depth, &offsets_out, &adj_data_out);
+        if (graph.directed()) {
+            encode(graph, true, window, max_reference_depth, &offsets_in, &adj_data_in);
+        } else {
+            offsets_in = offsets_out;
+            adj_data_in = adj_data_out;
+        }
+        return ReferenceCompressedGraph(graph.num_nodes(), graph.num_edges(), graph.directed(),
+                                        offsets_out, offsets_in, adj_data_out, adj_data_in);
+    }
+
+    bool directed() const {
+        return directed_;
+    }
+
+    int64_t num_nodes() const {
+        return num_nodes_;
+    }
+
+    int64_t num_edges() const {
+        return num_edges_;
+    }
+
+    int64_t num_edges_directed() const {
+        return directed_ ? num_edges_ : 2*num_edges_;
+    }
+
+    int64_t out_degree(NodeId v) const {
+        uint64_t nr_neighs = 0;
+        fromVarint(&new_adj_data_out[new_offsets_out[v]], &nr_neighs);
+        return (int64_t)nr_neighs;
+    }
+
+    int64_t in_degree(NodeId v) const {
+        uint64_t nr_neighs = 0;
+        fromVarint(&new_adj_data_in[new_offsets_in[v]], &nr_neighs);
+        return (int64_t)nr_neighs;
+    }
+
+    CompressedNeighbourhood out_neigh(NodeId n) const {
+        return CompressedNeighbourhood(n, new_adj_data_out, new_offsets_out);
+    }
+
+    CompressedNeighbourhood in_neigh(NodeId n) const {
+        return CompressedNeighbourhood(n, new_adj_data_in, new_offsets_in);
+    }
+
+    /** Prefetches the encoding of v, the lists it copies from are not prefetched. */
+    void prefetch_neighbourhood(NodeId v) const {
+        GMS::Prefetch::prefetch_bytes(&new_adj_data_out[new_offsets_out[v]], new_offsets_out[v + 1] - new_offsets_out[v]);
+    }
+
+    /** Size of the encoded adjacency data (without offsets). */
+    uint64_t size_in_bytes() const {
+        uint64_t size = new_offsets_out[num_nodes_];
+        if (directed_) {
+            size += new_offsets_in[num_nodes_];
+        }
+        return size;
+    }
+
+    double bits_per_edge() const {
+        return num_edges_directed() > 0 ? 8.0 * size_in_bytes() / num_edges_directed() : 0.0;
+    }
+
+    void PrintStats() const {
+        std::cout << "Reference compressed graph has " << num_nodes() << " nodes and "
+                  << num_edges() << " ";
+        if (!directed()){
+            std::cout << "un";
+        }
+        std::cout << "directed edges for degree: ";
+        std::cout << (num_edges()/num_nodes()) << std::endl;
+        std::cout << "Bits per edge: " << bits_per_edge() << std::endl;
+    }
+
+    void PrintTopology() const {
+    }
+
+    Range<NodeId> vertices() const {
+        return Range<NodeId>(num_nodes());
+    }
+
+private:
+    bool directed_;
+    int64_t num_nodes_;
+    int64_t num_edges_;
+
+    static constexpr int64_t kChunkSize = 4096;
+
+    static uint64_t to_zigzag(int64_t x) {
+        return x < 0 ? ((uint64_t)(-(x + 1)) << 1) | 1 : (uint64_t)x << 1;
+    }
+
+    static void write(std::vector<unsigned char> &out, uint64_t x) {
+        unsigned char buffer[BYTES_IN_64BIT_WORD + 2];
+        int length = toVarint(x, buffer);
+        out.insert(out.end(), buffer, buffer + length);
+    }
+
+    /**
+     * Appends the encoding of the neighbourhood list of v to out.
+     *
+     * @param reference Neighbourhood of the reference vertex v - r, ignored if r == 0.
+     */
+    static void encode_neighbourhood(int64_t v, const std::vector<int64_t> &list, uint64_t r,
+                                     const std::vector<int64_t> &reference, std::vector<int64_t> &extras,
+                                     std::vector<unsigned char> &out) {
+        write(out, list.size());
+        if (list.empty()) {
+            return;
+        }
+        write(out, r);
+
+        extras.clear();
+        if (r > 0) {
+            // Copy blocks: runs of reference elements which are (not) contained in the list.
+            std::vector<uint64_t> blocks;
+            bool in_copy = true;
+            uint64_t run = 0;
+            auto it = list.begin();
+            for (int64_t x : reference) {
+                while (it != list.end() && *it < x) {
+                    extras.push_back(*it++);
+                }
+                bool copied = it != list.end() && *it == x;
+                if (copied) {
+                    ++it;
+                }
+                if (copied != in_copy) {
+                    blocks.push_back(run);
+                    run = 0;
+                    in_copy = copied;
+                }
+                ++run;
+            }
+            extras.insert(extras.end(), it, list.end());
+            if (in_copy) {
+                blocks.push_back(run);
+            }
+            write(out, blocks.size());
+            for (uint64_t block : blocks) {
+                write(out, block);
+            }
+        } else {
+            extras.assign(list.begin(), list.end());
+        }
+
+        // Intervals of consecutive ids, the rest are residuals.
+        std::vector<std::pair<int64_t, uint64_t>> intervals;
+        size_t num_residuals = 0;
+        for (size_t i = 0; i < extras.size();) {
+            size_t j = i + 1;
+            while (j < extras.size() && extras[j] == extras[j - 1] + 1) {
+                ++j;
+            }
+            if (j - i >= kMinIntervalLength) {
+                intervals.emplace_back(extras[i], j - i);
+            } else {
+                for (size_t k = i; k < j; ++k) {
+                    extras[num_residuals++] = extras[k];
+                }
+            }
+            i = j;
+        }
+        extras.resize(num_residuals);
+
+        write(out, intervals.size());
+        int64_t previous_end = v;
+        for (size_t i = 0; i < intervals.size(); ++i) {
+            auto [left, length] = intervals[i];
+            write(out, i == 0 ? to_zigzag(left - v) : left - previous_end - 1);
+            write(out, length - kMinIntervalLength);
+            previous_end = left + length - 1;
+        }
+        for (size_t i = 0; i < extras.size(); ++i) {
+            write(out, i == 0 ? to_zigzag(extras[i] - v) : extras[i] - extras[i - 1] - 1);
+        }
+    }
+
+    template <class CGraph>
+    static void encode(const CGraph &graph, bool transpose, int64_t window, int max_reference_depth,
+                       uint64_t **offsets, unsigned char **adj_data) {
+        const int64_t n = graph.num_nodes();
+        const int64_t num_chunks = (n + kChunkSize - 1) / kChunkSize;
+        *offsets = new uint64_t[n + 1];
+        std::vector<std::vector<unsigned char>> chunk_data(num_chunks);
+
+        #pragma omp parallel
+        {
+            std::vector<std::vector<int64_t>> lists(window + 1);
+            std::vector<int> depth(window + 1);
+            std::vector<int64_t> extras;
+            std::vector<unsigned char> best, candidate;
+
+            #pragma omp for schedule(dynamic, 1)
+            for (int64_t c = 0; c < num_chunks; ++c) {
+                const int64_t chunk_begin = c * kChunkSize;
+                const int64_t chunk_end = std::min(n, chunk_begin + kChunkSize);
+                std::vector<unsigned char> &out = chunk_data[c];
+
+                for (int64_t v = chunk_begin; v < chunk_end; ++v) {
+                    // lists and depth are cyclic buffers over the window.
+                    const int64_t slot = v % (window + 1);
+                    std::vector<int64_t> &list = lists[slot];
+                    list.clear();
+                    if (transpose) {
+                        for (auto u : graph.in_neigh(v)) list.push_back(u);
+                    } else {
+                        for (auto u : graph.out_neigh(v)) list.push_back(u);
+                    }
+
+                    best.clear();
+                    encode_neighbourhood(v, list, 0, list, extras, best);
+                    depth[slot] = 0;
+                    for (int64_t r = 1; r <= window && v - r >= chunk_begin && !list.empty(); ++r) {
+                        const int64_t ref_slot = (v - r) % (window + 1);
+                        if (depth[ref_slot] >= max_reference_depth || lists[ref_slot].empty()) {
+                            continue;
+                        }
+                        candidate.clear();
+                        encode_neighbourhood(v, list, r, lists[ref_slot], extras, candidate);
+                        if (candidate.size() < best.size()) {
+                            best.swap(candidate);
+                            depth[slot] = depth[ref_slot] + 1;
+                        }
+                    }
+
+                    (*offsets)[v] = out.size();
+                    out.insert(out.end(), best.begin(), best.end());
+                }
+            }
+        }
+
+        std::vector<uint64_t> chunk_offsets(num_chunks + 1, 0);
+        for (int64_t c = 0; c < num_chunks; ++c) {
+            chunk_offsets[c + 1] = chunk_offsets[c] + chunk_data[c].size();
+        }
+        *adj_data = new unsigned char[chunk_offsets[num_chunks] + 1];
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int64_t c = 0; c < num_chunks; ++c) {
+            std::memcpy(*adj_data + chunk_offsets[c], chunk_data[c].data(), chunk_data[c].size());
+            const int64_t chunk_end = std::min(n, (c + 1) * kChunkSize);
+            for (int64_t v = c * kChunkSize; v < chunk_end; ++v) {
+                (*offsets)[v] += chunk_offsets[c];
+            }
+        }
+        (*offsets)[n] = chunk_offsets[num_chunks];
+    }
+};
+
+#endif //GRAPHSETS_COMPRESSED_REFERENCE_COMPRESSED_H
@@ -3,6 +3,7 @@
 #define GRAPHSETS_COMPRESSED_VARINT_WORD_BASED_H
 
 #include "coders-utils/varint_utils.h"
+#include <gms/representations/graphs/prefetch.h>
 
 
 class VarintWordBasedGraph {
@@ -193,6 +194,11 @@ public:
         return CompressedNeighbourhood(n, new_adj_data_in, new_offsets_in);
     }
 
+    /** The length of an encoded neighbourhood is not stored, so the first two cache lines are prefetched. */
+    void prefetch_neighbourhood(NodeId v) const {
+        GMS::Prefetch::prefetch_bytes(&new_adj_data_out[new_offsets_out[v] << 3], GMS::Prefetch::kCacheLineSize);
+    }
+
     void PrintStats() const {
         std::cout << "Varint byte-based graph has " << num_nodes() << " nodes and "
                   << num_edges() << " ";
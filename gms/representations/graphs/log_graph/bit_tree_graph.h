@@ -11,6 +11,7 @@
 #include "kbit_neighbourhood.h"
 #include <gms/third_party/gapbs/util.h>
 #include "bit_tree_neighbourhood.h"
+#include <gms/representations/graphs/prefetch.h>
 
 #define BYTE 8
 
@@ -126,6 +127,12 @@ class Bit_Tree_Graph {
 		}
 
 		void prefetch_neighbourhood(NodeId v) const{
+			if(encoding(v)){
+				GMS::Prefetch::prefetch_address(O[v].offset_or_tree.tree);
+				return;
+			}
+			int64_t ebo = O[v].offset_or_tree.offset;
+			GMS::Prefetch::prefetch_bytes((char*)adjacencyArray + (ebo >> 3), ((int64_t)O[v].degree*O[v].bitlength) >> 3);
 		}
 
 		bool encoding(NodeId v) const{
@@ -9,6 +9,7 @@
 
 #include "kbit_neighbourhood.h"
 #include <gms/third_party/gapbs/util.h>
+#include <gms/representations/graphs/prefetch.h>
 
 #define BYTE 8
 
@@ -129,6 +130,10 @@ class Kbit_Adjacency_Array_Local {
 		}
 
 		void prefetch_neighbourhood(NodeId v) const{
+			NodeId degree =    * (int32_t*) (O + 2 * v);
+			int8_t bitlength = *((int32_t*) (O + 2*v) + 1);
+			int64_t ebo =       * (int64_t*) (O + 2*v +1);
+			GMS::Prefetch::prefetch_bytes((char*)adjacencyArray + (ebo >> 3), ((int64_t)degree*bitlength) >> 3);
 		}
 
 		Kbit_Neighbourhood in_neigh(int64_t v) const {
@@ -15,6 +15,7 @@
 #include <gms/third_party/gapbs/sliding_queue.h>
 #include <gms/third_party/gapbs/timer.h>
 #include <gms/third_party/gapbs/util.h>
+#include "representation_registry.h"
 
 
 /*
@@ -44,10 +45,12 @@ propagation phase.
 
 
 using namespace std;
+using GMS::LogGraph::for_each_out_neigh;
 typedef float ScoreT;
 
 
-int calc_edge_position(const My_Graph &g, NodeId source_node) {
+template <class Graph>
+int calc_edge_position(const Graph &g, NodeId source_node) {
     int result = 0;
     for (NodeId v : g.vertices()) {
         if (v == source_node) break;
@@ -57,9 +60,20 @@ int calc_edge_position(const My_Graph &g, NodeId source_node) {
     return result;
 }
 
-void PBFS(const My_Graph &g, NodeId source, pvector<NodeId> &path_counts,
+// position of the first out-edge of u, only the compressed graphs have no offset array
+template <class Graph>
+int64_t edge_position(const Graph &g, NodeId u) {
+    if constexpr (GMS::LogGraph::has_edge_offsets<Graph>::value) {
+        return g.getOffset(u);
+    } else {
+        return calc_edge_position(g, u);
+    }
+}
+
+template <class Graph>
+void PBFS(const Graph &g, NodeId source, pvector<NodeId> &path_counts,
     Bitmap &succ, vector<SlidingQueue<NodeId>::iterator> &depth_index,
-    SlidingQueue<NodeId> &queue
+    SlidingQueue<NodeId> &queue, int64_t prefetch_distance
 	) {
   pvector<NodeId> depths(g.num_nodes(), -1);
   depths[source] = 0;
@@ -75,16 +89,13 @@ void PBFS(const My_Graph &g, NodeId source, pvector<NodeId> &path_counts,
       #pragma omp single
       depth_index.push_back(queue.begin());
       depth++;
+      auto frontier = GMS::prefetch_range(g, queue.begin(), queue.end(), prefetch_distance);
       #pragma omp for schedule(dynamic, 64)
-      for (auto q_iter = queue.begin(); q_iter < queue.end(); q_iter++) {
+      for (auto q_iter = frontier.begin(); q_iter < frontier.end(); q_iter++) {
         NodeId u = *q_iter;
-        #ifdef COMPRESSED
-            int64_t offset = calc_edge_position(g, u);
-        #else
-            int64_t offset = g.getOffset(u);
-        #endif
+        int64_t offset = edge_position(g, u);
         // for (NodeId v : g.out_neigh(u)) {
-	 	ITERATE_NEIGHBOURHOOD(v, u,
+	 	for_each_out_neigh(g, u, [&](NodeId v) {
           if ((depths[v] == -1) && (compare_and_swap(depths[v], -1, depth))) {
             lqueue.push_back(v);
           }
@@ -96,7 +107,7 @@ void PBFS(const My_Graph &g, NodeId source, pvector<NodeId> &path_counts,
             fetch_and_add(path_counts[v], path_counts[u]);
           }
           offset ++;
-        )
+        });
       }
       lqueue.flush();
       #pragma omp barrier
@@ -108,8 +119,9 @@ void PBFS(const My_Graph &g, NodeId source, pvector<NodeId> &path_counts,
 }
 
 
-pvector<ScoreT> Brandes(const My_Graph &g, SourcePicker<My_Graph> &sp,
-                        NodeId num_iters) {
+template <class Graph>
+pvector<ScoreT> Brandes(const Graph &g, SourcePicker<Graph> &sp,
+                        NodeId num_iters, int64_t prefetch_distance) {
 	#if PRINT_INFO
 		Timer t;
 		t.Start();
@@ -133,7 +145,7 @@ pvector<ScoreT> Brandes(const My_Graph &g, SourcePicker<My_Graph> &sp,
     depth_index.resize(0);
     queue.reset();
     succ.reset();
-    PBFS(g, source, path_counts, succ, depth_index, queue);
+    PBFS(g, source, path_counts, succ, depth_index, queue, prefetch_distance);
 	#if PRINT_INFO
 	    t.Stop();
 	    PrintStep("b", t.Seconds());
@@ -143,23 +155,20 @@ pvector<ScoreT> Brandes(const My_Graph &g, SourcePicker<My_Graph> &sp,
     	t.Start();
 	#endif
     for (int d=depth_index.size()-2; d >= 0; d--) {
+      auto level = GMS::prefetch_range(g, depth_index[d], depth_index[d+1], prefetch_distance);
       #pragma omp parallel for schedule(dynamic, 64)
-      for (auto it = depth_index[d]; it < depth_index[d+1]; it++) {
+      for (auto it = level.begin(); it < level.end(); it++) {
         NodeId u = *it;
         ScoreT delta_u = 0;
-        #ifdef COMPRESSED
-          int64_t offset = calc_edge_position(g, u);
-        #else
-          int64_t offset = g.getOffset(u);
-        #endif
+        int64_t offset = edge_position(g, u);
         // for (NodeId v : g.out_neigh(u)) {
-	 	ITERATE_NEIGHBOURHOOD(v, u,
+	 	for_each_out_neigh(g, u, [&](NodeId v) {
           if (succ.get_bit(offset)) {
             delta_u += static_cast<ScoreT>(path_counts[u]) /
                        static_cast<ScoreT>(path_counts[v]) * (1 + deltas[v]);
           }
           offset ++;
-        )
+        });
         deltas[u] = delta_u;
         scores[u] += delta_u;
       }
@@ -181,7 +190,8 @@ pvector<ScoreT> Brandes(const My_Graph &g, SourcePicker<My_Graph> &sp,
 }
 
 
-void PrintTopScores(const My_Graph &g, const pvector<ScoreT> &scores) {
+template <class Graph>
+void PrintTopScores(const Graph &g, const pvector<ScoreT> &scores) {
   vector<pair<NodeId, ScoreT>> score_pairs(g.num_nodes());
   for (NodeId n : g.vertices())
     score_pairs[n] = make_pair(n, scores[n]);
@@ -197,7 +207,8 @@ void PrintTopScores(const My_Graph &g, const pvector<ScoreT> &scores) {
 // - uses vector for BFS queue
 // - regenerates farthest to closest traversal order from depths
 // - regenerates successors from depths
-bool BCVerifier(const My_Graph &g, SourcePicker<My_Graph> &sp, NodeId num_iters,
+template <class Graph>
+bool BCVerifier(const Graph &g, SourcePicker<Graph> &sp, NodeId num_iters,
                 const pvector<ScoreT> &scores_to_test) {
   pvector<ScoreT> scores(g.num_nodes(), 0);
   for (int iter=0; iter < num_iters; iter++) {
@@ -213,14 +224,14 @@ bool BCVerifier(const My_Graph &g, SourcePicker<My_Graph> &sp, NodeId num_iters,
     for (auto it = to_visit.begin(); it != to_visit.end(); it++) {
       NodeId u = *it;
     //   for (NodeId v : g.out_neigh(u)) {
-	  ITERATE_NEIGHBOURHOOD(v, u,
+	  for_each_out_neigh(g, u, [&](NodeId v) {
         if (depths[v] == -1) {
           depths[v] = depths[u] + 1;
           to_visit.push_back(v);
         }
         if (depths[v] == depths[u] + 1)
           path_counts[v] += path_counts[u];
-      )
+      });
     }
     // Get lists of vertices at each depth
     vector<vector<NodeId>> verts_at_depth;
@@ -236,12 +247,12 @@ bool BCVerifier(const My_Graph &g, SourcePicker<My_Graph> &sp, NodeId num_iters,
     for (int depth=verts_at_depth.size()-1; depth >= 0; depth--) {
       for (NodeId u : verts_at_depth[depth]) {
         // for (NodeId v : g.out_neigh(u)) {
-	 	ITERATE_NEIGHBOURHOOD(v, u,
+	 	for_each_out_neigh(g, u, [&](NodeId v) {
           if (depths[v] == depths[u] + 1) {
             deltas[u] += static_cast<ScoreT>(path_counts[u]) /
                          static_cast<ScoreT>(path_counts[v]) * (1 + deltas[v]);
           }
-        )
+        });
         scores[u] += deltas[u];
       }
     }
@@ -263,27 +274,29 @@ bool BCVerifier(const My_Graph &g, SourcePicker<My_Graph> &sp, NodeId num_iters,
 
 
 int main(int argc, char* argv[]) {
-  CLIterApp cli(argc, argv, "betweenness-centrality", 1);
+  GMS::LogGraph::CLRepresentationApp<CLIterApp> cli(argc, argv, "betweenness-centrality", 1);
   if (!cli.ParseArgs())
     return -1;
   if (cli.num_iters() > 1 && cli.start_vertex() != -1)
     cout << "Warning: iterating from same source (-r & -i)" << endl;
   Builder b(cli);
-
-  // My_Graph g = b.make_graph();
-  My_Graph g = b.make_graph_from_CSR();
-
-  #if LOCAL_APPROACH
-    g.createOffsetArray();
-  #endif
-  SourcePicker<My_Graph> sp(g, cli.start_vertex());
-  auto BCBound =
-    [&sp, &cli] (const My_Graph &g) { return Brandes(g, sp, cli.num_iters()); };
-  SourcePicker<My_Graph> vsp(g, cli.start_vertex());
-  auto VerifierBound = [&vsp, &cli] (const My_Graph &g,
-                                     const pvector<ScoreT> &scores) {
-    return BCVerifier(g, vsp, cli.num_iters(), scores);
-  };
-  BenchmarkKernelLegacy(cli, g, BCBound, PrintTopScores, VerifierBound);
-  return 0;
+  CSRGraph csr = GMS::LogGraph::permute(b, b.MakeGraph(), cli.permuter());
+  return GMS::LogGraph::with_representation(cli.representation(), b, csr, [&cli] (auto &&g) {
+    using Graph = std::decay_t<decltype(g)>;
+    if constexpr (GMS::LogGraph::has_lazy_edge_offsets<Graph>::value) {
+      g.createOffsetArray();
+    }
+    int64_t prefetch_distance = GMS::LogGraph::prefetch_distance(g, cli.prefetch_distance());
+    SourcePicker<Graph> sp(g, cli.start_vertex());
+    auto BCBound = [&sp, &cli, prefetch_distance] (const Graph &g) {
+      return Brandes(g, sp, cli.num_iters(), prefetch_distance);
+    };
+    SourcePicker<Graph> vsp(g, cli.start_vertex());
+    auto VerifierBound = [&vsp, &cli] (const Graph &g,
+                                       const pvector<ScoreT> &scores) {
+      return BCVerifier(g, vsp, cli.num_iters(), scores);
+    };
+    BenchmarkKernelLegacy(cli, g, BCBound, PrintTopScores<Graph>, VerifierBound);
+    return 0;
+  });
 }
@@ -8,8 +8,7 @@
 #include <gms/third_party/gapbs/bitmap.h>
 #include <gms/third_party/gapbs/builder.h>
 #include <gms/third_party/gapbs/command_line.h>
-#include "kbit_adjacency_array.h"
-#include "kbit_adjacency_array_local.h"
+#include "representation_registry.h"
 #include <gms/third_party/gapbs/platform_atomics.h>
 #include <gms/third_party/gapbs/pvector.h>
 #include <gms/third_party/gapbs/sliding_queue.h>
@@ -43,41 +42,48 @@ them in parent array as negative numbers. Thus the encoding of parent is:
 
 
 using namespace std;
+using GMS::LogGraph::for_each_out_neigh;
 
-int64_t BUStep(const My_Graph &g, pvector<NodeId> &parent, Bitmap &front,
-			   Bitmap &next) {
+template <class Graph>
+int64_t BUStep(const Graph &g, pvector<NodeId> &parent, Bitmap &front,
+			   Bitmap &next, int64_t prefetch_distance) {
 	int64_t awake_count = 0;
 	next.reset();
 
+	auto vertices = GMS::prefetch_vertices(g, prefetch_distance);
 	#pragma omp parallel for reduction(+ : awake_count) schedule(dynamic, 1024)
-	for (NodeId u=0; u < g.num_nodes(); u++) {
+	for (auto u_iter = vertices.begin(); u_iter < vertices.end(); u_iter++) {
+		NodeId u = *u_iter;
 		if (parent[u] < 0) {
-			ITERATE_NEIGHBOURHOOD(v, u,
+			for_each_out_neigh(g, u, [&](NodeId v) {
 				if (front.get_bit(v)) {
 					parent[u] = v;
 					awake_count++;
 					next.set_bit(u);
-					break;
+					return false;
 				}
-			)
+				return true;
+			});
 		}
 	}
   return awake_count;
 }
 
-int64_t TDStep(const My_Graph &g, pvector<NodeId> &parent,
-			   SlidingQueue<NodeId> &queue) {
+template <class Graph>
+int64_t TDStep(const Graph &g, pvector<NodeId> &parent,
+			   SlidingQueue<NodeId> &queue, int64_t prefetch_distance) {
 	int64_t scout_count = 0;
+	auto frontier = GMS::prefetch_range(g, queue.begin(), queue.end(), prefetch_distance);
 
  	#pragma omp parallel
 	{
 	QueueBuffer<NodeId> lqueue(queue);
 
 	#pragma omp for reduction(+ : scout_count)
-	for (auto q_iter = queue.begin(); q_iter < queue.end(); q_iter++) {
+	for (auto q_iter = frontier.begin(); q_iter < frontier.end(); q_iter++) {
 		NodeId u = *q_iter;
      //  	for (NodeId v : g.in_neigh(u)) {
-	 	ITERATE_NEIGHBOURHOOD(v, u,
+	 	for_each_out_neigh(g, u, [&](NodeId v) {
 			NodeId curr_val = parent[v];
 			if (curr_val < 0) {
 		  		if (compare_and_swap(parent[v], curr_val, u)) {
@@ -85,7 +91,7 @@ int64_t TDStep(const My_Graph &g, pvector<NodeId> &parent,
 					scout_count += -curr_val;
 		  		}
 			}
-	  	)
+	  	});
 	}
 	lqueue.flush();
   }
@@ -100,7 +106,8 @@ void QueueToBitmap(const SlidingQueue<NodeId> &queue, Bitmap &bm) {
   }
 }
 
-void BitmapToQueue(const My_Graph &g, const Bitmap &bm,
+template <class Graph>
+void BitmapToQueue(const Graph &g, const Bitmap &bm,
 				   SlidingQueue<NodeId> &queue) {
   #pragma omp parallel
   {
@@ -114,7 +121,8 @@ void BitmapToQueue(const My_Graph &g, const Bitmap &bm,
   queue.slide_window();
 }
 
-pvector<NodeId> InitParent(const My_Graph &g) {
+template <class Graph>
+pvector<NodeId> InitParent(const Graph &g) {
   pvector<NodeId> parent(g.num_nodes());
   #pragma omp parallel for
   for (NodeId n=0; n < g.num_nodes(); n++)
@@ -122,8 +130,9 @@ pvector<NodeId> InitParent(const My_Graph &g) {
   return parent;
 }
 
-pvector<NodeId> DOBFS(const My_Graph &g, NodeId source, int alpha = 15,
-					  int beta = 18) {
+template <class Graph>
+pvector<NodeId> DOBFS(const Graph &g, NodeId source, int64_t prefetch_distance,
+					  int alpha = 15, int beta = 18) {
 
 	#if PRINT_INFO
 		Timer t;
@@ -162,7 +171,7 @@ pvector<NodeId> DOBFS(const My_Graph &g, NodeId source, int alpha = 15,
 					t.Start();
 				#endif
 				old_awake_count = awake_count;
-				awake_count = BUStep(g, parent, front, curr);
+				awake_count = BUStep(g, parent, front, curr, prefetch_distance);
 				front.swap(curr);
 				#if PRINT_INFO
 					t.Stop();
@@ -183,7 +192,7 @@ pvector<NodeId> DOBFS(const My_Graph &g, NodeId source, int alpha = 15,
 	  			t.Start();
 			#endif
 			edges_to_check -= scout_count;
-			scout_count = TDStep(g, parent, queue);
+			scout_count = TDStep(g, parent, queue, prefetch_distance);
 			queue.slide_window();
 			#if PRINT_INFO
 				t.Stop();
@@ -194,7 +203,8 @@ pvector<NodeId> DOBFS(const My_Graph &g, NodeId source, int alpha = 15,
 	return parent;
 }
 
-void PrintBFSStats(const My_Graph &g, const pvector<NodeId> &bfs_tree) {
+template <class Graph>
+void PrintBFSStats(const Graph &g, const pvector<NodeId> &bfs_tree) {
 	int64_t tree_size = 0;
 	int64_t n_edges = 0;
 	for (NodeId n : g.vertices()) {
@@ -213,7 +223,8 @@ void PrintBFSStats(const My_Graph &g, const pvector<NodeId> &bfs_tree) {
 // - parent[v] = u  =>  depth[v] = depth[u] + 1 (except for source)
 // - parent[v] = u  => there is edge from u to v
 // - all vertices reachable from source have a parent
-bool BFSVerifier(const My_Graph &g, NodeId source,
+template <class Graph>
+bool BFSVerifier(const Graph &g, NodeId source,
 				 const pvector<NodeId> &parent) {
 	pvector<int> depth(g.num_nodes(), -1);
 	depth[source] = 0;
@@ -222,12 +233,12 @@ bool BFSVerifier(const My_Graph &g, NodeId source,
 	to_visit.push_back(source);
 	for (auto it = to_visit.begin(); it != to_visit.end(); it++) {
 		NodeId u = *it;
-	 	ITERATE_NEIGHBOURHOOD(v, u,
+	 	for_each_out_neigh(g, u, [&](NodeId v) {
 		  	if (depth[v] == -1) {
 				depth[v] = depth[u] + 1;
 				to_visit.push_back(v);
 		  	}
-		)
+		});
 	}
 	for (NodeId u : g.vertices()) {
 		if ((depth[u] != -1) && (parent[u] != -1)) {
@@ -239,16 +250,21 @@ bool BFSVerifier(const My_Graph &g, NodeId source,
 				continue;
 	  		}
 		  	bool parent_found = false;
-			ITERATE_NEIGHBOURHOOD(v, u,
+		  	bool depths_ok = true;
+			for_each_out_neigh(g, u, [&](NodeId v) {
 				if (v == parent[u]) {
 			  		if (depth[v] != depth[u] - 1) {
 						cout << "Wrong depths for " << u << " & " << v << endl;
-						return false;
+						depths_ok = false;
 			  		}
 			  		parent_found = true;
-			  		break;
+			  		return false;
 				}
-			)
+				return true;
+			});
+			if (!depths_ok) {
+				return false;
+			}
 		  	if (!parent_found) {
 				cout << "Couldn't find edge from " << parent[u] << " to " << u << endl;
 				return false;
@@ -263,88 +279,25 @@ bool BFSVerifier(const My_Graph &g, NodeId source,
 }
 
 int main(int argc, char* argv[]) {
-  	CLApp cli(argc, argv, "breadth-first search");
+  	GMS::LogGraph::CLRepresentationApp<CLApp> cli(argc, argv, "breadth-first search");
   	if (!cli.ParseArgs()){
 		return -1;
 	}
 
 	Builder b(cli);
-	// Graph g = b.MakeGraph();
-	// My_Graph graph = b.csrToKbit(b.MakeGraph());
-	// My_Graph graph = b.csrToKbitLocal(b.MakeGraph());
-	// My_Graph graph = b.csrToMyGraph(b.MakeGraph());
-	My_Graph graph = b.make_graph_from_CSR();
-	// My_Graph graph = b.make_kbit_graph();
-	// cout << typeid(My_Graph).name() << endl;
-
-	// My_Graph graph = b.make_graph();
-	// for(int u = 0; u < g.num_nodes(); u++){
-	// 	cout << "u: ";
-	// 	for(NodeId v : g.out_neigh(u)){
-	// 		cout << v << " ";
-	// 	}
-	// 	cout << endl;
-	// }
-	// cout << endl;
-	// for(int u = 0; u < graph.num_nodes(); u++){
-	// 	cout << "u: ";
-	// 	for(NodeId v : graph.out_neigh(u)){
-	// 		cout << v << " ";
-	// 	}
-	// 	cout << endl;
-	// }
-	// int64_t total = 0;
-	// int64_t total_differences = 0;
-	// for(int u = 0; u < graph.num_nodes(); u++){
-	// 	if(graph.degree(u) == 0){
-	// 		continue;
-		// }
-	// 	int largest_in_neighbourhood = 0;
-	// 	int largest_difference = 0;
-	// 	int last = 0;
-	// 	for(NodeId v : graph.in_neigh(u)){
-	// 		if(v > largest_in_neighbourhood){
-	// 			largest_in_neighbourhood = v;
-	// 		}
-	// 		int diff = v-last;
-	// 		if(diff > largest_difference){
-	// 			largest_difference = diff;
-	// 		}
-	// 		last = v;
-	// 	}
-	// 	cout <<"largest valu " << largest_in_neighbourhood << endl;
-	// 	cout <<"largest diff " << largest_difference << endl;
-	// 	int a, b;
-	// 	if(largest_in_neighbourhood == 0){
-	// 		a = graph.degree(u)*1;
-	// 		b = graph.degree(u)*1;
-	// 	}
-	// 	else{
-	// 		a = graph.degree(u)*ceil(log2(largest_in_neighbourhood));
-	// 		b = graph.degree(u)*ceil(log2(largest_difference));
-	// 	}
-	// 	cout << graph.degree(u) <<  " neighbours" << endl ;
-	// 	cout <<"difference in bits here " << a-b << endl;
-	// 	total += a;
-	// 	total_differences += b;
-	// }
-	// cout <<"total bit difference " << total-total_differences << endl;
-	// int64_t size_in_bytes = total % 8 == 0 ? total/8 + 7 : total/8 + 8;
-	// cout << "space in bytes: " << size_in_bytes << endl;
-	// size_in_bytes = total_differences % 8 == 0 ? total_differences/8 + 7 : total_differences/8 + 8;
-	// cout << "space in bytes: " << size_in_bytes << endl;
-	//
-	// return 0;
-
-	SourcePicker<My_Graph> sp(graph, cli.start_vertex());
-	auto BFSBound = [&sp] (const My_Graph &graph) {
-		return DOBFS(graph, sp.PickNext());
-	};
-	SourcePicker<My_Graph> vsp(graph, cli.start_vertex());
-
-	auto VerifierBound = [&vsp] (const My_Graph &graph, const pvector<NodeId> &parent) {
-		  return BFSVerifier(graph, vsp.PickNext(), parent);
-	};
-	BenchmarkKernelLegacy(cli, graph, BFSBound, PrintBFSStats, VerifierBound);
-	return 0;
+	CSRGraph csr = GMS::LogGraph::permute(b, b.MakeGraph(), cli.permuter());
+	return GMS::LogGraph::with_representation(cli.representation(), b, csr, [&cli] (auto &&graph) {
+		using Graph = std::decay_t<decltype(graph)>;
+		int64_t prefetch_distance = GMS::LogGraph::prefetch_distance(graph, cli.prefetch_distance());
+		SourcePicker<Graph> sp(graph, cli.start_vertex());
+		auto BFSBound = [&sp, prefetch_distance] (const Graph &graph) {
+			return DOBFS(graph, sp.PickNext(), prefetch_distance);
+		};
+		SourcePicker<Graph> vsp(graph, cli.start_vertex());
+		auto VerifierBound = [&vsp] (const Graph &graph, const pvector<NodeId> &parent) {
+			return BFSVerifier(graph, vsp.PickNext(), parent);
+		};
+		BenchmarkKernelLegacy(cli, graph, BFSBound, PrintBFSStats<Graph>, VerifierBound);
+		return 0;
+	});
 }
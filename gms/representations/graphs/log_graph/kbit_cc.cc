@@ -14,7 +14,7 @@
 #include <gms/third_party/gapbs/graph.h>
 #include <gms/third_party/gapbs/pvector.h>
 #include <gms/third_party/gapbs/timer.h>
-#include "kbit_adjacency_array.h"
+#include "representation_registry.h"
 
 
 /*
@@ -37,28 +37,32 @@ implementation optimizations from Bader et al. [1].
 
 
 using namespace std;
+using GMS::LogGraph::for_each_out_neigh;
 
-pvector<NodeId> ShiloachVishkin(const My_Graph &g) {
+template <class Graph>
+pvector<NodeId> ShiloachVishkin(const Graph &g, int64_t prefetch_distance) {
   pvector<NodeId> comp(g.num_nodes());
   #pragma omp parallel for
   for (NodeId n=0; n < g.num_nodes(); n++)
     comp[n] = n;
+  auto vertices = GMS::prefetch_vertices(g, prefetch_distance);
   bool change = true;
   int num_iter = 0;
   while (change) {
     change = false;
     num_iter++;
     #pragma omp parallel for
-    for (NodeId u=0; u < g.num_nodes(); u++) {
+    for (auto u_iter = vertices.begin(); u_iter < vertices.end(); u_iter++) {
+      NodeId u = *u_iter;
       NodeId comp_u = comp[u];
     //   for (NodeId v : g.out_neigh(u)) {
-	  ITERATE_NEIGHBOURHOOD(v, u,
+	  for_each_out_neigh(g, u, [&](NodeId v) {
         NodeId comp_v = comp[v];
         if ((comp_u < comp_v) && (comp_v == comp[comp_v])) {
           change = true;
           comp[comp_v] = comp_u;
         }
-      )
+      });
     }
     #pragma omp parallel for
     for (NodeId n=0; n < g.num_nodes(); n++) {
@@ -74,7 +78,8 @@ pvector<NodeId> ShiloachVishkin(const My_Graph &g) {
 }
 
 
-void PrintCompStats(const My_Graph &g, const pvector<NodeId> &comp) {
+template <class Graph>
+void PrintCompStats(const Graph &g, const pvector<NodeId> &comp) {
   cout << endl;
   unordered_map<NodeId, NodeId> count;
   for (NodeId comp_i : comp)
@@ -97,7 +102,8 @@ void PrintCompStats(const My_Graph &g, const pvector<NodeId> &comp) {
 // - Asserts search does not reach a vertex with a different component label
 // - If the graph is directed, it performs the search as if it was undirected
 // - Asserts every vertex is visited (degree-0 vertex should have own label)
-bool CCVerifier(const My_Graph &g, const pvector<NodeId> &comp) {
+template <class Graph>
+bool CCVerifier(const Graph &g, const pvector<NodeId> &comp) {
   unordered_map<NodeId, NodeId> label_to_source;
   for (NodeId n : g.vertices())
     label_to_source[comp[n]] = n;
@@ -111,28 +117,28 @@ bool CCVerifier(const My_Graph &g, const pvector<NodeId> &comp) {
     frontier.clear();
     frontier.push_back(source);
     visited.set_bit(source);
-    for (auto it = frontier.begin(); it != frontier.end(); it++) {
-      NodeId u = *it;
+    bool labels_ok = true;
+    auto visit = [&](NodeId v) {
+      if (comp[v] != curr_label) {
+        labels_ok = false;
+        return false;
+      }
+      if (!visited.get_bit(v)) {
+        visited.set_bit(v);
+        frontier.push_back(v);
+      }
+      return true;
+    };
+    for (size_t i = 0; i < frontier.size(); i++) {
+      NodeId u = frontier[i];
     //   for (NodeId v : g.out_neigh(u)) {
-	  ITERATE_NEIGHBOURHOOD(v, u,
-        if (comp[v] != curr_label)
-          return false;
-        if (!visited.get_bit(v)) {
-          visited.set_bit(v);
-          frontier.push_back(v);
-        }
-      )
+      for_each_out_neigh(g, u, visit);
       if (g.directed()) {
         // for (NodeId v : g.in_neigh(u)) {
-	 	ITERATE_NEIGHBOURHOOD(v, u,
-          if (comp[v] != curr_label)
-            return false;
-          if (!visited.get_bit(v)) {
-            visited.set_bit(v);
-            frontier.push_back(v);
-          }
-        )
+        for_each_out_neigh(g, u, visit);
       }
+      if (!labels_ok)
+        return false;
     }
   }
   for (NodeId n=0; n < g.num_nodes(); n++)
@@ -143,12 +149,18 @@ bool CCVerifier(const My_Graph &g, const pvector<NodeId> &comp) {
 
 
 int main(int argc, char* argv[]) {
-  CLApp cli(argc, argv, "connected-components");
+  GMS::LogGraph::CLRepresentationApp<CLApp> cli(argc, argv, "connected-components");
   if (!cli.ParseArgs())
     return -1;
   Builder b(cli);
-  // My_Graph g = b.make_graph();
-  My_Graph g = b.make_graph_from_CSR();
-  BenchmarkKernelLegacy(cli, g, ShiloachVishkin, PrintCompStats, CCVerifier);
-  return 0;
+  CSRGraph csr = GMS::LogGraph::permute(b, b.MakeGraph(), cli.permuter());
+  return GMS::LogGraph::with_representation(cli.representation(), b, csr, [&cli] (auto &&g) {
+    using Graph = std::decay_t<decltype(g)>;
+    int64_t prefetch_distance = GMS::LogGraph::prefetch_distance(g, cli.prefetch_distance());
+    auto CCBound = [prefetch_distance] (const Graph &g) {
+      return ShiloachVishkin(g, prefetch_distance);
+    };
+    BenchmarkKernelLegacy(cli, g, CCBound, PrintCompStats<Graph>, CCVerifier<Graph>);
+    return 0;
+  });
 }
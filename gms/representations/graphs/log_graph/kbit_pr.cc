@@ -10,6 +10,7 @@
 #include <gms/third_party/gapbs/command_line.h>
 #include <gms/third_party/gapbs/graph.h>
 #include <gms/third_party/gapbs/pvector.h>
+#include "representation_registry.h"
 
 
 /*
@@ -27,28 +28,32 @@ updates in the pull direction to remove the need for atomics.
 
 
 using namespace std;
+using GMS::LogGraph::for_each_out_neigh;
 
 typedef float ScoreT;
 const float kDamp = 0.85;
 
-pvector<ScoreT> PageRankPull(const My_Graph &g, int max_iters,
+template <class Graph>
+pvector<ScoreT> PageRankPull(const Graph &g, int max_iters, int64_t prefetch_distance,
                              double epsilon = 0) {
   const ScoreT init_score = 1.0f / g.num_nodes();
   const ScoreT base_score = (1.0f - kDamp) / g.num_nodes();
   pvector<ScoreT> scores(g.num_nodes(), init_score);
   pvector<ScoreT> outgoing_contrib(g.num_nodes());
+  auto vertices = GMS::prefetch_vertices(g, prefetch_distance);
   for (int iter=0; iter < max_iters; iter++) {
     double error = 0;
     #pragma omp parallel for
     for (NodeId n=0; n < g.num_nodes(); n++)
       outgoing_contrib[n] = scores[n] / g.out_degree(n);
     #pragma omp parallel for reduction(+ : error) schedule(dynamic, 64)
-    for (NodeId u=0; u < g.num_nodes(); u++) {
+    for (auto u_iter = vertices.begin(); u_iter < vertices.end(); u_iter++) {
+      NodeId u = *u_iter;
       ScoreT incoming_total = 0;
     //   for (NodeId v : g.in_neigh(u))
-	  ITERATE_NEIGHBOURHOOD(v, u,
+	  for_each_out_neigh(g, u, [&](NodeId v) {
         incoming_total += outgoing_contrib[v];
-	  )
+	  });
       ScoreT old_score = scores[u];
       scores[u] = base_score + kDamp * incoming_total;
       error += fabs(scores[u] - old_score);
@@ -63,7 +68,8 @@ pvector<ScoreT> PageRankPull(const My_Graph &g, int max_iters,
 }
 
 
-void PrintTopScores(const My_Graph &g, const pvector<ScoreT> &scores) {
+template <class Graph>
+void PrintTopScores(const Graph &g, const pvector<ScoreT> &scores) {
   vector<pair<NodeId, ScoreT>> score_pairs(g.num_nodes());
   for (NodeId n=0; n < g.num_nodes(); n++) {
     score_pairs[n] = make_pair(n, scores[n]);
@@ -78,7 +84,8 @@ void PrintTopScores(const My_Graph &g, const pvector<ScoreT> &scores) {
 
 // Verifies by asserting a single serial iteration in push direction has
 //   error < target_error
-bool PRVerifier(const My_Graph &g, const pvector<ScoreT> &scores,
+template <class Graph>
+bool PRVerifier(const Graph &g, const pvector<ScoreT> &scores,
                         double target_error) {
   const ScoreT base_score = (1.0f - kDamp) / g.num_nodes();
   pvector<ScoreT> incomming_sums(g.num_nodes(), 0);
@@ -86,9 +93,9 @@ bool PRVerifier(const My_Graph &g, const pvector<ScoreT> &scores,
   for (NodeId u : g.vertices()) {
     ScoreT outgoing_contrib = scores[u] / g.out_degree(u);
     // for (NodeId v : g.out_neigh(u))
-	ITERATE_NEIGHBOURHOOD(v, u,
+	for_each_out_neigh(g, u, [&](NodeId v) {
       incomming_sums[v] += outgoing_contrib;
-    )
+    });
   }
   for (NodeId n : g.vertices()) {
     error += fabs(base_score + kDamp * incomming_sums[n] - scores[n]);
@@ -102,18 +109,21 @@ bool PRVerifier(const My_Graph &g, const pvector<ScoreT> &scores,
 
 
 int main(int argc, char* argv[]) {
-  CLPageRank cli(argc, argv, "pagerank", 1e-4, 20);
+  GMS::LogGraph::CLRepresentationApp<CLPageRank> cli(argc, argv, "pagerank", 1e-4, 20);
   if (!cli.ParseArgs())
     return -1;
   Builder b(cli);
-  My_Graph g = b.make_graph_from_CSR();
-  // My_Graph g = b.make_graph();
-  auto PRBound = [&cli] (const My_Graph &g) {
-    return PageRankPull(g, cli.max_iters(), cli.tolerance());
-  };
-  auto VerifierBound = [&cli] (const My_Graph &g, const pvector<ScoreT> &scores) {
-    return PRVerifier(g, scores, cli.tolerance());
-  };
-  BenchmarkKernelLegacy(cli, g, PRBound, PrintTopScores, VerifierBound);
-  return 0;
+  CSRGraph csr = GMS::LogGraph::permute(b, b.MakeGraph(), cli.permuter());
+  return GMS::LogGraph::with_representation(cli.representation(), b, csr, [&cli] (auto &&g) {
+    using Graph = std::decay_t<decltype(g)>;
+    int64_t prefetch_distance = GMS::LogGraph::prefetch_distance(g, cli.prefetch_distance());
+    auto PRBound = [&cli, prefetch_distance] (const Graph &g) {
+      return PageRankPull(g, cli.max_iters(), prefetch_distance, cli.tolerance());
+    };
+    auto VerifierBound = [&cli] (const Graph &g, const pvector<ScoreT> &scores) {
+      return PRVerifier(g, scores, cli.tolerance());
+    };
+    BenchmarkKernelLegacy(cli, g, PRBound, PrintTopScores<Graph>, VerifierBound);
+    return 0;
+  });
 }
@@ -14,6 +14,7 @@
 #include <gms/third_party/gapbs/platform_atomics.h>
 #include <gms/third_party/gapbs/pvector.h>
 #include <gms/third_party/gapbs/timer.h>
+#include "representation_registry.h"
 
 
 /*
@@ -51,7 +52,9 @@ using namespace std;
 
 const WeightT kDistInf = numeric_limits<WeightT>::max()/2;
 
-pvector<WeightT> DeltaStep(const My_Weighted_Graph &g, NodeId source, WeightT delta) {
+template <class Graph>
+pvector<WeightT> DeltaStep(const Graph &g, NodeId source, WeightT delta,
+                           int64_t prefetch_distance) {
   Timer t;
   pvector<WeightT> dist(g.num_nodes(), kDistInf);
   dist[source] = 0;
@@ -70,9 +73,11 @@ pvector<WeightT> DeltaStep(const My_Weighted_Graph &g, NodeId source, WeightT de
       size_t &next_bin_index = shared_indexes[(iter+1)&1];
       size_t &curr_frontier_tail = frontier_tails[iter&1];
       size_t &next_frontier_tail = frontier_tails[(iter+1)&1];
+      auto curr_frontier = GMS::prefetch_range(g, frontier.begin(), frontier.begin() + curr_frontier_tail,
+                                               prefetch_distance);
       #pragma omp for nowait schedule(dynamic, 64)
-      for (size_t i=0; i < curr_frontier_tail; i++) {
-        NodeId u = frontier[i];
+      for (auto f_iter = curr_frontier.begin(); f_iter < curr_frontier.end(); f_iter++) {
+        NodeId u = *f_iter;
         if (dist[u] >= delta * static_cast<WeightT>(curr_bin_index)) {
           for (Neighbour wn : g.out_neigh(u)) {
             WeightT old_dist = dist[wn.id];
@@ -134,7 +139,8 @@ pvector<WeightT> DeltaStep(const My_Weighted_Graph &g, NodeId source, WeightT de
 }
 
 
-void PrintSSSPStats(const My_Weighted_Graph &g, const pvector<WeightT> &dist) {
+template <class Graph>
+void PrintSSSPStats(const Graph &g, const pvector<WeightT> &dist) {
   auto NotInf = [](WeightT d) { return d != kDistInf; };
   int64_t num_reached = count_if(dist.begin(), dist.end(), NotInf);
   cout << "SSSP Tree reaches " << num_reached << " nodes" << endl;
@@ -142,7 +148,8 @@ void PrintSSSPStats(const My_Weighted_Graph &g, const pvector<WeightT> &dist) {
 
 
 // Compares against simple serial implementation
-bool SSSPVerifier(const My_Weighted_Graph &g, NodeId source,
+template <class Graph>
+bool SSSPVerifier(const Graph &g, NodeId source,
                   const pvector<WeightT> &dist_to_test) {
   // Serial Dijkstra implementation to get oracle distances
   pvector<WeightT> oracle_dist(g.num_nodes(), kDistInf);
@@ -176,20 +183,28 @@ bool SSSPVerifier(const My_Weighted_Graph &g, NodeId source,
 
 
 int main(int argc, char* argv[]) {
-  CLDelta cli(argc, argv, "single-source shortest-path");
+  GMS::LogGraph::CLRepresentationApp<CLDelta<WeightT>> cli(argc, argv, "single-source shortest-path");
   if (!cli.ParseArgs())
     return -1;
   WeightedBuilder b(cli);
-  My_Weighted_Graph g = b.make_weighted_graph_from_CSR();
-
-  SourcePicker<My_Weighted_Graph> sp(g, cli.start_vertex());
-  auto SSSPBound = [&sp, &cli] (const My_Weighted_Graph &g) {
-    return DeltaStep(g, sp.PickNext(), cli.delta());
-  };
-  SourcePicker<My_Weighted_Graph> vsp(g, cli.start_vertex());
-  auto VerifierBound = [&vsp] (const My_Weighted_Graph &g, const pvector<WeightT> &dist) {
-    return SSSPVerifier(g, vsp.PickNext(), dist);
-  };
-  BenchmarkKernelLegacy(cli, g, SSSPBound, PrintSSSPStats, VerifierBound);
-  return 0;
+  WGraph csr = GMS::LogGraph::permute(b, b.MakeGraph(), cli.permuter());
+  return GMS::LogGraph::with_weighted_representation(cli.representation(), b, csr, [&cli] (auto &&g) {
+    using Graph = std::decay_t<decltype(g)>;
+    int64_t prefetch_distance = GMS::LogGraph::prefetch_distance(g, cli.prefetch_distance(), [&g] (NodeId u) {
+      int64_t sum = 0;
+      for (Neighbour wn : g.out_neigh(u))
+        sum += wn.weight;
+      return sum;
+    });
+    SourcePicker<Graph> sp(g, cli.start_vertex());
+    auto SSSPBound = [&sp, &cli, prefetch_distance] (const Graph &g) {
+      return DeltaStep(g, sp.PickNext(), cli.delta(), prefetch_distance);
+    };
+    SourcePicker<Graph> vsp(g, cli.start_vertex());
+    auto VerifierBound = [&vsp] (const Graph &g, const pvector<WeightT> &dist) {
+      return SSSPVerifier(g, vsp.PickNext(), dist);
+    };
+    BenchmarkKernelLegacy(cli, g, SSSPBound, PrintSSSPStats<Graph>, VerifierBound);
+    return 0;
+  });
 }
@@ -9,7 +9,7 @@
 #include <gms/third_party/gapbs/benchmark.h>
 #include <gms/third_party/gapbs/builder.h>
 #include <gms/third_party/gapbs/command_line.h>
-#include "kbit_adjacency_array.h"
+#include "representation_registry.h"
 #include <gms/third_party/gapbs/pvector.h>
 
 
@@ -43,22 +43,23 @@ to relabel the graph, we use the heuristic in WorthRelabelling.
 
 
 using namespace std;
+using GMS::LogGraph::for_each_out_neigh;
 
-size_t OrderedCount(const My_Graph &g) {
+template <class Graph>
+size_t OrderedCount(const Graph &g) {
 	size_t total = 0;
 	#pragma omp parallel for reduction(+ : total) schedule(dynamic, 64)
 	for (NodeId u=0; u < g.num_nodes(); u++) {
 		// for (NodeId v : g.out_neigh(u)) {
-		ITERATE_NEIGHBOURHOOD(v, u,
+		for_each_out_neigh(g, u, [&](NodeId v) {
 			if (v > u){
-				break;
+				return false;
 			}
-			// auto it = g.out_neigh(u).begin();
-			ITERATE_NEIGHBOURHOOD_2(it, u,
+			auto it = g.out_neigh(u).begin();
 			// for (NodeId w : g.out_neigh(v)) {
-			ITERATE_NEIGHBOURHOOD(w, v,
+			for_each_out_neigh(g, v, [&](NodeId w) {
 				if (w > v){
-					break;
+					return false;
 				}
 				// This is an optimization that is needed because iterators
 				// here are not just memory addresses
@@ -72,9 +73,10 @@ size_t OrderedCount(const My_Graph &g) {
 				if (w == x){
 					total++;
 				}
-			)
-			)
-		)
+				return true;
+			});
+			return true;
+		});
 	}
 	return total;
 }
@@ -108,28 +110,30 @@ size_t OrderedCount(const My_Graph &g) {
 
 
 // uses heuristic to see if worth relabeling
-My_Graph relabelIfNecessary(const CSRGraph &g, Builder b){
+CSRGraph relabelIfNecessary(CSRGraph g){
     if (WorthRelabelling(g)){
-        return b.make_graph_from_CSR(Builder::RelabelByDegree(g));
+        return Builder::RelabelByDegree(g);
     }
     else {
-        return b.make_graph_from_CSR(g);
+        return g;
     }
 }
 
-void PrintTriangleStats(const My_Graph &g, size_t total_triangles) {
+template <class Graph>
+void PrintTriangleStats(const Graph &g, size_t total_triangles) {
   cout << total_triangles << " triangles" << endl;
 }
 
 // Compares with simple serial implementation that uses std::set_intersection
-bool TCVerifier(const My_Graph &g, size_t test_total) {
+template <class Graph>
+bool TCVerifier(const Graph &g, size_t test_total) {
   size_t total = 0;
   vector<NodeId> intersection;
   intersection.reserve(g.num_nodes());
   for (NodeId u : g.vertices()) {
     // for (NodeId v : g.out_neigh(u)) {
-	ITERATE_NEIGHBOURHOOD(v, u,
-      #if BIT_TREE
+	for_each_out_neigh(g, u, [&](NodeId v) {
+      if constexpr (GMS::LogGraph::is_bit_tree_v<Graph>) {
 		if(g.encoding(u) and g.encoding(v)) {
 	      auto new_end = set_intersection(g.bit_tree_neigh(u).begin(),
 	                                      g.bit_tree_neigh(u).end(),
@@ -162,16 +166,16 @@ bool TCVerifier(const My_Graph &g, size_t test_total) {
 	                                      intersection.begin());
       	  intersection.resize(new_end - intersection.begin());
 		}
-	  #else
+	  } else {
       auto new_end = set_intersection(g.out_neigh(u).begin(),
                                       g.out_neigh(u).end(),
                                       g.out_neigh(v).begin(),
                                       g.out_neigh(v).end(),
                                       intersection.begin());
       intersection.resize(new_end - intersection.begin());
-	  #endif
+	  }
       total += intersection.size();
-    )
+    });
   }
   total = total / 6;  // each triangle was counted 6 times
   if (total != test_total)
@@ -180,16 +184,20 @@ bool TCVerifier(const My_Graph &g, size_t test_total) {
 }
 
 int main(int argc, char* argv[]) {
-    CLApp cli(argc, argv, "triangle count");
+    GMS::LogGraph::CLRepresentationApp<CLApp> cli(argc, argv, "triangle count");
     if (!cli.ParseArgs())
         return -1;
     Builder b(cli);
-    // Kbit_Adjacency_Array g = relabelIfNecessary(b.MakeGraph(), b);
-    My_Graph g = relabelIfNecessary(b.MakeGraph(), b);
-    if (g.directed()) {
+    // an explicitly selected permuter replaces the degree relabelling heuristic
+    CSRGraph csr = cli.permuter() ? GMS::LogGraph::permute(b, b.MakeGraph(), cli.permuter())
+                                  : relabelIfNecessary(b.MakeGraph());
+    if (csr.directed()) {
         cout << "Input graph is directed but tc requires undirected" << endl;
         return -2;
     }
-    BenchmarkKernelLegacy(cli, g, OrderedCount, PrintTriangleStats, TCVerifier);
-    return 0;
+    return GMS::LogGraph::with_representation(cli.representation(), b, csr, [&cli] (auto &&g) {
+        using Graph = std::decay_t<decltype(g)>;
+        BenchmarkKernelLegacy(cli, g, OrderedCount<Graph>, PrintTriangleStats<Graph>, TCVerifier<Graph>);
+        return 0;
+    });
 }
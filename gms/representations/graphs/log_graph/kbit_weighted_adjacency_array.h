@@ -11,6 +11,7 @@
 
 #include "kbit_weighted_neighbourhood.h"
 #include <gms/third_party/gapbs/util.h>
+#include <gms/representations/graphs/prefetch.h>
 
 #define BYTE 8
 
@@ -104,6 +105,11 @@ class Kbit_Weighted_Adjacency_Array {
 			return false;
 		}
 
+		void prefetch_neighbourhood(NodeId v) const{
+			int64_t exactBitOffset = (k+w)*offsetArray[v];
+			GMS::Prefetch::prefetch_bytes((char*)adjacencyArray + (exactBitOffset >> 3), ((int64_t)degree(v)*(k+w)) >> 3);
+		}
+
 		Kbit_Weighted_Neighbourhood in_neigh(NodeId v) const {
 			return Kbit_Weighted_Neighbourhood(degree(v), (k+w)*offsetArray[v], adjacencyArray, k, w);
 		}
@@ -11,6 +11,7 @@
 
 #include "kbit_weighted_neighbourhood.h"
 #include <gms/third_party/gapbs/util.h>
+#include <gms/representations/graphs/prefetch.h>
 
 #define BYTE 8
 
@@ -98,6 +99,14 @@ class Kbit_Weighted_Adjacency_Array_Local {
 			return false;
 		}
 
+		void prefetch_neighbourhood(NodeId v) const{
+			NodeId degree =           * (int32_t*) (O + 2 * v);
+			int8_t id_bitlength =     *((int8_t*)  (O + 2*v) + 4);
+			int8_t weight_bitlength = *((int8_t*)  (O + 2*v) + 5);
+			int64_t ebo =             * (int64_t*) (O + 2*v + 1);
+			GMS::Prefetch::prefetch_bytes((char*)adjacencyArray + (ebo >> 3), ((int64_t)degree*(id_bitlength+weight_bitlength)) >> 3);
+		}
+
 		Kbit_Weighted_Neighbourhood in_neigh(NodeId v) const {
 			return out_neigh(v);
 		}
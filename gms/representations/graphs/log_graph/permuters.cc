@@ -0,0 +1,58 @@
+#include <iostream>
+#include <string>
+
+#include <gms/third_party/gapbs/benchmark.h>
+#include <gms/third_party/gapbs/builder.h>
+#include <gms/third_party/gapbs/command_line.h>
+#include <gms/third_party/gapbs/timer.h>
+#include <gms/representations/graphs/permuters/permuter_statistics.h>
+
+/*
+Compares the vertex permuters by their running time and by the gap statistics of the permuted graph:
+ - gap entropy: empirical entropy of the gaps between consecutive neighbours (bits per edge)
+ - log-gap bits per edge: the cost function minimized by recursive bisection
+ - varint bits per edge: size of the byte-based varint coder
+
+Every permuter prints one line:
+@@@ <permuter> <time> <gap entropy> <log-gap bits/edge> <varint bits/edge>
+*/
+
+using namespace std;
+
+void PrintGapStatistics(const string &name, double seconds, const GMS::Permuters::GapStatistics &stats) {
+    PrintTime(name + " Time", seconds);
+    printf("%-21s%3.5lf\n", "Gap Entropy:", stats.gap_entropy);
+    printf("%-21s%3.5lf\n", "Log-Gap Bits/Edge:", stats.log_gap_bits_per_edge);
+    printf("%-21s%3.5lf\n", "Varint Bits/Edge:", stats.varint_bits_per_edge);
+    PrintBenchmarkOutput("@@@", name, seconds, stats.gap_entropy, stats.log_gap_bits_per_edge,
+                         stats.varint_bits_per_edge);
+}
+
+template <PermuterVariant TVariant>
+void BenchmarkPermuter(Builder &b, CSRGraph &g, const string &name) {
+    Timer t;
+    t.Start();
+    pvector<NodeId> new_ids = b.permutation<TVariant>(g);
+    t.Stop();
+    CSRGraph permuted = Builder::RelabelByRanking(g, new_ids);
+    PrintGapStatistics(name, t.Seconds(), GMS::Permuters::gap_statistics(permuted));
+}
+
+int main(int argc, char* argv[]) {
+    CLApp cli(argc, argv, "permuters");
+    if (!cli.ParseArgs())
+        return -1;
+    Builder b(cli);
+    CSRGraph g = b.MakeGraph();
+    g.PrintStats();
+
+    PrintGapStatistics("Identity", 0.0, GMS::Permuters::gap_statistics(g));
+    BenchmarkPermuter<PermuterVariant::OutDegreeDescending>(b, g, "OutDegreeDescending");
+    BenchmarkPermuter<PermuterVariant::Bfs>(b, g, "Bfs");
+    BenchmarkPermuter<PermuterVariant::ReverseCuthillMcKee>(b, g, "ReverseCuthillMcKee");
+    BenchmarkPermuter<PermuterVariant::Gorder>(b, g, "Gorder");
+    BenchmarkPermuter<PermuterVariant::RabbitOrder>(b, g, "RabbitOrder");
+    BenchmarkPermuter<PermuterVariant::SlashBurn>(b, g, "SlashBurn");
+    BenchmarkPermuter<PermuterVariant::RecursiveBisection>(b, g, "RecursiveBisection");
+    return 0;
+}
@@ -0,0 +1,259 @@
+#ifndef REPRESENTATION_REGISTRY_H
+#define REPRESENTATION_REGISTRY_H
+
+#include <iostream>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gms/common/types.h>
+#include <gms/third_party/gapbs/builder.h>
+#include <gms/third_party/gapbs/command_line.h>
+#include <gms/third_party/gapbs/util.h>
+
+#include "bit_tree_graph.h"
+#include "kbit_adjacency_array.h"
+#include "kbit_adjacency_array_local.h"
+#include "kbit_weighted_adjacency_array.h"
+#include "kbit_weighted_adjacency_array_local.h"
+#include <gms/representations/graphs/coders/varint_byte_based_graph.h>
+#include <gms/representations/graphs/coders/varint_word_based_graph.h>
+#include <gms/representations/graphs/coders/reference_compressed_graph.h>
+#include <gms/representations/graphs/permuters/permuter_registry.h>
+#include <gms/representations/graphs/prefetch.h>
+
+/*
+Runtime selection of the Log(Graph) representation and vertex permuter.
+
+Every Log(Graph) kernel is a single binary. The representation (-R) and the permuter (-P) are chosen on the
+command line; the kernel is still compiled once per representation as a fully specialized template
+instantiation, i.e. there is no virtual dispatch in the inner loops:
+
+    CLRepresentationApp<CLApp> cli(argc, argv, "breadth-first search");
+    ...
+    CSRGraph csr = GMS::LogGraph::permute(b, b.MakeGraph(), cli.permuter());
+    return GMS::LogGraph::with_representation(cli.representation(), b, csr, [&](auto &&g) { ... });
+*/
+
+namespace GMS::LogGraph {
+
+enum struct Representation {
+    Kbit,
+    KbitLocal,
+    BitTree,
+    VarintByteBased,
+    VarintWordBased,
+    ReferenceCompressed,
+};
+
+inline const std::vector<std::pair<std::string, Representation>> &representation_names()
+{
+    static const std::vector<std::pair<std::string, Representation>> names = {
+        {"kbit", Representation::Kbit},
+        {"kbit_local", Representation::KbitLocal},
+        {"bit_tree", Representation::BitTree},
+        {"varint_byte_based", Representation::VarintByteBased},
+        {"varint_word_based", Representation::VarintWordBased},
+        {"reference", Representation::ReferenceCompressed},
+    };
+    return names;
+}
+
+using Permuters::permuter_names;
+using Permuters::find_by_name;
+using Permuters::joined_names;
+
+/**
+ * Adds the options -R <representation> and -P <permuter> to one of the gapbs command line classes,
+ * e.g. CLRepresentationApp<CLApp> or CLRepresentationApp<CLPageRank>.
+ */
+template <class CLBaseApp>
+class CLRepresentationApp : public CLBaseApp {
+    std::string representation_name_ = "kbit";
+    std::string permuter_name_ = "none";
+    Representation representation_ = Representation::Kbit;
+    std::optional<PermuterVariant> permuter_;
+    int64_t prefetch_distance_ = GMS::Prefetch::kDefaultDistance;
+
+public:
+    template <class... Args>
+    CLRepresentationApp(int argc, char** argv, std::string name, Args... args) :
+        CLBaseApp(argc, argv, name, args...) {
+        this->get_args_ += "R:P:D:";
+        this->AddHelpLine('R', "repr", "graph representation", representation_name_);
+        this->AddHelpLine('P', "perm", "vertex permuter", permuter_name_);
+        this->AddHelpLine('D', "dist", "prefetch distance (0: off, -1: calibrate)", std::to_string(prefetch_distance_));
+    }
+
+    void HandleArg(signed char opt, char* opt_arg) override {
+        switch (opt) {
+            case 'R': representation_name_ = std::string(opt_arg);    break;
+            case 'P': permuter_name_ = std::string(opt_arg);          break;
+            case 'D': prefetch_distance_ = atol(opt_arg);             break;
+            default: CLBaseApp::HandleArg(opt, opt_arg);
+        }
+    }
+
+    bool ParseArgs() {
+        if (!CLBaseApp::ParseArgs())
+            return false;
+        auto representation = find_by_name(representation_names(), representation_name_);
+        if (!representation) {
+            std::cout << "Unknown representation " << representation_name_ << " (available: "
+                      << joined_names(representation_names()) << ")" << std::endl;
+            return false;
+        }
+        representation_ = *representation;
+        if (permuter_name_ != "none") {
+            permuter_ = find_by_name(permuter_names(), permuter_name_);
+            if (!permuter_) {
+                std::cout << "Unknown permuter " << permuter_name_ << " (available: none, "
+                          << joined_names(permuter_names()) << ")" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Representation representation() const { return representation_; }
+    std::optional<PermuterVariant> permuter() const { return permuter_; }
+    int64_t prefetch_distance() const { return prefetch_distance_; }
+};
+
+/**
+ * Relabels the graph with the given permuter, or returns it unchanged if no permuter is selected.
+ */
+template <class Builder, class CSR>
+CSR permute(Builder &b, CSR graph, std::optional<PermuterVariant> variant)
+{
+    if (!variant) {
+        return graph;
+    }
+    return b.RelabelByRanking(graph, Permuters::permutation(b, graph, *variant));
+}
+
+/**
+ * Builds the selected representation from the CSR graph and calls kernel(graph) with it.
+ * The kernel is a generic lambda, which is instantiated once for every representation.
+ */
+template <class Builder, class CSR, class Kernel>
+int with_representation(Representation representation, Builder &b, const CSR &csr, Kernel &&kernel)
+{
+    switch (representation) {
+        case Representation::Kbit:
+            return kernel(b.template csrToCGraphGeneric<Kbit_Adjacency_Array>(csr));
+        case Representation::KbitLocal:
+            return kernel(b.template csrToCGraphGeneric<Kbit_Adjacency_Array_Local>(csr));
+        case Representation::BitTree:
+            return kernel(b.template csrToCGraphGeneric<Bit_Tree_Graph>(csr));
+        case Representation::VarintByteBased:
+            return kernel(b.template csrToCGraphGeneric<VarintByteBasedGraph>(csr));
+        case Representation::VarintWordBased:
+            return kernel(b.template csrToCGraphGeneric<VarintWordBasedGraph>(csr));
+        case Representation::ReferenceCompressed:
+            return kernel(b.template csrToCGraphGeneric<ReferenceCompressedGraph>(csr));
+    }
+    return -1;
+}
+
+/**
+ * Weighted counterpart of with_representation, only the k-bit representations store weights.
+ */
+template <class Builder, class CSR, class Kernel>
+int with_weighted_representation(Representation representation, Builder &b, const CSR &csr, Kernel &&kernel)
+{
+    switch (representation) {
+        case Representation::Kbit:
+            return kernel(b.template csrToCGraphGeneric<Kbit_Weighted_Adjacency_Array>(csr));
+        case Representation::KbitLocal:
+            return kernel(b.template csrToCGraphGeneric<Kbit_Weighted_Adjacency_Array_Local>(csr));
+        default:
+            std::cout << "The representation does not support weighted graphs (available: kbit, kbit_local)"
+                      << std::endl;
+            return -1;
+    }
+}
+
+template <class Graph>
+struct is_bit_tree : std::false_type {};
+
+template <>
+struct is_bit_tree<Bit_Tree_Graph> : std::true_type {};
+
+template <class Graph>
+constexpr bool is_bit_tree_v = is_bit_tree<std::decay_t<Graph>>::value;
+
+/** Whether the representation stores per-vertex edge offsets (getOffset), e.g. for the successor bitmap of bc. */
+template <class Graph, class = void>
+struct has_edge_offsets : std::false_type {};
+
+template <class Graph>
+struct has_edge_offsets<Graph, std::void_t<decltype(std::declval<const Graph&>().getOffset(0))>> : std::true_type {};
+
+/** Whether the edge offsets have to be created explicitly (createOffsetArray), which is the case for the local approaches. */
+template <class Graph, class = void>
+struct has_lazy_edge_offsets : std::false_type {};
+
+template <class Graph>
+struct has_lazy_edge_offsets<Graph, std::void_t<decltype(std::declval<Graph&>().createOffsetArray())>> : std::true_type {};
+
+/**
+ * Calls f(v) for every out-neighbour v of u. If f returns a bool, the iteration stops as soon as it returns false.
+ * Bit tree encoded neighbourhoods of a Bit_Tree_Graph are iterated with their own iterator.
+ */
+template <class Graph, class F>
+inline void for_each_out_neigh(const Graph &g, NodeId u, F &&f)
+{
+    auto visit = [&f](NodeId v) {
+        if constexpr (std::is_void_v<std::invoke_result_t<F&, NodeId>>) {
+            f(v);
+            return true;
+        } else {
+            return static_cast<bool>(f(v));
+        }
+    };
+    if constexpr (is_bit_tree_v<Graph>) {
+        if (g.encoding(u)) {
+            for (NodeId v : g.bit_tree_neigh(u)) {
+                if (!visit(v)) return;
+            }
+            return;
+        }
+    }
+    for (NodeId v : g.out_neigh(u)) {
+        if (!visit(v)) return;
+    }
+}
+
+/**
+ * Returns the prefetch distance for the kernels on g. The distance kAutoDistance is calibrated on g with
+ * visit(u), which traverses the neighbourhood of u the way the kernel does.
+ */
+template <class Graph, class Visit>
+int64_t prefetch_distance(const Graph &g, int64_t distance, Visit &&visit)
+{
+    if (distance == GMS::Prefetch::kAutoDistance) {
+        distance = GMS::Prefetch::calibrate_distance(g, visit);
+    }
+    PrintLabel("Prefetch Distance", std::to_string(distance));
+    return distance;
+}
+
+/**
+ * Calibrates with a traversal through for_each_out_neigh, so that bit tree encoded neighbourhoods are timed as well.
+ */
+template <class Graph>
+int64_t prefetch_distance(const Graph &g, int64_t distance)
+{
+    return prefetch_distance(g, distance, [&g](NodeId u) {
+        int64_t sum = 0;
+        for_each_out_neigh(g, u, [&sum](NodeId v) { sum += v; });
+        return sum;
+    });
+}
+
+} // namespace GMS::LogGraph
+
+#endif //REPRESENTATION_REGISTRY_H
@@ -0,0 +1,154 @@
+#ifndef BFS_PERMUTER_H
+#define BFS_PERMUTER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <parallel/algorithm>
+#include <vector>
+
+#include <gms/third_party/gapbs/platform_atomics.h>
+
+#include "permuter_util.h"
+
+namespace GMS::Permuters {
+
+/**
+ * Level-synchronous parallel breadth-first traversal which numbers the vertices in the order they are visited.
+ *
+ * Every connected component is started from its vertex of minimum degree (a cheap pseudo-peripheral vertex).
+ * An unvisited vertex is claimed by the frontier vertex with the smallest position (atomic min), so the visiting
+ * order is the same as the one of a sequential BFS and doesn't depend on the number of threads.
+ * If SortByDegree is set, the children of every frontier vertex are sorted by ascending degree, which results in the
+ * Cuthill-McKee order.
+ *
+ * Works for every graph type with `num_nodes()`, `out_degree(v)` and iterable `out_neigh(v)`.
+ *
+ * @param order Output, order[i] = i-th visited vertex.
+ */
+template <bool SortByDegree, class Graph, class Order>
+void breadth_first_order(const Graph &graph, Order &order)
+{
+    using NodeId_ = typename std::decay<decltype(*graph.out_neigh(0).begin())>::type;
+    const int64_t n = graph.num_nodes();
+    order.resize(n);
+    if (n == 0) {
+        return;
+    }
+
+    auto by_degree = [&graph](NodeId_ a, NodeId_ b) {
+        int64_t da = graph.out_degree(a);
+        int64_t db = graph.out_degree(b);
+        return da < db || (da == db && a < b);
+    };
+
+    std::vector<NodeId_> starts(n);
+    std::iota(starts.begin(), starts.end(), 0);
+#ifdef _OPENMP
+    __gnu_parallel::sort(starts.begin(), starts.end(), by_degree);
+#else
+    std::sort(starts.begin(), starts.end(), by_degree);
+#endif
+
+    constexpr int64_t unclaimed = std::numeric_limits<int64_t>::max();
+    std::vector<int64_t> claim(n, unclaimed);
+    std::vector<uint8_t> visited(n, 0);
+    std::vector<int64_t> offsets;
+    int64_t num_ordered = 0;
+
+    for (NodeId_ start : starts) {
+        if (visited[start]) {
+            continue;
+        }
+        visited[start] = 1;
+        order[num_ordered] = start;
+        int64_t frontier_begin = num_ordered++;
+        int64_t frontier_end = num_ordered;
+
+        while (frontier_begin < frontier_end) {
+            const int64_t frontier_size = frontier_end - frontier_begin;
+
+            // Each unvisited vertex is claimed by its first parent in the frontier.
+            #pragma omp parallel for schedule(dynamic, 64) if (frontier_size > 256)
+            for (int64_t i = 0; i < frontier_size; ++i) {
+                for (NodeId_ w : graph.out_neigh(order[frontier_begin + i])) {
+                    if (visited[w]) {
+                        continue;
+                    }
+                    int64_t old_claim = claim[w];
+                    while (i < old_claim && !compare_and_swap(claim[w], old_claim, i)) {
+                        old_claim = claim[w];
+                    }
+                }
+            }
+
+            offsets.assign(frontier_size + 1, 0);
+            #pragma omp parallel for schedule(dynamic, 64) if (frontier_size > 256)
+            for (int64_t i = 0; i < frontier_size; ++i) {
+                int64_t count = 0;
+                for (NodeId_ w : graph.out_neigh(order[frontier_begin + i])) {
+                    count += (!visited[w] && claim[w] == i);
+                }
+                offsets[i + 1] = count;
+            }
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            #pragma omp parallel for schedule(dynamic, 64) if (frontier_size > 256)
+            for (int64_t i = 0; i < frontier_size; ++i) {
+                int64_t pos = frontier_end + offsets[i];
+                for (NodeId_ w : graph.out_neigh(order[frontier_begin + i])) {
+                    if (!visited[w] && claim[w] == i) {
+                        order[pos++] = w;
+                    }
+                }
+                if constexpr (SortByDegree) {
+                    std::sort(order.begin() + frontier_end + offsets[i], order.begin() + pos, by_degree);
+                }
+            }
+
+            // A claimed vertex becomes visited, hence claims never have to be reset.
+            const int64_t next_end = frontier_end + offsets[frontier_size];
+            #pragma omp parallel for schedule(static) if (next_end - frontier_end > 4096)
+            for (int64_t j = frontier_end; j < next_end; ++j) {
+                visited[order[j]] = 1;
+            }
+
+            frontier_begin = frontier_end;
+            frontier_end = next_end;
+        }
+        num_ordered = frontier_end;
+    }
+}
+
+} // namespace GMS::Permuters
+
+/**
+ * Breadth-first ordering: neighbouring vertices get close ids.
+ */
+template <class NodeId_, class DestID_, bool invert>
+class BfsPermuter {
+
+public:
+
+    /**
+     * Computes the BFS ranking, i.e. new_ids[v] is the new id of vertex v.
+     * Can also be used directly on a SetGraph as a preprocessing ordering in rank format.
+     */
+    template <class Graph, class Output = std::vector<NodeId_>>
+    static void ranking(const Graph &graph, Output &new_ids) {
+        std::vector<NodeId_> order;
+        GMS::Permuters::breadth_first_order<false>(graph, order);
+        GMS::Permuters::order_to_ranking(order, new_ids);
+    }
+
+    static std::map<NodeId_, NodeId_> permutation_map(CSRGraphBase<NodeId_, DestID_, invert>& graph) {
+        std::vector<NodeId_> new_ids;
+        ranking(graph, new_ids);
+        return GMS::Permuters::ranking_to_map<NodeId_>(new_ids);
+    }
+};
+
+
+#endif //BFS_PERMUTER_H
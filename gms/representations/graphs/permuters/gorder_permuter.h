@@ -0,0 +1,179 @@
+#ifndef GORDER_PERMUTER_H
+#define GORDER_PERMUTER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <vector>
+
+#include "permuter_util.h"
+
+namespace GMS::Permuters {
+
+/**
+ * Max-priority queue over the vertices with integer keys which are only changed by +1 / -1 (the "unit heap" of
+ * Gorder). Every key has a doubly linked list of vertices, so increment, decrement and pop-max are O(1) amortized.
+ */
+class UnitHeap
+{
+public:
+    static constexpr int64_t none = -1;
+
+    /**
+     * @param insertion_order All vertices, the last one is popped first among vertices with the same key.
+     */
+    template <class Order>
+    UnitHeap(const Order &insertion_order) :
+        key(insertion_order.size(), 0), prev(insertion_order.size(), none), next(insertion_order.size(), none),
+        head(1, none), top(0), size(insertion_order.size())
+    {
+        for (auto v : insertion_order) {
+            push_front(v, 0);
+        }
+    }
+
+    bool empty() const { return size == 0; }
+
+    void increment(int64_t v) {
+        unlink(v);
+        if (++key[v] == (int64_t) head.size()) {
+            head.push_back(none);
+        }
+        push_front(v, key[v]);
+        top = std::max(top, key[v]);
+    }
+
+    void decrement(int64_t v) {
+        unlink(v);
+        push_front(v, --key[v]);
+    }
+
+    int64_t pop_max() {
+        while (head[top] == none) {
+            --top;
+        }
+        int64_t v = head[top];
+        unlink(v);
+        key[v] = removed;
+        --size;
+        return v;
+    }
+
+    bool contains(int64_t v) const { return key[v] != removed; }
+
+private:
+    static constexpr int64_t removed = -1;
+
+    std::vector<int64_t> key, prev, next, head;
+    int64_t top;
+    int64_t size;
+
+    void push_front(int64_t v, int64_t k) {
+        prev[v] = none;
+        next[v] = head[k];
+        if (head[k] != none) {
+            prev[head[k]] = v;
+        }
+        head[k] = v;
+    }
+
+    void unlink(int64_t v) {
+        if (prev[v] != none) {
+            next[prev[v]] = next[v];
+        } else {
+            head[key[v]] = next[v];
+        }
+        if (next[v] != none) {
+            prev[next[v]] = prev[v];
+        }
+    }
+};
+
+/**
+ * Gorder (Wei et al., SIGMOD 2016): greedily appends the vertex which maximizes the number of neighbours plus the
+ * number of common neighbours with the last `window` placed vertices.
+ *
+ * Neighbourhoods of hubs (degree > sqrt(n)) are skipped when counting common neighbours, as in the original
+ * implementation. The greedy selection is inherently sequential.
+ *
+ * @param order Output, order[i] = i-th vertex.
+ */
+template <class Graph, class Order>
+void gorder(const Graph &graph, Order &order, int64_t window = 5)
+{
+    const int64_t n = graph.num_nodes();
+    order.resize(n);
+    if (n == 0) {
+        return;
+    }
+    const int64_t hub_degree = std::sqrt((double) n);
+
+    std::vector<int64_t> by_degree(n);
+    std::iota(by_degree.begin(), by_degree.end(), 0);
+    std::stable_sort(by_degree.begin(), by_degree.end(),
+                     [&graph](int64_t a, int64_t b) { return graph.out_degree(a) < graph.out_degree(b); });
+
+    // Vertices with the same score are taken by descending degree.
+    UnitHeap heap(by_degree);
+
+    auto update = [&](int64_t u, bool enters) {
+        auto change = [&](int64_t v) {
+            if (heap.contains(v)) {
+                enters ? heap.increment(v) : heap.decrement(v);
+            }
+        };
+        for (auto x : graph.out_neigh(u)) {
+            change(x);
+            if ((int64_t) graph.out_degree(x) > hub_degree) {
+                continue;
+            }
+            for (auto v : graph.out_neigh(x)) {
+                if ((int64_t) v != u) {
+                    change(v);
+                }
+            }
+        }
+    };
+
+    for (int64_t i = 0; i < n; ++i) {
+        if (i > window) {
+            update(order[i - window - 1], false);
+        }
+        order[i] = heap.pop_max();
+        update(order[i], true);
+    }
+}
+
+} // namespace GMS::Permuters
+
+
+/**
+ * Gorder: places vertices sharing many neighbours into the same cache lines.
+ */
+template <class NodeId_, class DestID_, bool invert>
+class GorderPermuter {
+
+public:
+
+    /**
+     * Computes the Gorder ranking, i.e. new_ids[v] is the new id of vertex v.
+     * Can also be used directly on a SetGraph as a preprocessing ordering in rank format.
+     */
+    template <class Graph, class Output = std::vector<NodeId_>>
+    static void ranking(const Graph &graph, Output &new_ids) {
+        std::vector<NodeId_> order;
+        GMS::Permuters::gorder(graph, order);
+        GMS::Permuters::order_to_ranking(order, new_ids);
+    }
+
+    static std::map<NodeId_, NodeId_> permutation_map(CSRGraphBase<NodeId_, DestID_, invert>& graph) {
+        std::vector<NodeId_> new_ids;
+        ranking(graph, new_ids);
+        return GMS::Permuters::ranking_to_map<NodeId_>(new_ids);
+    }
+};
+
+
+#endif //GORDER_PERMUTER_H
@@ -0,0 +1,127 @@
+#ifndef PERMUTER_REGISTRY_H
+#define PERMUTER_REGISTRY_H
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gms/third_party/gapbs/pvector.h>
+#include <gms/representations/graphs/permuters/permuters.h>
+
+// Runtime selection of the vertex permuters by name, shared by the Log(Graph) kernels (-P) and the relabeling
+// stage of the GMS command line (--relabel).
+namespace GMS::Permuters {
+
+inline const std::vector<std::pair<std::string, PermuterVariant>> &permuter_names()
+{
+    static const std::vector<std::pair<std::string, PermuterVariant>> names = {
+        {"in_degree_ascending", PermuterVariant::InDegreeAscending},
+        {"in_degree_descending", PermuterVariant::InDegreeDescending},
+        {"out_degree_ascending", PermuterVariant::OutDegreeAscending},
+        {"out_degree_descending", PermuterVariant::OutDegreeDescending},
+        {"bfs", PermuterVariant::Bfs},
+        {"rcm", PermuterVariant::ReverseCuthillMcKee},
+        {"gorder", PermuterVariant::Gorder},
+        {"rabbit_order", PermuterVariant::RabbitOrder},
+        {"slashburn", PermuterVariant::SlashBurn},
+        {"recursive_bisection", PermuterVariant::RecursiveBisection},
+#ifdef CPLEX_ENABLED
+        {"optimal_diff_nn_ilp_unconstr", PermuterVariant::OptimalDiffNnIlpUnconstr},
+        {"optimal_diff_nn_lp_unconstr", PermuterVariant::OptimalDiffNnLpUnconstr},
+        {"optimal_diff_nn_ilp_constr", PermuterVariant::OptimalDiffNnIlpConstr},
+        {"optimal_diff_nn_lp_constr", PermuterVariant::OptimalDiffNnLpConstr},
+        {"optimal_diff_vn_ilp_unconstr", PermuterVariant::OptimalDiffVnIlpUnconstr},
+        {"optimal_diff_vn_lp_unconstr", PermuterVariant::OptimalDiffVnLpUnconstr},
+        {"optimal_diff_vn_ilp_constr", PermuterVariant::OptimalDiffVnIlpConstr},
+        {"optimal_diff_vn_lp_constr", PermuterVariant::OptimalDiffVnLpConstr},
+        {"o_ilp_nn_un_n", PermuterVariant::OIlpNnUnN},
+        {"o_ilp_nn_con_n", PermuterVariant::OIlpNnConN},
+        {"o_ilp_vn_un_n", PermuterVariant::OIlpVnUnN},
+        {"o_ilp_vn_con_n", PermuterVariant::OIlpVnConN},
+#endif
+    };
+    return names;
+}
+
+template <class Value>
+std::optional<Value> find_by_name(const std::vector<std::pair<std::string, Value>> &names, const std::string &name)
+{
+    for (const auto &[key, value] : names) {
+        if (key == name) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+template <class Value>
+std::string joined_names(const std::vector<std::pair<std::string, Value>> &names)
+{
+    std::string result;
+    for (const auto &entry : names) {
+        result += (result.empty() ? "" : ", ") + entry.first;
+    }
+    return result;
+}
+
+/**
+ * Computes the permutation of the given variant with the builder, new_ids[v] is the new id of vertex v.
+ */
+template <class Builder, class CSR>
+auto permutation(Builder &b, CSR &graph, PermuterVariant variant)
+{
+    switch (variant) {
+        case PermuterVariant::OutDegreeAscending:
+            return b.template permutation<PermuterVariant::OutDegreeAscending>(graph);
+        case PermuterVariant::OutDegreeDescending:
+            return b.template permutation<PermuterVariant::OutDegreeDescending>(graph);
+        case PermuterVariant::InDegreeAscending:
+            return b.template permutation<PermuterVariant::InDegreeAscending>(graph);
+        case PermuterVariant::InDegreeDescending:
+            return b.template permutation<PermuterVariant::InDegreeDescending>(graph);
+        case PermuterVariant::Bfs:
+            return b.template permutation<PermuterVariant::Bfs>(graph);
+        case PermuterVariant::ReverseCuthillMcKee:
+            return b.template permutation<PermuterVariant::ReverseCuthillMcKee>(graph);
+        case PermuterVariant::Gorder:
+            return b.template permutation<PermuterVariant::Gorder>(graph);
+        case PermuterVariant::RabbitOrder:
+            return b.template permutation<PermuterVariant::RabbitOrder>(graph);
+        case PermuterVariant::SlashBurn:
+            return b.template permutation<PermuterVariant::SlashBurn>(graph);
+        case PermuterVariant::RecursiveBisection:
+            return b.template permutation<PermuterVariant::RecursiveBisection>(graph);
+#ifdef CPLEX_ENABLED
+        case PermuterVariant::OptimalDiffNnIlpUnconstr:
+            return b.template permutation<PermuterVariant::OptimalDiffNnIlpUnconstr>(graph);
+        case PermuterVariant::OptimalDiffNnLpUnconstr:
+            return b.template permutation<PermuterVariant::OptimalDiffNnLpUnconstr>(graph);
+        case PermuterVariant::OptimalDiffNnIlpConstr:
+            return b.template permutation<PermuterVariant::OptimalDiffNnIlpConstr>(graph);
+        case PermuterVariant::OptimalDiffNnLpConstr:
+            return b.template permutation<PermuterVariant::OptimalDiffNnLpConstr>(graph);
+        case PermuterVariant::OptimalDiffVnIlpUnconstr:
+            return b.template permutation<PermuterVariant::OptimalDiffVnIlpUnconstr>(graph);
+        case PermuterVariant::OptimalDiffVnLpUnconstr:
+            return b.template permutation<PermuterVariant::OptimalDiffVnLpUnconstr>(graph);
+        case PermuterVariant::OptimalDiffVnIlpConstr:
+            return b.template permutation<PermuterVariant::OptimalDiffVnIlpConstr>(graph);
+        case PermuterVariant::OptimalDiffVnLpConstr:
+            return b.template permutation<PermuterVariant::OptimalDiffVnLpConstr>(graph);
+        case PermuterVariant::OIlpNnUnN:
+            return b.template permutation<PermuterVariant::OIlpNnUnN>(graph);
+        case PermuterVariant::OIlpNnConN:
+            return b.template permutation<PermuterVariant::OIlpNnConN>(graph);
+        case PermuterVariant::OIlpVnUnN:
+            return b.template permutation<PermuterVariant::OIlpVnUnN>(graph);
+        case PermuterVariant::OIlpVnConN:
+            return b.template permutation<PermuterVariant::OIlpVnConN>(graph);
+#endif
+    }
+    return b.template permutation<PermuterVariant::OutDegreeDescending>(graph);
+}
+
+} // namespace GMS::Permuters
+
+#endif //PERMUTER_REGISTRY_H
@@ -0,0 +1,88 @@
+#ifndef PERMUTER_STATISTICS_H
+#define PERMUTER_STATISTICS_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <parallel/algorithm>
+
+namespace GMS::Permuters {
+
+/**
+ * Statistics of the gaps between consecutive neighbours, which determine how well a vertex ordering compresses.
+ */
+struct GapStatistics
+{
+    int64_t num_gaps = 0;
+    /** Empirical entropy of the gap values, i.e. a lower bound for the bits per edge of any gap code. */
+    double gap_entropy = 0.0;
+    /** Average of log2(gap + 1), the cost function minimized by recursive bisection. */
+    double log_gap_bits_per_edge = 0.0;
+    /** Bits per edge of the byte-based varint coder. */
+    double varint_bits_per_edge = 0.0;
+};
+
+/**
+ * Computes the gap statistics of a graph with sorted neighbourhoods. The first gap of every neighbourhood is taken
+ * relative to the vertex itself.
+ */
+template <class Graph>
+GapStatistics gap_statistics(const Graph &graph)
+{
+    const int64_t n = graph.num_nodes();
+    std::vector<int64_t> offsets(n + 1, 0);
+    #pragma omp parallel for schedule(static)
+    for (int64_t v = 0; v < n; ++v) {
+        offsets[v + 1] = graph.out_degree(v);
+    }
+    for (int64_t v = 0; v < n; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    GapStatistics stats;
+    stats.num_gaps = offsets[n];
+    if (stats.num_gaps == 0) {
+        return stats;
+    }
+    std::vector<uint64_t> gaps(stats.num_gaps);
+    double log_bits = 0.0;
+    double varint_bits = 0.0;
+    #pragma omp parallel for schedule(dynamic, 256) reduction(+: log_bits, varint_bits)
+    for (int64_t v = 0; v < n; ++v) {
+        int64_t previous = v;
+        int64_t i = offsets[v];
+        for (auto u : graph.out_neigh(v)) {
+            uint64_t gap = std::llabs((int64_t) u - previous);
+            previous = u;
+            gaps[i++] = gap;
+            log_bits += std::log2(gap + 1.0);
+            int64_t bytes = 1;
+            while (gap >>= 7) {
+                ++bytes;
+            }
+            varint_bits += 8 * bytes;
+        }
+    }
+
+    __gnu_parallel::sort(gaps.begin(), gaps.end());
+    double entropy = 0.0;
+    for (int64_t i = 0; i < stats.num_gaps;) {
+        int64_t j = i;
+        while (j < stats.num_gaps && gaps[j] == gaps[i]) {
+            ++j;
+        }
+        double p = (double) (j - i) / stats.num_gaps;
+        entropy -= p * std::log2(p);
+        i = j;
+    }
+
+    stats.gap_entropy = entropy;
+    stats.log_gap_bits_per_edge = log_bits / stats.num_gaps;
+    stats.varint_bits_per_edge = varint_bits / stats.num_gaps;
+    return stats;
+}
+
+} // namespace GMS::Permuters
+
+#endif //PERMUTER_STATISTICS_H
@@ -0,0 +1,45 @@
+#ifndef PERMUTER_UTIL_H
+#define PERMUTER_UTIL_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+// Helpers shared by the heuristic (non-CPLEX) permuters.
+//
+// The heuristic permuters compute a ranking, i.e. new_ids[v] is the new id of vertex v. This is the same as the
+// rank format of the preprocessing orderings, thus the rankings can be used for the set-based kernels as well.
+namespace GMS::Permuters {
+
+/**
+ * Converts an order (order[i] = i-th vertex) into a ranking (new_ids[order[i]] = i).
+ *
+ * @param reverse If true, the order is reversed, i.e. the first vertex gets the largest id.
+ */
+template <class Order, class Output>
+void order_to_ranking(const Order &order, Output &new_ids, bool reverse = false)
+{
+    const int64_t n = order.size();
+    new_ids.resize(n);
+    #pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < n; ++i) {
+        new_ids[order[i]] = reverse ? n - 1 - i : i;
+    }
+}
+
+/**
+ * Converts a ranking into a map from old to new vertex ids, as expected by the permute function of the builder.
+ */
+template <class NodeId_, class Ranking>
+std::map<NodeId_, NodeId_> ranking_to_map(const Ranking &new_ids)
+{
+    std::map<NodeId_, NodeId_> result;
+    for (int64_t v = 0; v < (int64_t) new_ids.size(); ++v) {
+        result.emplace_hint(result.end(), v, new_ids[v]);
+    }
+    return result;
+}
+
+} // namespace GMS::Permuters
+
+#endif //PERMUTER_UTIL_H
@@ -6,6 +6,12 @@
 #include <gms/representations/graphs/permuters/in_degree_descending_permuter.h>
 #include <gms/representations/graphs/permuters/out_degree_ascending_permuter.h>
 #include <gms/representations/graphs/permuters/out_degree_descending_permuter.h>
+#include <gms/representations/graphs/permuters/bfs_permuter.h>
+#include <gms/representations/graphs/permuters/rcm_permuter.h>
+#include <gms/representations/graphs/permuters/gorder_permuter.h>
+#include <gms/representations/graphs/permuters/rabbit_order_permuter.h>
+#include <gms/representations/graphs/permuters/slashburn_permuter.h>
+#include <gms/representations/graphs/permuters/recursive_bisection_permuter.h>
 
 #if CPLEX_ENABLED
 #include <gms/representations/graphs/permuters/optimal_diff_nn_ilp_unconstr_permuter.h>
@@ -27,6 +33,12 @@ enum struct PermuterVariant {
     OutDegreeDescending,
     InDegreeAscending,
     InDegreeDescending,
+    Bfs,
+    ReverseCuthillMcKee,
+    Gorder,
+    RabbitOrder,
+    SlashBurn,
+    RecursiveBisection,
 #ifdef CPLEX_ENABLED
     OptimalDiffNnIlpUnconstr,
     OptimalDiffNnLpUnconstr,
@@ -0,0 +1,183 @@
+#ifndef RABBIT_ORDER_PERMUTER_H
+#define RABBIT_ORDER_PERMUTER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include <omp.h>
+#include <parallel/algorithm>
+
+#include "permuter_util.h"
+
+namespace GMS::Permuters {
+
+/**
+ * Rabbit Order (Arai et al., IPDPS 2016): parallel incremental aggregation of vertices into communities followed by
+ * a depth-first traversal of the resulting dendrogram, so that every community gets a consecutive id range.
+ *
+ * Vertices are visited in ascending degree order. Each vertex merges into the neighbouring community with the
+ * largest positive modularity gain. Merge targets are only try-locked: if the target is busy or was merged itself
+ * in the meantime, the vertex becomes a top-level community instead of waiting, hence there is no deadlock.
+ *
+ * @param order Output, order[i] = i-th vertex.
+ */
+template <class Graph, class Order>
+void rabbit_order(const Graph &graph, Order &order)
+{
+    using Edge = std::pair<int64_t, int64_t>; // (target, weight)
+    constexpr int64_t none = -1;
+    const int64_t n = graph.num_nodes();
+    order.resize(n);
+    if (n == 0) {
+        return;
+    }
+
+    std::vector<std::vector<Edge>> edges(n);
+    std::vector<int64_t> strength(n), dest(n), first_child(n, none), sibling(n, none);
+    std::vector<omp_lock_t> locks(n);
+    int64_t total_strength = 0;
+    #pragma omp parallel for schedule(dynamic, 256) reduction(+: total_strength)
+    for (int64_t v = 0; v < n; ++v) {
+        for (auto u : graph.out_neigh(v)) {
+            edges[v].emplace_back(u, 1);
+        }
+        strength[v] = edges[v].size();
+        total_strength += strength[v];
+        dest[v] = v;
+        omp_init_lock(&locks[v]);
+    }
+    const double inv_total = total_strength > 0 ? 1.0 / total_strength : 0.0;
+
+    std::vector<int64_t> by_degree(n);
+    std::iota(by_degree.begin(), by_degree.end(), 0);
+    __gnu_parallel::stable_sort(by_degree.begin(), by_degree.end(),
+                                [&strength](int64_t a, int64_t b) { return strength[a] < strength[b]; });
+
+    auto find_root = [&dest](int64_t v) {
+        int64_t d;
+        while ((d = __atomic_load_n(&dest[v], __ATOMIC_ACQUIRE)) != v) {
+            v = d;
+        }
+        return v;
+    };
+
+    #pragma omp parallel
+    {
+        std::vector<int64_t> weight_to(n, 0);
+        std::vector<int64_t> touched;
+
+        #pragma omp for schedule(dynamic, 64)
+        for (int64_t i = 0; i < n; ++i) {
+            const int64_t u = by_degree[i];
+            omp_set_lock(&locks[u]);
+
+            // Aggregate the edges of u (including the ones of merged members) per current community.
+            for (auto [x, w] : edges[u]) {
+                int64_t r = find_root(x);
+                if (r == u) {
+                    continue;
+                }
+                if (weight_to[r] == 0) {
+                    touched.push_back(r);
+                }
+                weight_to[r] += w;
+            }
+            edges[u].clear();
+            int64_t best = none;
+            double best_gain = 0.0;
+            for (int64_t r : touched) {
+                edges[u].emplace_back(r, weight_to[r]);
+                double strength_r = __atomic_load_n(&strength[r], __ATOMIC_RELAXED);
+                double gain = weight_to[r] - strength[u] * strength_r * inv_total;
+                if (gain > best_gain) {
+                    best_gain = gain;
+                    best = r;
+                }
+                weight_to[r] = 0;
+            }
+            touched.clear();
+
+            if (best != none && omp_test_lock(&locks[best])) {
+                if (__atomic_load_n(&dest[best], __ATOMIC_ACQUIRE) == best) {
+                    __atomic_fetch_add(&strength[best], strength[u], __ATOMIC_RELAXED);
+                    edges[best].insert(edges[best].end(), edges[u].begin(), edges[u].end());
+                    std::vector<Edge>().swap(edges[u]);
+                    sibling[u] = first_child[best];
+                    first_child[best] = u;
+                    __atomic_store_n(&dest[u], best, __ATOMIC_RELEASE);
+                }
+                omp_unset_lock(&locks[best]);
+            }
+            omp_unset_lock(&locks[u]);
+        }
+    }
+
+    for (auto &lock : locks) {
+        omp_destroy_lock(&lock);
+    }
+
+    // Every top-level community is numbered consecutively by a pre-order traversal of its dendrogram.
+    std::vector<int64_t> roots;
+    for (int64_t v = 0; v < n; ++v) {
+        if (dest[v] == v) {
+            roots.push_back(v);
+        }
+    }
+    const int64_t num_roots = roots.size();
+    std::vector<std::vector<int64_t>> members(num_roots);
+    std::vector<int64_t> offsets(num_roots + 1, 0);
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (int64_t i = 0; i < num_roots; ++i) {
+        std::vector<int64_t> stack{roots[i]};
+        while (!stack.empty()) {
+            int64_t v = stack.back();
+            stack.pop_back();
+            members[i].push_back(v);
+            for (int64_t c = first_child[v]; c != none; c = sibling[c]) {
+                stack.push_back(c);
+            }
+        }
+        offsets[i + 1] = members[i].size();
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (int64_t i = 0; i < num_roots; ++i) {
+        std::copy(members[i].begin(), members[i].end(), order.begin() + offsets[i]);
+    }
+}
+
+} // namespace GMS::Permuters
+
+
+/**
+ * Rabbit Order: community-based ordering computed by parallel incremental aggregation.
+ */
+template <class NodeId_, class DestID_, bool invert>
+class RabbitOrderPermuter {
+
+public:
+
+    /**
+     * Computes the Rabbit Order ranking, i.e. new_ids[v] is the new id of vertex v.
+     * Can also be used directly on a SetGraph as a preprocessing ordering in rank format.
+     */
+    template <class Graph, class Output = std::vector<NodeId_>>
+    static void ranking(const Graph &graph, Output &new_ids) {
+        std::vector<NodeId_> order;
+        GMS::Permuters::rabbit_order(graph, order);
+        GMS::Permuters::order_to_ranking(order, new_ids);
+    }
+
+    static std::map<NodeId_, NodeId_> permutation_map(CSRGraphBase<NodeId_, DestID_, invert>& graph) {
+        std::vector<NodeId_> new_ids;
+        ranking(graph, new_ids);
+        return GMS::Permuters::ranking_to_map<NodeId_>(new_ids);
+    }
+};
+
+
+#endif //RABBIT_ORDER_PERMUTER_H
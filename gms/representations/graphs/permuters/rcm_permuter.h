@@ -0,0 +1,38 @@
+#ifndef RCM_PERMUTER_H
+#define RCM_PERMUTER_H
+
+#include <map>
+#include <vector>
+
+#include "bfs_permuter.h"
+#include "permuter_util.h"
+
+/**
+ * Reverse Cuthill-McKee ordering: a breadth-first order in which the children of every vertex are visited by
+ * ascending degree, numbered in reverse. Reduces the bandwidth of the adjacency matrix.
+ */
+template <class NodeId_, class DestID_, bool invert>
+class RcmPermuter {
+
+public:
+
+    /**
+     * Computes the RCM ranking, i.e. new_ids[v] is the new id of vertex v.
+     * Can also be used directly on a SetGraph as a preprocessing ordering in rank format.
+     */
+    template <class Graph, class Output = std::vector<NodeId_>>
+    static void ranking(const Graph &graph, Output &new_ids) {
+        std::vector<NodeId_> order;
+        GMS::Permuters::breadth_first_order<true>(graph, order);
+        GMS::Permuters::order_to_ranking(order, new_ids, true);
+    }
+
+    static std::map<NodeId_, NodeId_> permutation_map(CSRGraphBase<NodeId_, DestID_, invert>& graph) {
+        std::vector<NodeId_> new_ids;
+        ranking(graph, new_ids);
+        return GMS::Permuters::ranking_to_map<NodeId_>(new_ids);
+    }
+};
+
+
+#endif //RCM_PERMUTER_H
@@ -0,0 +1,191 @@
+#ifndef RECURSIVE_BISECTION_PERMUTER_H
+#define RECURSIVE_BISECTION_PERMUTER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <vector>
+
+#include "permuter_util.h"
+
+namespace GMS::Permuters {
+
+namespace detail {
+
+/**
+ * Estimated number of bits for the d gaps of a neighbourhood with d members in a part of size n.
+ */
+inline double log_gap_cost(int64_t d, int64_t n)
+{
+    return d > 0 ? d * std::log2((double) n / (d + 1)) : 0.0;
+}
+
+template <class Graph, class Order>
+void bisect(const Graph &graph, Order &order, int64_t begin, int64_t end, int64_t max_iterations, int64_t leaf_size)
+{
+    const int64_t size = end - begin;
+    if (size <= leaf_size) {
+        std::sort(order.begin() + begin, order.begin() + end);
+        return;
+    }
+
+    // Local indexing of the neighbourhoods ("queries") touched by this subproblem.
+    std::vector<int64_t> queries;
+    std::vector<int64_t> offsets(size + 1, 0);
+    for (int64_t i = 0; i < size; ++i) {
+        for (auto q : graph.out_neigh(order[begin + i])) {
+            queries.push_back(q);
+        }
+        offsets[i + 1] = queries.size();
+    }
+    std::vector<int64_t> adjacency(queries.size());
+    std::copy(queries.begin(), queries.end(), adjacency.begin());
+    std::sort(queries.begin(), queries.end());
+    queries.erase(std::unique(queries.begin(), queries.end()), queries.end());
+    const int64_t num_queries = queries.size();
+    #pragma omp taskloop grainsize(4096) shared(queries, adjacency)
+    for (int64_t j = 0; j < (int64_t) adjacency.size(); ++j) {
+        adjacency[j] = std::lower_bound(queries.begin(), queries.end(), adjacency[j]) - queries.begin();
+    }
+
+    const int64_t n1 = size / 2;
+    const int64_t n2 = size - n1;
+    std::vector<uint8_t> side(size);
+    for (int64_t i = 0; i < size; ++i) {
+        side[i] = i >= n1;
+    }
+
+    std::vector<int64_t> degree[2] = {std::vector<int64_t>(num_queries), std::vector<int64_t>(num_queries)};
+    std::vector<double> gain(size);
+    std::vector<int64_t> candidates[2];
+    for (int64_t iteration = 0; iteration < max_iterations; ++iteration) {
+        std::fill(degree[0].begin(), degree[0].end(), 0);
+        std::fill(degree[1].begin(), degree[1].end(), 0);
+        for (int64_t i = 0; i < size; ++i) {
+            for (int64_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+                ++degree[side[i]][adjacency[j]];
+            }
+        }
+
+        #pragma omp taskloop grainsize(1024) shared(side, offsets, adjacency, degree, gain)
+        for (int64_t i = 0; i < size; ++i) {
+            const int s = side[i];
+            const int64_t n_from = s == 0 ? n1 : n2;
+            const int64_t n_to = s == 0 ? n2 : n1;
+            double g = 0.0;
+            for (int64_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+                int64_t d_from = degree[s][adjacency[j]];
+                int64_t d_to = degree[1 - s][adjacency[j]];
+                g += log_gap_cost(d_from, n_from) + log_gap_cost(d_to, n_to)
+                   - log_gap_cost(d_from - 1, n_from) - log_gap_cost(d_to + 1, n_to);
+            }
+            gain[i] = g;
+        }
+
+        for (int s = 0; s < 2; ++s) {
+            candidates[s].clear();
+            for (int64_t i = 0; i < size; ++i) {
+                if (side[i] == s) {
+                    candidates[s].push_back(i);
+                }
+            }
+            std::sort(candidates[s].begin(), candidates[s].end(),
+                      [&gain](int64_t a, int64_t b) { return gain[a] > gain[b] || (gain[a] == gain[b] && a < b); });
+        }
+
+        int64_t swaps = 0;
+        const int64_t max_swaps = std::min(candidates[0].size(), candidates[1].size());
+        while (swaps < max_swaps && gain[candidates[0][swaps]] + gain[candidates[1][swaps]] > 0) {
+            side[candidates[0][swaps]] = 1;
+            side[candidates[1][swaps]] = 0;
+            ++swaps;
+        }
+        if (swaps == 0) {
+            break;
+        }
+    }
+
+    std::vector<int64_t> parts;
+    parts.reserve(size);
+    for (int s = 0; s < 2; ++s) {
+        for (int64_t i = 0; i < size; ++i) {
+            if (side[i] == s) {
+                parts.push_back(order[begin + i]);
+            }
+        }
+    }
+    std::copy(parts.begin(), parts.end(), order.begin() + begin);
+
+    // Free the memory of this level before descending.
+    std::vector<int64_t>().swap(queries);
+    std::vector<int64_t>().swap(adjacency);
+    std::vector<int64_t>().swap(offsets);
+    std::vector<int64_t>().swap(degree[0]);
+    std::vector<int64_t>().swap(degree[1]);
+
+    #pragma omp task shared(graph, order)
+    bisect(graph, order, begin, begin + n1, max_iterations, leaf_size);
+    #pragma omp task shared(graph, order)
+    bisect(graph, order, begin + n1, end, max_iterations, leaf_size);
+    #pragma omp taskwait
+}
+
+} // namespace detail
+
+/**
+ * Recursive graph bisection for compression (BP, Dhulipala et al., KDD 2016).
+ *
+ * The vertices are bisected recursively. On every level, vertices are swapped between the two halves
+ * (sorted by gain, pairwise as long as the sum of both gains is positive) to minimize the estimated log-gap cost
+ * sum_q d1(q) * log(n1 / (d1(q) + 1)) + d2(q) * log(n2 / (d2(q) + 1)) over all neighbourhoods q.
+ * The recursion and the gain computations run as OpenMP tasks.
+ *
+ * @param order Output, order[i] = i-th vertex.
+ * @param max_iterations Maximum number of swap rounds per bisection.
+ * @param leaf_size Parts of at most this size are not split further.
+ */
+template <class Graph, class Order>
+void recursive_bisection(const Graph &graph, Order &order, int64_t max_iterations = 20, int64_t leaf_size = 16)
+{
+    const int64_t n = graph.num_nodes();
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0);
+
+    #pragma omp parallel
+    #pragma omp single
+    detail::bisect(graph, order, 0, n, max_iterations, leaf_size);
+}
+
+} // namespace GMS::Permuters
+
+
+/**
+ * Recursive bisection (BP): minimizes the log-gap cost of the neighbourhoods, i.e. targets the compressed coders.
+ */
+template <class NodeId_, class DestID_, bool invert>
+class RecursiveBisectionPermuter {
+
+public:
+
+    /**
+     * Computes the BP ranking, i.e. new_ids[v] is the new id of vertex v.
+     * Can also be used directly on a SetGraph as a preprocessing ordering in rank format.
+     */
+    template <class Graph, class Output = std::vector<NodeId_>>
+    static void ranking(const Graph &graph, Output &new_ids) {
+        std::vector<NodeId_> order;
+        GMS::Permuters::recursive_bisection(graph, order);
+        GMS::Permuters::order_to_ranking(order, new_ids);
+    }
+
+    static std::map<NodeId_, NodeId_> permutation_map(CSRGraphBase<NodeId_, DestID_, invert>& graph) {
+        std::vector<NodeId_> new_ids;
+        ranking(graph, new_ids);
+        return GMS::Permuters::ranking_to_map<NodeId_>(new_ids);
+    }
+};
+
+
+#endif //RECURSIVE_BISECTION_PERMUTER_H
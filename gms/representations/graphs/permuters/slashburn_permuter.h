@@ -0,0 +1,174 @@
+#ifndef SLASHBURN_PERMUTER_H
+#define SLASHBURN_PERMUTER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+#include <parallel/algorithm>
+
+#include <gms/third_party/gapbs/platform_atomics.h>
+
+#include "permuter_util.h"
+
+namespace GMS::Permuters {
+
+/**
+ * SlashBurn (Lim et al., TKDE 2014): repeatedly removes the k vertices of highest degree ("hubs") from the giant
+ * connected component and gives them the smallest free ids. The remaining non-giant components ("spokes") get the
+ * largest free ids, larger components first, and the procedure recurses on the new giant component.
+ *
+ * Connected components are found with a lock-free parallel union-find.
+ *
+ * @param hub_fraction The number of hubs removed per iteration, relative to the number of vertices.
+ * @param order Output, order[i] = i-th vertex.
+ */
+template <class Graph, class Order>
+void slashburn(const Graph &graph, Order &order, double hub_fraction = 0.005)
+{
+    const int64_t n = graph.num_nodes();
+    order.resize(n);
+    if (n == 0) {
+        return;
+    }
+    const int64_t k = std::max<int64_t>(1, hub_fraction * n);
+
+    std::vector<uint8_t> active(n, 1);
+    std::vector<int64_t> degree(n), parent(n), component_size(n);
+    std::vector<int64_t> remaining(n);
+    for (int64_t v = 0; v < n; ++v) {
+        remaining[v] = v;
+    }
+    int64_t front = 0;
+    int64_t back = n;
+
+    auto find = [&parent](int64_t v) {
+        while (parent[v] != v) {
+            v = parent[v];
+        }
+        return v;
+    };
+    auto by_degree_desc = [&degree](int64_t a, int64_t b) {
+        return degree[a] > degree[b] || (degree[a] == degree[b] && a < b);
+    };
+
+    while (true) {
+        const int64_t num_remaining = remaining.size();
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int64_t i = 0; i < num_remaining; ++i) {
+            int64_t v = remaining[i];
+            int64_t d = 0;
+            for (auto u : graph.out_neigh(v)) {
+                d += active[u];
+            }
+            degree[v] = d;
+        }
+
+        if (num_remaining <= k) {
+            __gnu_parallel::sort(remaining.begin(), remaining.end(), by_degree_desc);
+            std::copy(remaining.begin(), remaining.end(), order.begin() + front);
+            break;
+        }
+
+        // Slash: the hubs get the next ids at the front.
+        __gnu_parallel::nth_element(remaining.begin(), remaining.begin() + k, remaining.end(), by_degree_desc);
+        std::sort(remaining.begin(), remaining.begin() + k, by_degree_desc);
+        for (int64_t i = 0; i < k; ++i) {
+            order[front++] = remaining[i];
+            active[remaining[i]] = 0;
+        }
+        remaining.erase(remaining.begin(), remaining.begin() + k);
+
+        // Burn: connected components of the remaining vertices.
+        const int64_t num_rest = remaining.size();
+        #pragma omp parallel for schedule(static)
+        for (int64_t i = 0; i < num_rest; ++i) {
+            parent[remaining[i]] = remaining[i];
+            component_size[remaining[i]] = 0;
+        }
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int64_t i = 0; i < num_rest; ++i) {
+            int64_t v = remaining[i];
+            for (int64_t u : graph.out_neigh(v)) {
+                if (!active[u]) {
+                    continue;
+                }
+                while (true) {
+                    int64_t ru = find(u);
+                    int64_t rv = find(v);
+                    if (ru == rv) {
+                        break;
+                    }
+                    if (ru < rv) {
+                        std::swap(ru, rv);
+                    }
+                    if (compare_and_swap(parent[ru], ru, rv)) {
+                        break;
+                    }
+                }
+            }
+        }
+        #pragma omp parallel for schedule(static)
+        for (int64_t i = 0; i < num_rest; ++i) {
+            int64_t root = find(remaining[i]);
+            parent[remaining[i]] = root;
+            fetch_and_add(component_size[root], 1);
+        }
+
+        int64_t giant = parent[remaining[0]];
+        for (int64_t v : remaining) {
+            if (component_size[parent[v]] > component_size[giant]) {
+                giant = parent[v];
+            }
+        }
+
+        // The spokes get the last free ids, grouped by component.
+        std::vector<int64_t> spokes, giant_component;
+        for (int64_t v : remaining) {
+            (parent[v] == giant ? giant_component : spokes).push_back(v);
+        }
+        __gnu_parallel::sort(spokes.begin(), spokes.end(), [&](int64_t a, int64_t b) {
+            return std::make_tuple(-component_size[parent[a]], parent[a], a)
+                 < std::make_tuple(-component_size[parent[b]], parent[b], b);
+        });
+        back -= spokes.size();
+        std::copy(spokes.begin(), spokes.end(), order.begin() + back);
+        for (int64_t v : spokes) {
+            active[v] = 0;
+        }
+        remaining.swap(giant_component);
+    }
+}
+
+} // namespace GMS::Permuters
+
+
+/**
+ * SlashBurn: hubs get the smallest ids, the spokes hanging off them the largest ones.
+ */
+template <class NodeId_, class DestID_, bool invert>
+class SlashBurnPermuter {
+
+public:
+
+    /**
+     * Computes the SlashBurn ranking, i.e. new_ids[v] is the new id of vertex v.
+     * Can also be used directly on a SetGraph as a preprocessing ordering in rank format.
+     */
+    template <class Graph, class Output = std::vector<NodeId_>>
+    static void ranking(const Graph &graph, Output &new_ids) {
+        std::vector<NodeId_> order;
+        GMS::Permuters::slashburn(graph, order);
+        GMS::Permuters::order_to_ranking(order, new_ids);
+    }
+
+    static std::map<NodeId_, NodeId_> permutation_map(CSRGraphBase<NodeId_, DestID_, invert>& graph) {
+        std::vector<NodeId_> new_ids;
+        ranking(graph, new_ids);
+        return GMS::Permuters::ranking_to_map<NodeId_>(new_ids);
+    }
+};
+
+
+#endif //SLASHBURN_PERMUTER_H
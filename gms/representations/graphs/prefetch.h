@@ -0,0 +1,359 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+#include <gms/common/types.h>
+
+namespace GMS {
+
+/**
+ * Software prefetching of neighborhoods.
+ *
+ * prefetch_range(graph, begin, end, distance) wraps a vertex list (a frontier, a queue, a neighborhood, ...),
+ * prefetch_vertices(graph, distance) the vertex ids 0..n-1. Iterating the adapter yields the same vertices,
+ * but whenever a vertex is dereferenced the neighborhood of the vertex `distance` items ahead is prefetched:
+ *
+ *     for (NodeId u : prefetch_range(g, queue.begin(), queue.end(), distance)) {
+ *         for (NodeId v : g.out_neigh(u)) { ... }
+ *     }
+ *
+ * Random access adapters can be used in OpenMP work sharing loops (`for (auto it = r.begin(); it < r.end(); ++it)`),
+ * every thread then prefetches within its own chunk. Forward iterators (e.g. over a RoaringSet) are passed through
+ * without prefetching: looking ahead would decode every element twice, which costs more than the prefetch saves.
+ *
+ * Prefetching is opt-in, the default distance is 0 (off).
+ *
+ * How a neighborhood is prefetched depends on the graph type:
+ *  - graphs with a prefetch_neighbourhood(v) member (the Log(Graph) and compressed representations) use it,
+ *  - CSRGraph and contiguous sets (SortedSet) prefetch the first cache lines of the neighbor array,
+ *  - other sets (RoaringSet, RobinHoodSet) prefetch the set object.
+ */
+namespace Prefetch {
+
+/** Upper bound for the number of cache lines prefetched per neighborhood. */
+constexpr int64_t kMaxCacheLines = 4;
+constexpr int64_t kCacheLineSize = 64;
+/** Distance used if no distance is given or calibrated, prefetching is off by default. */
+constexpr int64_t kDefaultDistance = 0;
+/** Passing this distance to a kernel means that it should be calibrated with calibrate_distance. */
+constexpr int64_t kAutoDistance = -1;
+
+inline void prefetch_address(const void *address)
+{
+#if defined(__SSE__)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    __builtin_prefetch(address, 0, 3);
+#endif
+}
+
+/** Prefetches the cache lines of [address, address + bytes), at most kMaxCacheLines. */
+inline void prefetch_bytes(const void *address, size_t bytes)
+{
+    const char *pos = static_cast<const char*>(address);
+    const int64_t lines = std::min<int64_t>(kMaxCacheLines, 1 + bytes / kCacheLineSize);
+    for (int64_t i = 0; i < lines; ++i) {
+        prefetch_address(pos + i * kCacheLineSize);
+    }
+}
+
+namespace detail {
+
+template <class Graph, class = void>
+struct has_prefetch_member : std::false_type {};
+
+template <class Graph>
+struct has_prefetch_member<Graph, std::void_t<decltype(std::declval<const Graph&>().prefetch_neighbourhood(NodeId()))>>
+    : std::true_type {};
+
+template <class Neighborhood, class = void>
+struct is_contiguous : std::false_type {};
+
+template <class Neighborhood>
+struct is_contiguous<Neighborhood, std::void_t<decltype(&*std::declval<const Neighborhood&>().begin())>>
+    : std::bool_constant<
+        std::is_base_of_v<std::random_access_iterator_tag,
+            typename std::iterator_traits<decltype(std::declval<const Neighborhood&>().begin())>::iterator_category>
+        && std::is_pointer_v<decltype(&*std::declval<const Neighborhood&>().begin())>> {};
+
+template <class Neighborhood>
+constexpr bool is_contiguous_v = is_contiguous<Neighborhood>::value;
+
+} // namespace detail
+
+/**
+ * Prefetches the neighborhood of v.
+ */
+template <class Graph>
+inline void prefetch_neighborhood(const Graph &graph, NodeId v)
+{
+    if constexpr (detail::has_prefetch_member<Graph>::value) {
+        graph.prefetch_neighbourhood(v);
+    } else {
+        using Neighborhood = std::decay_t<decltype(graph.out_neigh(v))>;
+        if constexpr (std::is_lvalue_reference_v<decltype(graph.out_neigh(v))>) {
+            // set based graphs, the set object itself is stored in a vector of sets
+            const auto &neighborhood = graph.out_neigh(v);
+            prefetch_address(&neighborhood);
+            if constexpr (detail::is_contiguous_v<Neighborhood>) {
+                if (neighborhood.begin() != neighborhood.end()) {
+                    prefetch_bytes(&*neighborhood.begin(),
+                                   (neighborhood.end() - neighborhood.begin()) * sizeof(*neighborhood.begin()));
+                }
+            }
+        } else if constexpr (detail::is_contiguous_v<Neighborhood>) {
+            // CSRGraph, the neighborhood is a view of the neighbor array
+            auto neighborhood = graph.out_neigh(v);
+            if (neighborhood.begin() != neighborhood.end()) {
+                prefetch_bytes(&*neighborhood.begin(),
+                               (neighborhood.end() - neighborhood.begin()) * sizeof(*neighborhood.begin()));
+            }
+        }
+    }
+}
+
+/**
+ * Counting iterator over vertex ids, used by prefetch_vertices.
+ */
+class VertexIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = NodeId;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const NodeId*;
+    using reference = NodeId;
+
+    VertexIterator() = default;
+    explicit VertexIterator(NodeId v) : v_(v) {}
+
+    NodeId operator*() const { return v_; }
+    NodeId operator[](difference_type i) const { return v_ + i; }
+    VertexIterator &operator++() { ++v_; return *this; }
+    VertexIterator operator++(int) { VertexIterator it = *this; ++v_; return it; }
+    VertexIterator &operator--() { --v_; return *this; }
+    VertexIterator &operator+=(difference_type i) { v_ += i; return *this; }
+    VertexIterator &operator-=(difference_type i) { v_ -= i; return *this; }
+    VertexIterator operator+(difference_type i) const { return VertexIterator(v_ + i); }
+    VertexIterator operator-(difference_type i) const { return VertexIterator(v_ - i); }
+    difference_type operator-(const VertexIterator &other) const { return v_ - other.v_; }
+    bool operator==(const VertexIterator &other) const { return v_ == other.v_; }
+    bool operator!=(const VertexIterator &other) const { return v_ != other.v_; }
+    bool operator<(const VertexIterator &other) const { return v_ < other.v_; }
+    bool operator<=(const VertexIterator &other) const { return v_ <= other.v_; }
+    bool operator>(const VertexIterator &other) const { return v_ > other.v_; }
+    bool operator>=(const VertexIterator &other) const { return v_ >= other.v_; }
+
+private:
+    NodeId v_ = 0;
+};
+
+/**
+ * Iterator adapter which prefetches the neighborhood of the vertex `distance` items ahead.
+ *
+ * For random access iterators the vertex ahead is looked up on dereference, so the adapter is itself random access.
+ * Forward iterators only yield their items, nothing is prefetched.
+ */
+template <class Graph, class Iterator>
+class PrefetchIterator {
+    static constexpr bool kRandomAccess = std::is_base_of_v<std::random_access_iterator_tag,
+        typename std::iterator_traits<Iterator>::iterator_category>;
+
+public:
+    using iterator_category = std::conditional_t<kRandomAccess, std::random_access_iterator_tag, std::forward_iterator_tag>;
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+    using pointer = typename std::iterator_traits<Iterator>::pointer;
+    // some set iterators (RoaringSet) return by value but declare a reference type
+    using reference = decltype(*std::declval<const Iterator&>());
+
+    PrefetchIterator(const Graph *graph, Iterator it, Iterator end, int64_t distance) :
+        graph_(graph), it_(it), end_(end), distance_(distance)
+    {}
+
+    reference operator*() const {
+        if constexpr (kRandomAccess) {
+            if (distance_ > 0 && end_ - it_ > distance_) {
+                prefetch_neighborhood(*graph_, it_[distance_]);
+            }
+        }
+        return *it_;
+    }
+
+    PrefetchIterator &operator++() {
+        ++it_;
+        return *this;
+    }
+
+    PrefetchIterator operator++(int) { PrefetchIterator retval = *this; ++(*this); return retval; }
+
+    bool operator==(const PrefetchIterator &other) const { return it_ == other.it_; }
+    bool operator!=(const PrefetchIterator &other) const { return it_ != other.it_; }
+
+    // random access interface, needed for OpenMP work sharing loops
+    template <bool RA = kRandomAccess, class = std::enable_if_t<RA>>
+    reference operator[](difference_type i) const { return *(*this + i); }
+    template <bool RA = kRandomAccess, class = std::enable_if_t<RA>>
+    PrefetchIterator &operator--() { --it_; return *this; }
+    template <bool RA = kRandomAccess, class = std::enable_if_t<RA>>
+    PrefetchIterator &operator+=(difference_type i) { it_ += i; return *this; }
+    template <bool RA = kRandomAccess, class = std::enable_if_t<RA>>
+    PrefetchIterator &operator-=(difference_type i) { it_ -= i; return *this; }
+    template <bool RA = kRandomAccess, class = std::enable_if_t<RA>>
+    PrefetchIterator operator+(difference_type i) const { PrefetchIterator r = *this; r.it_ += i; return r; }
+    template <bool RA = kRandomAccess, class = std::enable_if_t<RA>>
+    PrefetchIterator operator-(difference_type i) const { PrefetchIterator r = *this; r.it_ -= i; return r; }
+    template <bool RA = kRandomAccess, class = std::enable_if_t<RA>>
+    difference_type operator-(const PrefetchIterator &other) const { return it_ - other.it_; }
+    template <bool RA = kRandomAccess, class = std::enable_if_t<RA>>
+    bool operator<(const PrefetchIterator &other) const { return it_ < other.it_; }
+    template <bool RA = kRandomAccess, class = std::enable_if_t<RA>>
+    bool operator<=(const PrefetchIterator &other) const { return it_ <= other.it_; }
+    template <bool RA = kRandomAccess, class = std::enable_if_t<RA>>
+    bool operator>(const PrefetchIterator &other) const { return it_ > other.it_; }
+    template <bool RA = kRandomAccess, class = std::enable_if_t<RA>>
+    bool operator>=(const PrefetchIterator &other) const { return it_ >= other.it_; }
+
+private:
+    const Graph *graph_;
+    Iterator it_;
+    Iterator end_;
+    int64_t distance_;
+};
+
+template <class Graph, class Iterator>
+class PrefetchRange {
+public:
+    using iterator = PrefetchIterator<Graph, Iterator>;
+
+    PrefetchRange(const Graph &graph, Iterator begin, Iterator end, int64_t distance) :
+        graph_(&graph), begin_(begin), end_(end), distance_(distance)
+    {}
+
+    iterator begin() const { return iterator(graph_, begin_, end_, distance_); }
+    iterator end() const { return iterator(graph_, end_, end_, 0); }
+
+private:
+    const Graph *graph_;
+    Iterator begin_;
+    Iterator end_;
+    int64_t distance_;
+};
+
+} // namespace Prefetch
+
+/**
+ * Iterates [begin, end) and prefetches the neighborhood of the vertex `distance` items ahead.
+ */
+template <class Graph, class Iterator>
+Prefetch::PrefetchRange<Graph, Iterator> prefetch_range(const Graph &graph, Iterator begin, Iterator end,
+                                                        int64_t distance = Prefetch::kDefaultDistance)
+{
+    return Prefetch::PrefetchRange<Graph, Iterator>(graph, begin, end, distance);
+}
+
+/**
+ * Iterates a container of vertices (a frontier, a set, ...) with prefetching.
+ */
+template <class Graph, class Vertices>
+auto prefetch_range(const Graph &graph, const Vertices &vertices, int64_t distance = Prefetch::kDefaultDistance)
+{
+    return prefetch_range(graph, vertices.begin(), vertices.end(), distance);
+}
+
+/**
+ * Iterates the vertex ids 0..n-1 of the graph with prefetching.
+ */
+template <class Graph>
+Prefetch::PrefetchRange<Graph, Prefetch::VertexIterator> prefetch_vertices(const Graph &graph,
+                                                                           int64_t distance = Prefetch::kDefaultDistance)
+{
+    return prefetch_range(graph, Prefetch::VertexIterator(0), Prefetch::VertexIterator(graph.num_nodes()), distance);
+}
+
+namespace Prefetch {
+
+/**
+ * Picks a prefetch distance for the graph by timing a sweep over the neighborhoods of a random vertex sample for
+ * each candidate distance. The order of the sample is random, so that the hardware prefetcher can't hide the
+ * latency. A larger distance is only chosen if it is at least 5% faster than the smaller ones.
+ *
+ * @param visit visit(u) traverses the neighborhood of u and returns a value depending on it.
+ * @param sample_size Number of vertices in the sample.
+ * @param candidates Distances to try, in ascending order.
+ */
+template <class Graph, class Visit>
+int64_t calibrate_distance(const Graph &graph, Visit &&visit, int64_t sample_size = 1 << 16,
+                           const std::vector<int64_t> &candidates = {0, 2, 4, 8, 16, 32})
+{
+    const int64_t n = graph.num_nodes();
+    if (n == 0 || candidates.empty()) {
+        return kDefaultDistance;
+    }
+    std::vector<NodeId> sample(std::min(n, sample_size));
+    std::mt19937_64 rng(27491095);
+    std::uniform_int_distribution<int64_t> pick(0, n - 1);
+    for (auto &v : sample) {
+        v = pick(rng);
+    }
+
+    volatile int64_t sink = 0;
+    auto sweep = [&](int64_t distance) {
+        auto start = std::chrono::steady_clock::now();
+        int64_t sum = 0;
+        for (NodeId u : prefetch_range(graph, sample.begin(), sample.end(), distance)) {
+            sum += visit(u);
+        }
+        sink = sink + sum;
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    sweep(0); // warm up
+    int64_t best = candidates.front();
+    double best_time = std::min(sweep(best), sweep(best));
+    for (size_t i = 1; i < candidates.size(); ++i) {
+        double t = std::min(sweep(candidates[i]), sweep(candidates[i]));
+        if (t < 0.95 * best_time) {
+            best = candidates[i];
+            best_time = t;
+        }
+    }
+    return best;
+}
+
+template <class Graph>
+int64_t calibrate_distance(const Graph &graph)
+{
+    return calibrate_distance(graph, [&graph](NodeId u) {
+        int64_t sum = 0;
+        for (auto v : graph.out_neigh(u)) {
+            sum += static_cast<int64_t>(v);
+        }
+        return sum;
+    });
+}
+
+/**
+ * Resolves kAutoDistance with calibrate_distance, other distances are returned unchanged.
+ */
+template <class Graph>
+int64_t resolve_distance(const Graph &graph, int64_t distance)
+{
+    return distance == kAutoDistance ? calibrate_distance(graph) : distance;
+}
+
+} // namespace Prefetch
+
+} // namespace GMS
@@ -58,9 +58,8 @@ public:
             std::sort(edge_list.begin(), edge_list.end());
         }
 
-        SetGraph graph(num_nodes);
-
-        graph.neighborhoods.reserve(num_nodes);
+        std::vector<Set> neighborhoods;
+        neighborhoods.reserve(num_nodes);
         auto edge_iterator = edge_list.begin();
         std::vector<SetElement> neigh;
         for (int64_t u = 0; u < num_nodes; ++u) {
@@ -69,10 +68,10 @@ public:
                 neigh.push_back(edge_iterator->second);
                 ++edge_iterator;
             }
-            graph.neighborhoods.push_back(Set(neigh.begin(), neigh.size()));
+            neighborhoods.push_back(Set(neigh.data(), neigh.size()));
         }
 
-        return graph;
+        return SetGraph(std::move(neighborhoods));
     }
 
     /**
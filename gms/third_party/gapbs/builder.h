@@ -34,30 +34,9 @@
 #include <gms/representations/graphs/log_graph/options.h>
 #include <gms/representations/graphs/coders/varint_byte_based_graph.h>
 #include <gms/representations/graphs/coders/varint_word_based_graph.h>
+#include <gms/representations/graphs/coders/reference_compressed_graph.h>
 #include <gms/representations/graphs/permuters/permuters.h>
 
-// I'd like to put the following typedefs into 'benchmark.h',
-// but if I do, there is a cyclic dependency with includes
-#if LOCAL_APPROACH
-	#if BIT_TREE
-		typedef Bit_Tree_Graph My_Graph;
-	#else
-		typedef Kbit_Adjacency_Array_Local My_Graph;
-	#endif
-	typedef Kbit_Weighted_Adjacency_Array_Local My_Weighted_Graph;
-#else
-    #if COMPRESSED
-        #if VARINT_BYTE_BASED
-        typedef VarintByteBasedGraph My_Graph;
-        #elif VARINT_WORD_BASED
-        typedef VarintWordBasedGraph My_Graph;
-        #endif
-	#else
-	typedef Kbit_Adjacency_Array My_Graph;
-	#endif
-	typedef Kbit_Weighted_Adjacency_Array My_Weighted_Graph;
-#endif
-
 // #define ALPHA 0.00390265
 // #define ALPHA 0.015625
 #define ALPHA 0.0078 // I now define ALPHA dynamically
@@ -653,6 +632,17 @@ VarintByteBasedGraph csrToVarintByteBased(const CSRGraphBase<NodeId_, DestID_, i
 
 
 
+ReferenceCompressedGraph csrToReferenceCompressed(const CSRGraphBase<NodeId_, DestID_, invert> &csr) {
+	Timer t;
+	t.Start();
+	ReferenceCompressedGraph g = ReferenceCompressedGraph::FromCGraph(csr);
+	t.Stop();
+	PrintTime("Reference Encoding", t.Seconds());
+	return g;
+}
+
+
+
 VarintWordBasedGraph csrToVarintWordBased(const CSRGraphBase<NodeId_, DestID_, invert> &csr) {
 
 		bool directed = csr.directed();
@@ -767,6 +757,8 @@ VarintWordBasedGraph csrToVarintWordBased(const CSRGraphBase<NodeId_, DestID_, i
             return csrToVarintByteBased(csr_graph);
         } else if constexpr (std::is_same_v<CGraph, VarintWordBasedGraph>) {
             return csrToVarintWordBased(csr_graph);
+        } else if constexpr (std::is_same_v<CGraph, ReferenceCompressedGraph>) {
+            return csrToReferenceCompressed(csr_graph);
         } else if constexpr (std::is_same_v<CGraph, Kbit_Adjacency_Array>) {
             bool symm_backup = symmetrize_;
             symmetrize_ = !csr_graph.directed();
@@ -779,6 +771,24 @@ VarintWordBasedGraph csrToVarintWordBased(const CSRGraphBase<NodeId_, DestID_, i
             auto g = csrToKbitLocal(csr_graph);
             symmetrize_ = symm_backup;
             return std::move(g);
+        } else if constexpr (std::is_same_v<CGraph, Bit_Tree_Graph>) {
+            bool symm_backup = symmetrize_;
+            symmetrize_ = !csr_graph.directed();
+            auto g = csrToBitTree(csr_graph);
+            symmetrize_ = symm_backup;
+            return std::move(g);
+        } else if constexpr (std::is_same_v<CGraph, Kbit_Weighted_Adjacency_Array>) {
+            bool symm_backup = symmetrize_;
+            symmetrize_ = !csr_graph.directed();
+            auto g = csrToWeightedKbit(csr_graph);
+            symmetrize_ = symm_backup;
+            return std::move(g);
+        } else if constexpr (std::is_same_v<CGraph, Kbit_Weighted_Adjacency_Array_Local>) {
+            bool symm_backup = symmetrize_;
+            symmetrize_ = !csr_graph.directed();
+            auto g = csrToWeightedKbitLocal(csr_graph);
+            symmetrize_ = symm_backup;
+            return std::move(g);
         } else {
             static_assert(GMS::always_false<CGraph>, "class not supported");
         }
@@ -934,11 +944,9 @@ Bit_Tree_Graph csrToBitTree(const CSRGraphBase<NodeId_, DestID_, invert> &csr){
 	bool directed = !symmetrize_;
 
 	vector<NodeId> bitlength = vector<NodeId>(n, 0); // bit-lengths for neighbourhoods
-	#if BIT_TREE
-		vector<bool> bit_tree_encoding = vector<bool>(n, 0); // whether to use bit_tree encoding
-		double alpha = 1.0/(pow(2.0,((log2(n)-2.0)/2.0))); // heuristic
-		cout << "alpha: " << alpha << endl;
-	#endif
+	vector<bool> bit_tree_encoding = vector<bool>(n, 0); // whether to use bit_tree encoding
+	double alpha = 1.0/(pow(2.0,((log2(n)-2.0)/2.0))); // heuristic
+	cout << "alpha: " << alpha << endl;
 
 	// #pragma omp parallel for
 	// very strange race condition...
@@ -946,20 +954,18 @@ Bit_Tree_Graph csrToBitTree(const CSRGraphBase<NodeId_, DestID_, invert> &csr){
 	int number_of_bittree_neighbourhoods = 0;
     for (NodeId u=0; u < csr.num_nodes(); u++) {
 		// the following equation defines whether to use Bit Tree Encoding
-		#if BIT_TREE
-			// double alpha = alpha_heuristics[(int)ceil(log2(n))];
-			// alpha = ALPHA;
-			// double alpha = 0.0156;
-			if((double)csr.out_degree(u) / (double)n >= alpha){
-				bit_tree_encoding[u] = true;
-				number_of_bittree_neighbourhoods ++;
-				// cout << u << "!!!" <<  (double)csr.out_degree(u) / (double)n << endl;
-			}
-			// else{
-				// cout << u << "!!!" <<  (double)csr.out_degree(u) / (double)n << endl;
+		// double alpha = alpha_heuristics[(int)ceil(log2(n))];
+		// alpha = ALPHA;
+		// double alpha = 0.0156;
+		if((double)csr.out_degree(u) / (double)n >= alpha){
+			bit_tree_encoding[u] = true;
+			number_of_bittree_neighbourhoods ++;
+			// cout << u << "!!!" <<  (double)csr.out_degree(u) / (double)n << endl;
+		}
+		// else{
+			// cout << u << "!!!" <<  (double)csr.out_degree(u) / (double)n << endl;
 
-			// }
-		#endif
+		// }
 		#if SIMPLE_GAP_ENCODING
 			NodeId current_vertex = 0;
 			for(DestID_ v : csr.out_neigh(u)){
@@ -980,11 +986,9 @@ Bit_Tree_Graph csrToBitTree(const CSRGraphBase<NodeId_, DestID_, invert> &csr){
 	// allocate structures
 	vector<int64_t> bit_offset(n+1, 0); // bit offset of neighbourhood in adjacency array
 	for(int i=1; i<=n; i++){
-		#if BIT_TREE
 		if(bit_tree_encoding[i-1])
 			bit_offset[i] = bit_offset[i-1];
 		else
-		#endif
 			bit_offset[i] = bit_offset[i-1] + csr.out_degree(i-1)*bitlength[i-1];
 	}
     int32_t* adjacencyArray = (int32_t*) allocate_memory(bit_offset[n], 1);
@@ -993,12 +997,10 @@ Bit_Tree_Graph csrToBitTree(const CSRGraphBase<NodeId_, DestID_, invert> &csr){
 
 	for(NodeId u : csr.vertices()){
 		int64_t k = bitlength[u];
-		#if BIT_TREE
-			if(bit_tree_encoding[u]){
-				O[u].offset_or_tree.tree = encode_as_bit_tree(csr, u, k);
-				continue;
-			}
-		#endif
+		if(bit_tree_encoding[u]){
+			O[u].offset_or_tree.tree = encode_as_bit_tree(csr, u, k);
+			continue;
+		}
 		int pos = 0;
 		#if SIMPLE_GAP_ENCODING
 			NodeId current_vertex = 0;
@@ -1024,11 +1026,9 @@ Bit_Tree_Graph csrToBitTree(const CSRGraphBase<NodeId_, DestID_, invert> &csr){
 	for(int i=0; i<n; i++){
 		O[i].degree = (int32_t) csr.out_degree(i);
 		O[i].bitlength = (int8_t) bitlength[i];
-		#if BIT_TREE
-			O[i].encoding = (int8_t) bit_tree_encoding[i];
-			if (!bit_tree_encoding[i])
-		#endif
-		O[i].offset_or_tree.offset = bit_offset[i];
+		O[i].encoding = (int8_t) bit_tree_encoding[i];
+		if (!bit_tree_encoding[i])
+			O[i].offset_or_tree.offset = bit_offset[i];
 	}
 	cout << "Bytes for bittree encoded neighourhoods: " << bittree_encoding_space/8 << endl;
 	cout << "Bytes saved with bittree encoding: " << (bits_saved_with_bittree_encoding / 8) << endl;
@@ -1195,240 +1195,76 @@ void remove_duplicates(EdgeList& el, pvector<NodeId_>& degrees, int64_t& m){
 		return result_map;
 	}
 
+    // Computes the permutation of the given variant, new_ids[v] is the new id of vertex v
 	template <PermuterVariant TVariant>
-    const CSRGraphBase<NodeId_, DestID_, invert> permute(CSRGraphBase<NodeId_, DestID_, invert> graph) {
+    pvector<NodeId_> permutation(CSRGraphBase<NodeId_, DestID_, invert> &graph) {
 
-        std::map<NodeId, NodeId> permutation;
+        std::map<NodeId, NodeId> old_to_new;
+        pvector<NodeId_> new_ids(graph.num_nodes());
 
         if constexpr (TVariant == PermuterVariant::OutDegreeAscending) {
-            permutation = OutDegreeAscendingPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OutDegreeAscendingPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::OutDegreeDescending) {
-            permutation = OutDegreeDescendingPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OutDegreeDescendingPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::InDegreeAscending) {
-            permutation = InDegreeAscendingPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = InDegreeAscendingPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::InDegreeDescending) {
-            permutation = InDegreeDescendingPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = InDegreeDescendingPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+        } else if constexpr (TVariant == PermuterVariant::Bfs) {
+            BfsPermuter<NodeId_, DestID_, invert>::ranking(graph, new_ids);
+        } else if constexpr (TVariant == PermuterVariant::ReverseCuthillMcKee) {
+            RcmPermuter<NodeId_, DestID_, invert>::ranking(graph, new_ids);
+        } else if constexpr (TVariant == PermuterVariant::Gorder) {
+            GorderPermuter<NodeId_, DestID_, invert>::ranking(graph, new_ids);
+        } else if constexpr (TVariant == PermuterVariant::RabbitOrder) {
+            RabbitOrderPermuter<NodeId_, DestID_, invert>::ranking(graph, new_ids);
+        } else if constexpr (TVariant == PermuterVariant::SlashBurn) {
+            SlashBurnPermuter<NodeId_, DestID_, invert>::ranking(graph, new_ids);
+        } else if constexpr (TVariant == PermuterVariant::RecursiveBisection) {
+            RecursiveBisectionPermuter<NodeId_, DestID_, invert>::ranking(graph, new_ids);
         }
 #ifdef CPLEX_ENABLED
         else if constexpr (TVariant == PermuterVariant::OptimalDiffNnIlpUnconstr) {
-            permutation = OptimalDiffNNIlpUnconstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OptimalDiffNNIlpUnconstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::OptimalDiffNnLpUnconstr) {
-            permutation = OptimalDiffNNLpUnconstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OptimalDiffNNLpUnconstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::OptimalDiffNnIlpConstr) {
-            permutation = OptimalDiffNNIlpConstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OptimalDiffNNIlpConstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::OptimalDiffNnLpConstr) {
-            permutation = OptimalDiffNNLpConstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OptimalDiffNNLpConstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::OptimalDiffVnIlpUnconstr) {
-            permutation = OptimalDiffVNIlpUnconstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OptimalDiffVNIlpUnconstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::OptimalDiffVnLpUnconstr) {
-            permutation = OptimalDiffVNLpUnconstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OptimalDiffVNLpUnconstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::OptimalDiffVnIlpConstr) {
-            permutation = OptimalDiffVNIlpConstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OptimalDiffVNIlpConstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::OptimalDiffVnLpConstr) {
-            permutation = OptimalDiffVNLpConstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OptimalDiffVNLpConstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::OIlpNnUnN) {
-            permutation = OIlpNNUnNPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OIlpNNUnNPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::OIlpNnConN) {
-            permutation = OIlpNNConNPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OIlpNNConNPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::OIlpVnUnN) {
-            permutation = OIlpVNUnNPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OIlpVNUnNPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         } else if constexpr (TVariant == PermuterVariant::OIlpVnConN) {
-            permutation = OIlpVNConNPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
+            old_to_new = OIlpVNConNPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
         }
 #endif // CPLEX_ENABLED
         else {
             static_assert(GMS::always_false<TVariant>, "should be unreachable");
         }
 
-        DestID_** new_out_index = new DestID_*[graph.num_nodes() + 1]();
-        DestID_* new_out_neighbours = new DestID_[graph.num_edges() * (graph.directed() ? 1 : 2)];
-
-        std::map<NodeId, NodeId> reverse_permutation;
-        reverse_permutation = get_reverse_permutation(permutation);
-
-
-        uint64_t offset_index = 0;
-        uint64_t neigh_index = 0;
-        for (auto v : graph.vertices()) {
-            NodeId v_old = reverse_permutation[v];
-            new_out_index[offset_index] = (new_out_neighbours + neigh_index);
-
-            for (auto u_old : graph.out_neigh(v_old)) {
-                new_out_neighbours[neigh_index] = permutation[u_old];
-                neigh_index++;
-            }
-
-            std::sort(new_out_index[offset_index], new_out_neighbours + neigh_index);
-            offset_index++;
-        }
-        new_out_index[graph.num_nodes()] = new_out_neighbours + (graph.num_edges() * (graph.directed() ? 1 : 2));
-
-
-        if (graph.directed()) {
-            DestID_** new_in_index = new DestID_*[graph.num_nodes() + 1]();
-            DestID_* new_in_neighbours = new DestID_[graph.num_edges() * (graph.directed() ? 1 : 2)];
-
-            offset_index = 0;
-            neigh_index = 0;
-            for (auto v : graph.vertices()) {
-                NodeId v_old = reverse_permutation[v];
-                new_in_index[offset_index] = (new_in_neighbours + neigh_index);
-
-                for (auto u_old : graph.in_neigh(v_old)) {
-                    new_in_neighbours[neigh_index] = permutation[u_old];
-                    neigh_index++;
-                }
-
-                std::sort(new_in_index[offset_index], new_in_neighbours + neigh_index);
-                offset_index++;
-            }
-            new_in_index[graph.num_nodes()] = new_in_neighbours + (graph.num_edges() * (graph.directed() ? 1 : 2));
-
-            return CSRGraphBase<NodeId_, DestID_, invert>(graph.num_nodes(), new_out_index, new_out_neighbours, new_in_index, new_in_neighbours);
-        } else {
-
-            return CSRGraphBase<NodeId_, DestID_, invert>(graph.num_nodes(), new_out_index, new_out_neighbours);
+        for (auto [v_old, v_new] : old_to_new) {
+            new_ids[v_old] = v_new;
         }
+        return new_ids;
     }
 
-    // TODO deprecate or forward to the template permute function
-	const CSRGraphBase<NodeId_, DestID_, invert> permute(CSRGraphBase<NodeId_, DestID_, invert> graph) {
-
-		std::map<NodeId, NodeId> permutation;
-
-		#if OUT_ASCENDING
-			permutation = OutDegreeAscendingPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-        #elif OUT_DESCENDING
-			permutation = OutDegreeDescendingPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-        #elif IN_ASCENDING
-			permutation = InDegreeAscendingPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-        #elif IN_DESCENDING
-			permutation = InDegreeDescendingPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-		#elif CPLEX_ENABLED
-			#if OPTIMAL_DIFF_NN_ILP_UNCONSTR
-				permutation = OptimalDiffNNIlpUnconstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-			#elif OPTIMAL_DIFF_NN_LP_UNCONSTR
-				permutation = OptimalDiffNNLpUnconstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-			#elif OPTIMAL_DIFF_NN_ILP_CONSTR
-				permutation = OptimalDiffNNIlpConstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-			#elif OPTIMAL_DIFF_NN_LP_CONSTR
-				permutation = OptimalDiffNNLpConstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-			#elif OPTIMAL_DIFF_VN_ILP_UNCONSTR
-				permutation = OptimalDiffVNIlpUnconstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-			#elif OPTIMAL_DIFF_VN_LP_UNCONSTR
-				permutation = OptimalDiffVNLpUnconstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-			#elif OPTIMAL_DIFF_VN_ILP_CONSTR
-				permutation = OptimalDiffVNIlpConstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-			#elif OPTIMAL_DIFF_VN_LP_CONSTR
-				permutation = OptimalDiffVNLpConstrPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-			#elif O_ILP_NN_UN_N
-				permutation = OIlpNNUnNPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-			#elif O_ILP_NN_CON_N
-				permutation = OIlpNNConNPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-			#elif O_ILP_VN_UN_N
-				permutation = OIlpVNUnNPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-			#elif O_ILP_VN_CON_N
-				permutation = OIlpVNConNPermuter<NodeId_, DestID_, invert>::permutation_map(graph);
-			#endif
-		#endif
-
-		DestID_** new_out_index = new DestID_*[graph.num_nodes() + 1]();
-		DestID_* new_out_neighbours = new DestID_[graph.num_edges() * (graph.directed() ? 1 : 2)];
-
-		std::map<NodeId, NodeId> reverse_permutation;
-		reverse_permutation = get_reverse_permutation(permutation);
-
-
-		uint64_t offset_index = 0;
-		uint64_t neigh_index = 0;
-		for (auto v : graph.vertices()) {
-			NodeId v_old = reverse_permutation[v];
-			new_out_index[offset_index] = (new_out_neighbours + neigh_index);
-
-			for (auto u_old : graph.out_neigh(v_old)) {
-                new_out_neighbours[neigh_index] = permutation[u_old];
-				neigh_index++;
-			}
-
-			std::sort(new_out_index[offset_index], new_out_neighbours + neigh_index);
-			offset_index++;
-		}
-		new_out_index[graph.num_nodes()] = new_out_neighbours + (graph.num_edges() * (graph.directed() ? 1 : 2));
-
-
-		if (graph.directed()) {
-			DestID_** new_in_index = new DestID_*[graph.num_nodes() + 1]();
-			DestID_* new_in_neighbours = new DestID_[graph.num_edges() * (graph.directed() ? 1 : 2)];
-
-			offset_index = 0;
-			neigh_index = 0;
-			for (auto v : graph.vertices()) {
-				NodeId v_old = reverse_permutation[v];
-				new_in_index[offset_index] = (new_in_neighbours + neigh_index);
-
-				for (auto u_old : graph.in_neigh(v_old)) {
-                    new_in_neighbours[neigh_index] = permutation[u_old];
-					neigh_index++;
-				}
-
-				std::sort(new_in_index[offset_index], new_in_neighbours + neigh_index);
-				offset_index++;
-			}
-			new_in_index[graph.num_nodes()] = new_in_neighbours + (graph.num_edges() * (graph.directed() ? 1 : 2));
-
-			return CSRGraphBase<NodeId_, DestID_, invert>(graph.num_nodes(), new_out_index, new_out_neighbours, new_in_index, new_in_neighbours);
-		} else {
-
-			return CSRGraphBase<NodeId_, DestID_, invert>(graph.num_nodes(), new_out_index, new_out_neighbours);
-		}
-	}
-
-
-
-	My_Graph make_graph_from_CSR(){
-		#if PERMUTED
-			return make_graph_from_CSR(permute(MakeGraph()));
-    	#else
-			return make_graph_from_CSR(MakeGraph());
-        #endif
-	}
-
-	My_Graph make_graph_from_CSR(const CSRGraphBase<NodeId_, DestID_, invert>& csr){
-		#if LOCAL_APPROACH
-			#if BIT_TREE
-			return csrToBitTree(csr);
-			#else
-			return csrToKbitLocal(csr);
-			#endif
-        #else
-            #if COMPRESSED
-                #if VARINT_BYTE_BASED
-					return csrToVarintByteBased(csr);
-                #elif VARINT_WORD_BASED
-					return csrToVarintWordBased(csr);
-                #endif
-            #else
-			return csrToKbit(csr);
-			#endif
-		#endif
-	}
-
-	My_Weighted_Graph make_weighted_graph_from_CSR(){
-		CSRGraphBase<NodeId_, DestID_, invert> csr = MakeGraph();
-		#if LOCAL_APPROACH
-			return csrToWeightedKbitLocal(csr);
-		#else
-			return csrToWeightedKbit(csr);
-		#endif
-	}
+	template <PermuterVariant TVariant>
+    CSRGraphBase<NodeId_, DestID_, invert> permute(CSRGraphBase<NodeId_, DestID_, invert> graph) {
+        return RelabelByRanking(graph, permutation<TVariant>(graph));
+    }
 
-	My_Graph make_graph(){
-		#if LOCAL_APPROACH
-			return make_kbit_local_graph();
-		#else
-			return make_kbit_graph();
-		#endif
-	}
 
 /* Version of 'MakeGraph()' that creates a Kbit_Adjacency_Array. */
  	Kbit_Adjacency_Array_Local make_kbit_local_graph(){
@@ -1731,6 +1567,69 @@ void remove_duplicates(EdgeList& el, pvector<NodeId_>& degrees, int64_t& m){
 	PrintTime("Relabel", t.Seconds());
 	return CSRGraphBase<NodeId_, DestID_, invert>(g.num_nodes(), index, neighs);
   }
+
+  // Relabels (and rebuilds) graph such that vertex v gets the id new_ids[v]. The in-edges of a directed graph are
+  // relabeled as well. Graph types without inversion (invert == false) have no in-edges and can't read them, so their
+  // relabeled graph has no in-index either, like the graphs of MakeGraphFromEL and SquishGraph.
+  static
+  CSRGraphBase<NodeId_, DestID_, invert> RelabelByRanking(
+	  const CSRGraphBase<NodeId_, DestID_, invert> &g, const pvector<NodeId_> &new_ids) {
+	Timer t;
+	t.Start();
+	DestID_ **out_index, *out_neighs, **in_index = nullptr, *in_neighs = nullptr;
+	RelabelCSR<false>(g, new_ids, &out_index, &out_neighs);
+	if constexpr (invert) {
+	  if (g.directed())
+		RelabelCSR<true>(g, new_ids, &in_index, &in_neighs);
+	}
+	t.Stop();
+	PrintTime("Relabel", t.Seconds());
+	if (g.directed())
+	  return CSRGraphBase<NodeId_, DestID_, invert>(g.num_nodes(), out_index, out_neighs, in_index, in_neighs);
+	return CSRGraphBase<NodeId_, DestID_, invert>(g.num_nodes(), out_index, out_neighs);
+  }
+
+  static NodeId_ Relabel(NodeId_ v, const pvector<NodeId_> &new_ids) {
+	return new_ids[v];
+  }
+
+  // keeps the weight, the conversion to NodeId_ would reset it
+  static NodeWeight<NodeId_, WeightT_> Relabel(NodeWeight<NodeId_, WeightT_> v, const pvector<NodeId_> &new_ids) {
+	return NodeWeight<NodeId_, WeightT_>(new_ids[v.v], v.w);
+  }
+
+  // transpose is a template parameter, so that the in-edges are only referenced for graphs with inversion
+  template <bool transpose>
+  static
+  void RelabelCSR(const CSRGraphBase<NodeId_, DestID_, invert> &g, const pvector<NodeId_> &new_ids,
+				  DestID_*** index, DestID_** neighs) {
+	auto degree = [&g](NodeId_ u) {
+	  if constexpr (transpose)
+		return g.in_degree(u);
+	  else
+		return g.out_degree(u);
+	};
+	auto neighbors = [&g](NodeId_ u) {
+	  if constexpr (transpose)
+		return g.in_neigh(u);
+	  else
+		return g.out_neigh(u);
+	};
+	pvector<NodeId_> degrees(g.num_nodes());
+	#pragma omp parallel for
+	for (NodeId_ n=0; n < g.num_nodes(); n++)
+	  degrees[new_ids[n]] = degree(n);
+	pvector<SGOffset> offsets = ParallelPrefixSum(degrees);
+	*neighs = new DestID_[offsets[g.num_nodes()]];
+	*index = CSRGraphBase<NodeId_, DestID_>::GenIndex(offsets, *neighs);
+	#pragma omp parallel for schedule(dynamic, 64)
+	for (NodeId_ u=0; u < g.num_nodes(); u++) {
+	  DestID_ *out = (*index)[new_ids[u]];
+	  for (DestID_ v : neighbors(u))
+		*out++ = Relabel(v, new_ids);
+	  std::sort((*index)[new_ids[u]], (*index)[new_ids[u]+1]);
+	}
+  }
 };
 
 #endif  // BUILDER_H_
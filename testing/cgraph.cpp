@@ -14,7 +14,8 @@ testing::Types<
         Kbit_Adjacency_Array,
         Kbit_Adjacency_Array_Local,
         VarintByteBasedGraph,
-        VarintWordBasedGraph
+        VarintWordBasedGraph,
+        ReferenceCompressedGraph
 >;
 
 TYPED_TEST_SUITE(CGraphTest, Implementations);
@@ -3,6 +3,7 @@
 #include "clique_counting/Comparer_unittest.h"
 #include "clique_counting/TrackingHeap_tests.h"
 #include "clique_counting/TrackingBubblingArray_tests.h"
+#include "clique_counting/TrackingBucketQueue_tests.h"
 #include "clique_counting/conversion_tests.h"
 #include "clique_counting/builder_tests.h"
 //#include "clique_counting/CliqueCounter_tests.h"
@@ -51,7 +51,7 @@ TEST_F(CliqueCounterFullGraphFixture, Counts2CliquesCorrect)
 
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
 
     GMS::KClique::KcListing counter(2, gdir);
 
@@ -71,7 +71,7 @@ TEST_F(CliqueCounterFullGraphFixture, CountsMany2CliquesCorrect)
 
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
 
     GMS::KClique::KcListing counter(2, gdir);
 
@@ -88,7 +88,7 @@ TEST_F(CliqueCounterFullGraphFixture, CountsNo3Clique)
 
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
 
     GMS::KClique::KcListing counter(3, gdir);
 
@@ -108,7 +108,7 @@ TEST_F(CliqueCounterFullGraphFixture, CountsNo3Clique2)
 
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
 
     GMS::KClique::KcListing counter(3, gdir);
 
@@ -126,7 +126,7 @@ TEST_F(CliqueCounterFullGraphFixture, Counts3Clique)
 
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
 
     GMS::KClique::KcListing counter(3, gdir);
 
@@ -154,7 +154,7 @@ TEST_F(CliqueCounterFullGraphFixture, CountsMany3CliquesCorrect)
 
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
 
     GMS::KClique::KcListing counter(3, gdir);
 
@@ -182,7 +182,7 @@ TEST_F(CliqueCounterFullGraphFixture, CountsNo4Clique)
 
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
 
     GMS::KClique::KcListing counter(4, gdir);
 
@@ -216,7 +216,7 @@ TEST_F(CliqueCounterFullGraphFixture, Counts4CliquesCorrect)
 
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
 
     GMS::KClique::KcListing counter(4, gdir);
 
@@ -261,7 +261,7 @@ TEST_F(CliqueCounterFullGraphFixture, Counts4CliquesCorrect2)
 
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
 
     GMS::KClique::KcListing counter(4, gdir);
 
@@ -49,7 +49,7 @@ TEST_F(CliqueCounterEdgeParallelFixture, Counts2CliquesCorrect)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(2);
 
     ASSERT_EQ(2, GMS::KClique::Par::EP_kclisting<>(gdir, cli));
@@ -67,7 +67,7 @@ TEST_F(CliqueCounterEdgeParallelFixture, CountsMany2CliquesCorrect)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(2);
 
     ASSERT_EQ(5, GMS::KClique::Par::EP_kclisting<>(gdir, cli));
@@ -82,7 +82,7 @@ TEST_F(CliqueCounterEdgeParallelFixture, CountsNo3Clique)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(3);
 
     ASSERT_EQ(0, GMS::KClique::Par::EP_kclisting<>(gdir, cli));
@@ -100,7 +100,7 @@ TEST_F(CliqueCounterEdgeParallelFixture, CountsNo3Clique2)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(3);
 
     ASSERT_EQ(0, GMS::KClique::Par::EP_kclisting<>(gdir, cli));
@@ -116,7 +116,7 @@ TEST_F(CliqueCounterEdgeParallelFixture, Counts3Clique)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(3);
 
     ASSERT_EQ(1, GMS::KClique::Par::EP_kclisting<>(gdir, cli));
@@ -142,7 +142,7 @@ TEST_F(CliqueCounterEdgeParallelFixture, CountsMany3CliquesCorrect)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(3);
 
     ASSERT_EQ(6, GMS::KClique::Par::EP_kclisting<>(gdir, cli));
@@ -168,7 +168,7 @@ TEST_F(CliqueCounterEdgeParallelFixture, CountsNo4Clique)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(4);
 
     ASSERT_EQ(0, GMS::KClique::Par::EP_kclisting<>(gdir, cli));
@@ -200,7 +200,7 @@ TEST_F(CliqueCounterEdgeParallelFixture, Counts4CliquesCorrect)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(4);
 
     ASSERT_EQ(6, GMS::KClique::Par::EP_kclisting<>(gdir, cli));
@@ -243,7 +243,7 @@ TEST_F(CliqueCounterEdgeParallelFixture, Counts4CliquesCorrect2)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(4);
 
     ASSERT_EQ(4, GMS::KClique::Par::EP_kclisting<>(gdir, cli));
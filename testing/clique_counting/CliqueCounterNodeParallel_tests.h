@@ -53,7 +53,7 @@ TEST_F(CliqueCounterNodeParallelFixture, Counts2CliquesCorrect)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(2);
 
     ASSERT_EQ(2, GMS::KClique::Par::NP_kclisting<>(gdir, cli));
@@ -71,7 +71,7 @@ TEST_F(CliqueCounterNodeParallelFixture, CountsMany2CliquesCorrect)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(2);
 
     ASSERT_EQ(5, GMS::KClique::Par::NP_kclisting<>(gdir, cli));
@@ -86,7 +86,7 @@ TEST_F(CliqueCounterNodeParallelFixture, CountsNo3Clique)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(3);
 
     ASSERT_EQ(0, GMS::KClique::Par::NP_kclisting<>(gdir, cli));
@@ -104,7 +104,7 @@ TEST_F(CliqueCounterNodeParallelFixture, CountsNo3Clique2)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(3);
 
     ASSERT_EQ(0, GMS::KClique::Par::NP_kclisting<>(gdir, cli));
@@ -120,7 +120,7 @@ TEST_F(CliqueCounterNodeParallelFixture, Counts3Clique)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(3);
 
     ASSERT_EQ(1, GMS::KClique::Par::NP_kclisting<>(gdir, cli));
@@ -146,7 +146,7 @@ TEST_F(CliqueCounterNodeParallelFixture, CountsMany3CliquesCorrect)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(3);
 
     ASSERT_EQ(6, GMS::KClique::Par::NP_kclisting<>(gdir, cli));
@@ -172,7 +172,7 @@ TEST_F(CliqueCounterNodeParallelFixture, CountsNo4Clique)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(4);
 
     ASSERT_EQ(0, GMS::KClique::Par::NP_kclisting<>(gdir, cli));
@@ -204,7 +204,7 @@ TEST_F(CliqueCounterNodeParallelFixture, Counts4CliquesCorrect)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(4);
 
     ASSERT_EQ(6, GMS::KClique::Par::NP_kclisting<>(gdir, cli));
@@ -247,11 +247,90 @@ TEST_F(CliqueCounterNodeParallelFixture, Counts4CliquesCorrect2)
     cc::Graph_T g = UndirGraph(list);
     std::vector<NodeId> ranking;
     PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
-    cc::Graph_T gdir = PpSequential::InduceDirectedGraph(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
     FixedCLApp cli(4);
 
     ASSERT_EQ(4, GMS::KClique::Par::NP_kclisting<>(gdir, cli));
 }
 
+TEST_F(CliqueCounterNodeParallelFixture, Counts4CliquesCorrectPooled)
+{
+    EdgeList list(19);
+    list[0] = Edge(0,1);
+    list[1] = Edge(0,2);
+    list[2] = Edge(0,3);
+    list[3] = Edge(0,4);
+    list[4] = Edge(1,2);
+    list[5] = Edge(1,3);
+    list[6] = Edge(1,4);
+    list[7] = Edge(1,5);
+    list[8] = Edge(1,6);
+    list[9] = Edge(2,3);
+    list[10]= Edge(2,4);
+    list[11]= Edge(2,5);
+    list[12]= Edge(2,6);
+    list[13]= Edge(3,4);
+    list[14]= Edge(3,7);
+    list[15]= Edge(4,8);
+    list[16]= Edge(5,6);
+    list[17]= Edge(6,7);
+    list[18]= Edge(7,8);
+
+    cc::Graph_T g = UndirGraph(list);
+    std::vector<NodeId> ranking;
+    PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
+    FixedCLApp cli(4);
+
+    ASSERT_EQ(6, GMS::KClique::Par::NPPooled_kclisting<>(gdir, cli));
+    ASSERT_EQ(6, GMS::KClique::Par::EPPooled_kclisting<>(gdir, cli));
+}
+
+TEST_F(CliqueCounterNodeParallelFixture, Counts4CliquesCorrectBitset)
+{
+    EdgeList list(0);
+    list.push_back( Edge(0,1));
+    list.push_back( Edge(0,2));
+    list.push_back( Edge(0,3));
+    list.push_back( Edge(1,2));
+    list.push_back( Edge(1,3));
+    list.push_back( Edge(2,3));
+    list.push_back( Edge(2,8));
+    list.push_back( Edge(3,12));
+    list.push_back( Edge(4,5));
+    list.push_back( Edge(4,6));
+    list.push_back( Edge(4,7));
+    list.push_back( Edge(4,9));
+    list.push_back( Edge(5,6));
+    list.push_back( Edge(5,7));
+    list.push_back( Edge(6,7));
+    list.push_back( Edge(6,12));
+    list.push_back( Edge(7,13));
+    list.push_back( Edge(8,9));
+    list.push_back( Edge(8,10));
+    list.push_back( Edge(8,11));
+    list.push_back( Edge(9,10));
+    list.push_back( Edge(9,11));
+    list.push_back( Edge(10,11));
+    list.push_back( Edge(11,14));
+    list.push_back( Edge(12,13));
+    list.push_back( Edge(12,14));
+    list.push_back( Edge(12,15));
+    list.push_back( Edge(13,14));
+    list.push_back( Edge(13,15));
+    list.push_back( Edge(14,15));
+
+    cc::Graph_T g = UndirGraph(list);
+    std::vector<NodeId> ranking;
+    PpSequential::getDegeneracyOrderingDanischHeap(g, ranking);
+    cc::Graph_T gdir = PpParallel::OrientByRank(g, ranking);
+    FixedCLApp cli(4);
+
+    ASSERT_EQ(4, GMS::KClique::Par::NPBitset_kclisting<>(gdir, cli));
+    ASSERT_EQ(4, GMS::KClique::Par::EPBitset_kclisting<>(gdir, cli));
+    // subgraphs with more than 2 nodes are counted by the fallback
+    ASSERT_EQ(4, (GMS::KClique::Parallelize::node<Builders::SubGraphBuilder<>, KcListingBitset<CSRGraph, 2>>(gdir, cli)));
+}
+
 
 #endif
\ No newline at end of file
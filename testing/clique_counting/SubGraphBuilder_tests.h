@@ -278,4 +278,53 @@ TEST_F(SubGraphBuilderFixture, Get4CliqueWithInverse)
     EXPECT_EQ(3, subG.in_degree(mapper.NewIndex(4)));
 }
 
+TEST_F(SubGraphBuilderFixture, PooledBuilderCreatesLargerSubGraph)
+{
+    EdgeList list(5);
+    list[0] = Edge(0,2);
+    list[1] = Edge(0,3);
+    list[2] = Edge(1,0);
+    list[3] = Edge(2,1);
+    list[4] = Edge(2,3);
+
+    cc::Graph_T g = DirB().MakeGraphFromEL(list);
+    auto builder = Builders::PooledSubGraphBuilder(g, 4);
+
+    Builders::SubGraphView subG = builder.buildSubGraph(0);
+    const auto& mapper = builder.GetMapping();
+
+    EXPECT_EQ(2, subG.num_nodes());
+    EXPECT_EQ(1, subG.num_edges());
+    EXPECT_EQ(1, subG.out_degree(mapper.NewIndex(2)));
+    EXPECT_EQ(0, subG.out_degree(mapper.NewIndex(3)));
+    EXPECT_EQ(mapper.NewIndex(3), *subG.out_neigh(mapper.NewIndex(2)).begin());
+}
+
+TEST_F(SubGraphBuilderFixture, PooledBuilderReusesArenaFromEdge)
+{
+    EdgeList list(8);
+    list[0] = Edge(0,1);
+    list[1] = Edge(0,2);
+    list[2] = Edge(0,3);
+    list[3] = Edge(1,2);
+    list[4] = Edge(1,3);
+    list[5] = Edge(1,4);
+    list[6] = Edge(3,2);
+    list[7] = Edge(3,4);
+
+    cc::Graph_T g = DirB().MakeGraphFromEL(list);
+    auto builder = Builders::PooledSubGraphBuilder(g, 4);
+
+    Builders::SubGraphView first = builder.buildSubGraph(0);
+    EXPECT_EQ(3, first.num_nodes());
+    EXPECT_EQ(3, first.num_edges());
+
+    Builders::SubGraphView subG = builder.buildSubGraph(0,1);
+    const auto& mapper = builder.GetMapping();
+
+    EXPECT_EQ(2, subG.num_nodes());
+    EXPECT_EQ(1, subG.num_edges());
+    EXPECT_EQ(1, subG.out_degree(mapper.NewIndex(3)));
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,205 @@
+#ifndef ABSTRACTIONOPTIMIZING_TESTS_MINEBENCH_CLIQUECOUNTING_TRACKINGBUCKETQUEUE_H
+#define ABSTRACTIONOPTIMIZING_TESTS_MINEBENCH_CLIQUECOUNTING_TRACKINGBUCKETQUEUE_H
+
+#include <random>
+#include <vector>
+
+#include "includes.h"
+//#include <preprocessing/util/auxiliary.h>
+using namespace coreOrdering;
+
+using Key_T = NodeId;
+using Value_T = NodeId;
+
+typedef KeyValuePair<Key_T, Value_T> KeyValue_T;
+
+
+
+TEST(TrackingBucketQueue, CreationSortsIntoBucketsStably)
+{
+    KeyValue_T list[5];
+    list[0] = {0, 2};
+    list[1] = {1, 0};
+    list[2] = {2, 2};
+    list[3] = {3, 1};
+    list[4] = {4, 0};
+
+    auto coll = TrackingBucketQueue<NodeId, NodeId>(list, 5);
+
+    // the pairs are sorted in place by a counting sort, which keeps the input order within a bucket
+    EXPECT_EQ( KeyValue_T(1,0), list[0]);
+    EXPECT_EQ( KeyValue_T(4,0), list[1]);
+    EXPECT_EQ( KeyValue_T(3,1), list[2]);
+    EXPECT_EQ( KeyValue_T(0,2), list[3]);
+    EXPECT_EQ( KeyValue_T(2,2), list[4]);
+    for(uint i = 0; i < 5; i++)
+    {
+        EXPECT_EQ( i, list[coll.GetIndex(i)].Key);
+    }
+}
+
+TEST(TrackingBucketQueue, DecreaseValueOfKeyMovesPairToBucketBorder)
+{
+    KeyValue_T list[4];
+    list[0] = {0, 1};
+    list[1] = {1, 1};
+    list[2] = {2, 1};
+    list[3] = {3, 2};
+
+    auto coll = TrackingBucketQueue<NodeId, NodeId>(list, 4);
+
+    // key 2 is swapped with the first pair of bucket 1, which becomes the last pair of bucket 0
+    coll.DecreaseValueOfKey(2);
+    EXPECT_EQ( KeyValue_T(2,0), list[0]);
+    EXPECT_EQ( KeyValue_T(0,1), list[2]);
+    EXPECT_EQ(0, coll.GetIndex(2));
+    EXPECT_EQ(2, coll.GetIndex(0));
+
+    // key 1 is the first pair of bucket 1 now, so it stays where it is
+    coll.DecreaseValueOfKey(1);
+    EXPECT_EQ( KeyValue_T(1,0), list[1]);
+    EXPECT_EQ(1, coll.GetIndex(1));
+
+    EXPECT_EQ( KeyValue_T(2,0), coll.PopHead());
+    EXPECT_EQ( KeyValue_T(1,0), coll.PopHead());
+    EXPECT_EQ( KeyValue_T(0,1), coll.PopHead());
+    EXPECT_EQ( KeyValue_T(3,2), coll.PopHead());
+}
+
+TEST(TrackingBucketQueue, DecreaseValueOfKeyIntoEmptyBuckets)
+{
+    KeyValue_T list[3];
+    list[0] = {0, 0};
+    list[1] = {1, 5};
+    list[2] = {2, 5};
+
+    auto coll = TrackingBucketQueue<NodeId, NodeId>(list, 3);
+
+    // buckets 1 to 4 are empty
+    coll.DecreaseValueOfKey(2);
+    coll.DecreaseValueOfKey(2);
+    coll.DecreaseValueOfKey(2);
+    EXPECT_EQ(2, coll.GetKeyValue(2).Value);
+
+    EXPECT_EQ( KeyValue_T(0,0), coll.PopHead());
+    EXPECT_EQ( KeyValue_T(2,2), coll.PopHead());
+    EXPECT_EQ( KeyValue_T(1,5), coll.PopHead());
+    EXPECT_EQ(0, coll.Size());
+}
+
+TEST(TrackingBucketQueue, DecreaseValueOfKeyInBucketOfPoppedPairs)
+{
+    KeyValue_T list[3];
+    list[0] = {0, 2};
+    list[1] = {1, 2};
+    list[2] = {2, 2};
+
+    auto coll = TrackingBucketQueue<NodeId, NodeId>(list, 3);
+
+    // the border of bucket 2 still points to the popped pair, the decreased pair has to be placed after it
+    EXPECT_EQ( KeyValue_T(0,2), coll.PopHead());
+    EXPECT_EQ(-1, coll.GetIndex(0));
+    coll.DecreaseValueOfKey(2);
+    EXPECT_EQ(1, coll.GetIndex(2));
+
+    // popped keys are ignored
+    coll.DecreaseValueOfKey(0);
+    EXPECT_EQ( KeyValue_T(0,2), list[0]);
+
+    EXPECT_EQ( KeyValue_T(2,1), coll.PopHead());
+    EXPECT_EQ( KeyValue_T(1,2), coll.PopHead());
+    EXPECT_EQ(0, coll.Size());
+}
+
+// Interleaves random decreases and pops, the queue has to pop a pair of the lowest non-empty bucket every time.
+TEST(TrackingBucketQueue, PopHeadReturnsMinimumBucket)
+{
+    const NodeId n = 1000;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<NodeId> initial(0, 50);
+    std::uniform_int_distribution<NodeId> key(0, n - 1);
+    std::vector<KeyValue_T> list(n);
+    std::vector<NodeId> values(n);
+    std::vector<bool> popped(n, false);
+    for(NodeId i = 0; i < n; i++)
+    {
+        values[i] = initial(rng);
+        list[i] = {i, values[i]};
+    }
+
+    auto coll = TrackingBucketQueue<NodeId, NodeId>(list.data(), n);
+
+    while(coll.Size() > 0)
+    {
+        for(int i = 0; i < 5; i++)
+        {
+            NodeId k = key(rng);
+            if(!popped[k] && values[k] > 0)
+            {
+                coll.DecreaseValueOfKey(k);
+                values[k]--;
+            }
+        }
+        NodeId minimum = n;
+        for(NodeId k = 0; k < n; k++)
+        {
+            if(!popped[k]) minimum = std::min(minimum, values[k]);
+        }
+        KeyValue_T head = coll.PopHead();
+        ASSERT_FALSE(popped[head.Key]);
+        ASSERT_EQ(values[head.Key], head.Value);
+        ASSERT_EQ(minimum, head.Value);
+        popped[head.Key] = true;
+    }
+}
+
+// Compares the Danisch degeneracy ordering with all three collections on a graph with a few hubs, where the bubbling
+// array has to move the pairs over long distances.
+TEST(TrackingBucketQueue, DanischOrderingMatchesOtherCollections)
+{
+    typedef EdgePair<NodeId, NodeId> Edge;
+    const NodeId n = 20000;
+    pvector<Edge> list;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<NodeId> vertex(0, n - 1);
+    for(NodeId i = 0; i < 8 * n; i++)
+    {
+        NodeId u = vertex(rng) % 64; // hubs
+        NodeId v = vertex(rng);
+        if(u != v) list.push_back(Edge(u, v));
+        u = vertex(rng);
+        v = vertex(rng);
+        if(u != v) list.push_back(Edge(u, v));
+    }
+    UCLApp cli(0, nullptr, "stub");
+    BuilderBase<NodeId> builder(cli);
+    cc::Graph_T g = builder.MakeGraphFromEL(list);
+
+    // the first vertex which is removed gets the highest rank
+    auto maxBackDegree = [&](const std::vector<NodeId> &ranking) {
+        NodeId result = 0;
+        for(NodeId v = 0; v < g.num_nodes(); v++)
+        {
+            NodeId degree = 0;
+            for(NodeId w : g.out_neigh(v))
+            {
+                degree += ranking[w] < ranking[v];
+            }
+            result = std::max(result, degree);
+        }
+        return result;
+    };
+    std::vector<NodeId> cores;
+    const NodeId degeneracy = PpParallel::getCoreNumbers(g, cores);
+
+    std::vector<NodeId> heap, bubble, bucket;
+    PpSequential::getDegeneracyOrderingDanischHeap(g, heap);
+    PpSequential::getDegeneracyOrderingDanischBubble(g, bubble);
+    PpSequential::getDegeneracyOrderingDanischBucket(g, bucket);
+
+    EXPECT_EQ(degeneracy, maxBackDegree(heap));
+    EXPECT_EQ(degeneracy, maxBackDegree(bubble));
+    EXPECT_EQ(degeneracy, maxBackDegree(bucket));
+}
+
+#endif
@@ -1,5 +1,8 @@
 #include "test_helper.h"
 #include <gms/representations/graphs/coders/coders-utils/varint_utils.h>
+#include <gms/representations/graphs/permuters/permuter_statistics.h>
+#include <gms/representations/graphs/prefetch.h>
+#include <gms/representations/graphs/set_graph.h>
 
 using testing::UnorderedElementsAre;
 
@@ -117,6 +120,233 @@ TEST(CodersNeighborhoods, VarintNeighborhoodFromCSRLastNeigh) {
     check_neigh(wordgraph);
 }
 
+template <class CGraph>
+void check_same_neighborhoods(const CSRGraph &csr, const CGraph &g)
+{
+    ASSERT_EQ(g.num_nodes(), csr.num_nodes());
+    for (NodeId v = 0; v < csr.num_nodes(); ++v) {
+        std::vector<NodeId> expected(csr.out_neigh(v).begin(), csr.out_neigh(v).end());
+        std::vector<NodeId> actual;
+        for (NodeId u : g.out_neigh(v)) {
+            actual.push_back(u);
+        }
+        ASSERT_EQ(g.out_degree(v), csr.out_degree(v));
+        ASSERT_EQ(actual, expected);
+
+        expected.assign(csr.in_neigh(v).begin(), csr.in_neigh(v).end());
+        actual.clear();
+        for (NodeId u : g.in_neigh(v)) {
+            actual.push_back(u);
+        }
+        ASSERT_EQ(actual, expected);
+    }
+}
+
+TEST(CodersNeighborhoods, ReferenceCompressedRoundTrip) {
+    using namespace GMS::CLI;
+    Args args;
+    args.symmetrize = false;
+    Builder builder((GapbsCompat(args)));
+
+    // Similar neighbourhoods with copy blocks, intervals and residuals, also smaller than the vertex itself.
+    pvector<EdgePair<NodeId, NodeId>> el;
+    for (NodeId v = 0; v < 300; ++v) {
+        for (NodeId u = 100; u < 120; ++u) {
+            if ((u + v) % 7 != 0) el.push_back(EdgePair(v, u));
+        }
+        for (NodeId u = 0; u < 300; u += 13 + v % 5) {
+            el.push_back(EdgePair(v, u));
+        }
+        el.push_back(EdgePair(v, (v * 31) % 300));
+    }
+
+    CSRGraph csrgraph = builder.MakeGraphFromEL(el);
+    csrgraph = builder.SquishGraph(csrgraph);
+    auto refgraph = builder.csrToCGraphGeneric<ReferenceCompressedGraph>(csrgraph);
+    check_same_neighborhoods(csrgraph, refgraph);
+
+    auto bytegraph = builder.csrToCGraphGeneric<VarintByteBasedGraph>(csrgraph);
+    NodeId last = csrgraph.num_nodes() - 1;
+    ASSERT_LT(refgraph.new_offsets_out[last], bytegraph.new_offsets_out[last]);
+
+    for (int depth = 0; depth <= ReferenceCompressedGraph::kMaxReferenceDepth; ++depth) {
+        auto g = ReferenceCompressedGraph::FromCGraph(csrgraph, 7, depth);
+        check_same_neighborhoods(csrgraph, g);
+    }
+}
+
+TEST(CodersNeighborhoods, ReferenceCompressedUndirected) {
+    CSRGraph csrgraph = loadGraphFromFile("smallRandom1.el");
+    auto g = ReferenceCompressedGraph::FromCGraph(csrgraph);
+    check_same_neighborhoods(csrgraph, g);
+}
+
+template <class CGraph>
+void check_prefetch_range(const CSRGraph &csr, const CGraph &g)
+{
+    std::vector<NodeId> frontier;
+    for (NodeId v = csr.num_nodes() - 1; v >= 0; v -= 3) {
+        frontier.push_back(v);
+    }
+    for (int64_t distance : {0, 1, 8, 1 << 20}) {
+        std::vector<NodeId> vertices;
+        for (NodeId v : GMS::prefetch_vertices(g, distance)) {
+            vertices.push_back(v);
+        }
+        ASSERT_EQ(vertices.size(), csr.num_nodes());
+        for (NodeId v = 0; v < csr.num_nodes(); ++v) {
+            ASSERT_EQ(vertices[v], v);
+        }
+
+        std::vector<NodeId> actual;
+        for (NodeId v : GMS::prefetch_range(g, frontier, distance)) {
+            actual.push_back(v);
+        }
+        ASSERT_EQ(actual, frontier);
+    }
+}
+
+TEST(CodersNeighborhoods, PrefetchRange) {
+    GMS::CLI::Args args;
+    args.symmetrize = true;
+    Builder builder((GMS::CLI::GapbsCompat(args)));
+    CSRGraph csrgraph = loadGraphFromFile("smallRandom1.el");
+    check_prefetch_range(csrgraph, csrgraph);
+    check_prefetch_range(csrgraph, builder.csrToCGraphGeneric<VarintByteBasedGraph>(csrgraph));
+    check_prefetch_range(csrgraph, builder.csrToCGraphGeneric<VarintWordBasedGraph>(csrgraph));
+    check_prefetch_range(csrgraph, builder.csrToCGraphGeneric<ReferenceCompressedGraph>(csrgraph));
+    ASSERT_GE(GMS::Prefetch::calibrate_distance(csrgraph), 0);
+}
+
+template <PermuterVariant TVariant>
+void check_permuter(Builder &builder, CSRGraph &g)
+{
+    pvector<NodeId> new_ids = builder.permutation<TVariant>(g);
+    ASSERT_EQ(new_ids.size(), g.num_nodes());
+    std::vector<NodeId> sorted(new_ids.begin(), new_ids.end());
+    std::sort(sorted.begin(), sorted.end());
+    for (NodeId v = 0; v < g.num_nodes(); ++v) {
+        ASSERT_EQ(sorted[v], v);
+    }
+
+    CSRGraph permuted = Builder::RelabelByRanking(g, new_ids);
+    ASSERT_EQ(permuted.num_edges(), g.num_edges());
+    for (NodeId u = 0; u < g.num_nodes(); ++u) {
+        std::vector<NodeId> expected;
+        for (NodeId v : g.out_neigh(u)) {
+            expected.push_back(new_ids[v]);
+        }
+        std::sort(expected.begin(), expected.end());
+        std::vector<NodeId> actual(permuted.out_neigh(new_ids[u]).begin(), permuted.out_neigh(new_ids[u]).end());
+        ASSERT_EQ(actual, expected);
+    }
+}
+
+TEST(Permuters, HeuristicPermutersArePermutations) {
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    CLBase cli(0, {}, "dummy");
+    Builder builder(cli);
+
+    check_permuter<PermuterVariant::Bfs>(builder, g);
+    check_permuter<PermuterVariant::ReverseCuthillMcKee>(builder, g);
+    check_permuter<PermuterVariant::Gorder>(builder, g);
+    check_permuter<PermuterVariant::RabbitOrder>(builder, g);
+    check_permuter<PermuterVariant::SlashBurn>(builder, g);
+    check_permuter<PermuterVariant::RecursiveBisection>(builder, g);
+}
+
+TEST(Permuters, RelabelKeepsWeights) {
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    CLBase cli(0, {}, "dummy");
+    Builder builder(cli);
+    pvector<NodeId> new_ids = builder.permutation<PermuterVariant::ReverseCuthillMcKee>(g);
+
+    // weighted copy of g, the weight of (u, v) is u + 2 v + 1
+    pvector<SGOffset> offsets(g.num_nodes() + 1);
+    for (NodeId u = 0; u <= g.num_nodes(); ++u) {
+        offsets[u] = u == 0 ? 0 : offsets[u - 1] + g.out_degree(u - 1);
+    }
+    WNode *neighs = new WNode[offsets[g.num_nodes()]];
+    WNode **index = WGraph::GenIndex(offsets, neighs);
+    for (NodeId u = 0; u < g.num_nodes(); ++u) {
+        WNode *out = index[u];
+        for (NodeId v : g.out_neigh(u)) {
+            *out++ = WNode(v, u + 2 * v + 1);
+        }
+    }
+    WGraph wg(g.num_nodes(), index, neighs);
+
+    pvector<NodeId> old_ids(g.num_nodes());
+    for (NodeId v = 0; v < g.num_nodes(); ++v) {
+        old_ids[new_ids[v]] = v;
+    }
+    WGraph permuted = WeightedBuilder::RelabelByRanking(wg, new_ids);
+    for (NodeId u = 0; u < g.num_nodes(); ++u) {
+        for (WNode e : permuted.out_neigh(new_ids[u])) {
+            ASSERT_EQ(e.w, u + 2 * old_ids[e.v] + 1);
+        }
+    }
+
+    WGraph restored = WeightedBuilder::RelabelByRanking(permuted, old_ids);
+    ASSERT_EQ(restored.num_edges(), wg.num_edges());
+    for (NodeId u = 0; u < g.num_nodes(); ++u) {
+        std::vector<WNode> expected(wg.out_neigh(u).begin(), wg.out_neigh(u).end());
+        std::vector<WNode> actual(restored.out_neigh(u).begin(), restored.out_neigh(u).end());
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < actual.size(); ++i) {
+            ASSERT_EQ(actual[i].v, expected[i].v);
+            ASSERT_EQ(actual[i].w, expected[i].w);
+        }
+    }
+}
+
+TEST(Permuters, RelabelWithoutInversion) {
+    // directed graph 0 -> 1, 0 -> 2, 1 -> 3, 2 -> 1, 3 -> 0 of a type that doesn't keep the in-edges
+    using DirectedGraph = CSRGraphBase<NodeId, NodeId, false>;
+    using DirectedBuilder = BuilderBase<NodeId, NodeId, NodeId, false>;
+    pvector<SGOffset> offsets(5);
+    offsets[0] = 0; offsets[1] = 2; offsets[2] = 3; offsets[3] = 4; offsets[4] = 5;
+    NodeId *neighs = new NodeId[5]{1, 2, 3, 1, 0};
+    DirectedGraph g(4, DirectedGraph::GenIndex(offsets, neighs), neighs, nullptr, nullptr);
+
+    pvector<NodeId> new_ids(4);
+    new_ids[0] = 2; new_ids[1] = 0; new_ids[2] = 3; new_ids[3] = 1;
+    DirectedGraph permuted = DirectedBuilder::RelabelByRanking(g, new_ids);
+    ASSERT_TRUE(permuted.directed());
+    ASSERT_EQ(permuted.num_edges(), g.num_edges());
+    for (NodeId u = 0; u < g.num_nodes(); ++u) {
+        std::vector<NodeId> expected;
+        for (NodeId v : g.out_neigh(u)) {
+            expected.push_back(new_ids[v]);
+        }
+        std::sort(expected.begin(), expected.end());
+        std::vector<NodeId> actual(permuted.out_neigh(new_ids[u]).begin(), permuted.out_neigh(new_ids[u]).end());
+        ASSERT_EQ(actual, expected);
+    }
+}
+
+TEST(Permuters, RankingOnSetGraph) {
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    SortedSetGraph sg = SortedSetGraph::FromCGraph(g);
+
+    std::vector<NodeId> csr_ranking, set_ranking;
+    RcmPermuter<NodeId, NodeId, true>::ranking(g, csr_ranking);
+    RcmPermuter<NodeId, NodeId, true>::ranking(sg, set_ranking);
+    ASSERT_EQ(csr_ranking, set_ranking);
+
+    GorderPermuter<NodeId, NodeId, true>::ranking(g, csr_ranking);
+    GorderPermuter<NodeId, NodeId, true>::ranking(sg, set_ranking);
+    ASSERT_EQ(csr_ranking, set_ranking);
+}
+
+TEST(Permuters, GapStatistics) {
+    CSRGraph g = loadGraphFromFile("micro.el");
+    auto stats = GMS::Permuters::gap_statistics(g);
+    ASSERT_EQ(stats.num_gaps, g.num_edges_directed());
+    ASSERT_DOUBLE_EQ(stats.gap_entropy, 0.0);
+    ASSERT_DOUBLE_EQ(stats.varint_bits_per_edge, 8.0);
+}
+
 /*
 TEST(CodersNeighborhoods, ByteBasedNeighborhood) {
     // TODO(doc):
@@ -0,0 +1,128 @@
+#ifndef GMS_TESTING_PREPROCESSING_CORE_MAINTENANCE_TESTS_H
+#define GMS_TESTING_PREPROCESSING_CORE_MAINTENANCE_TESTS_H
+
+#include "../test_helper.h"
+
+#include <gms/algorithms/preprocessing/parallel/core_maintenance.h>
+
+#include <random>
+
+template <class SGraph>
+class CoreMaintenanceTest : public testing::Test {};
+
+using CoreMaintenanceGraphTypes = testing::Types<SortedSetGraph, RoaringGraph, RobinHoodGraph>;
+TYPED_TEST_SUITE(CoreMaintenanceTest, CoreMaintenanceGraphTypes);
+
+// The maintained core numbers match a decomposition from scratch, and the ordering is a k-order: sorted by core
+// number and every vertex has at most core[v] neighbours behind it.
+template <class SGraph>
+void expectConsistent(const SGraph &g, const PpParallel::CoreMaintenance<SGraph> &maintenance)
+{
+    const NodeId n = g.num_nodes();
+    std::vector<NodeId> cores;
+    NodeId degeneracy = PpParallel::getCoreNumbers(g, cores);
+    ASSERT_EQ(degeneracy, maintenance.degeneracy());
+    for (NodeId v = 0; v < n; v++)
+        ASSERT_EQ(cores[v], maintenance.coreNumber(v)) << "vertex " << v;
+
+    std::vector<NodeId> ranking, order;
+    maintenance.template ordering<true>(ranking);
+    maintenance.ordering(order);
+    for (NodeId i = 0; i < n; i++)
+    {
+        ASSERT_EQ(i, ranking[order[i]]);
+        if (i > 0)
+        {
+            EXPECT_LE(cores[order[i - 1]], cores[order[i]]);
+        }
+    }
+    for (NodeId v = 0; v < n; v++)
+    {
+        NodeId later = 0;
+        for (NodeId w : g.out_neigh(v))
+            later += ranking[w] > ranking[v];
+        EXPECT_LE(later, cores[v]) << "vertex " << v;
+    }
+}
+
+TYPED_TEST(CoreMaintenanceTest, RandomBatches)
+{
+    using Edge = std::pair<NodeId, NodeId>;
+    // skewed random graph, so there are many shells
+    const NodeId n = 500;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<NodeId> vertex(0, n - 1);
+    std::vector<Edge> edges;
+    for (int i = 0; i < 4000; i++)
+    {
+        NodeId u = vertex(rng) % (1 + vertex(rng)), v = vertex(rng);
+        if (u != v)
+        {
+            edges.emplace_back(u, v);
+            edges.emplace_back(v, u);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    TypeParam g = TypeParam::FromEL(edges, n, true);
+    PpParallel::CoreMaintenance<TypeParam> maintenance(g);
+    expectConsistent(g, maintenance);
+
+    for (int batch = 0; batch < 40; batch++)
+    {
+        std::vector<Edge> insertions, deletions;
+        for (int i = 0; i < 1 + batch * 5; i++)
+        {
+            insertions.emplace_back(vertex(rng) % (1 + vertex(rng)), vertex(rng));
+            // delete an existing edge of a random vertex
+            NodeId w = vertex(rng);
+            if (g.out_degree(w) > 0)
+            {
+                std::vector<NodeId> neigh(g.out_neigh(w).begin(), g.out_neigh(w).end());
+                deletions.emplace_back(w, neigh[rng() % neigh.size()]);
+            }
+        }
+        // alternate insertion heavy and deletion heavy batches
+        if (batch % 2)
+            insertions.resize(insertions.size() / 4);
+        else
+            deletions.resize(deletions.size() / 4);
+        maintenance.applyBatch(insertions, deletions);
+        expectConsistent(g, maintenance);
+        EXPECT_FALSE(g.directed());
+    }
+}
+
+TEST(CoreMaintenance, GrowAndShrinkClique)
+{
+    using Edge = std::pair<NodeId, NodeId>;
+    const NodeId n = 12;
+    SortedSetGraph g(n);
+    PpParallel::CoreMaintenance<SortedSetGraph> maintenance(g);
+    EXPECT_EQ(0, maintenance.degeneracy());
+
+    std::vector<Edge> clique;
+    for (NodeId u = 0; u < n; u++)
+        for (NodeId v = u + 1; v < n; v++)
+            clique.emplace_back(u, v);
+    auto stats = maintenance.applyBatch(clique, {});
+    EXPECT_EQ((int64_t)clique.size(), stats.insertedEdges);
+    EXPECT_EQ(n - 1, maintenance.degeneracy());
+    expectConsistent(g, maintenance);
+
+    // duplicates and self loops are ignored
+    stats = maintenance.applyBatch({{0, 1}, {3, 3}}, {{0, 0}});
+    EXPECT_EQ(0, stats.insertedEdges);
+    EXPECT_EQ(0, stats.deletedEdges);
+
+    stats = maintenance.applyBatch({}, {{0, 1}});
+    EXPECT_EQ(n - 2, maintenance.degeneracy());
+    EXPECT_EQ(n, stats.changedCores);
+    expectConsistent(g, maintenance);
+
+    stats = maintenance.applyBatch({}, clique);
+    EXPECT_EQ(0, maintenance.degeneracy());
+    expectConsistent(g, maintenance);
+}
+
+#endif
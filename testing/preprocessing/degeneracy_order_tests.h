@@ -5,6 +5,10 @@
 #include "../clique_counting/UCLApp.h"
 
 #include <gms/algorithms/preprocessing/preprocessing.h>
+
+#include <numeric>
+#include <random>
+
 // TODO (this all should probably be refactored, also in the main GMS code there are also a couple instances of this)
 
 typedef EdgePair<NodeId, NodeId> Edge;
@@ -181,4 +185,184 @@ TEST_F(DegeneracyOrdererFixture, TestTypeDefCoreOrderingBubbling)
     EXPECT_EQ( 0, ranking[5]);
 }
 
+TEST_F(DegeneracyOrdererFixture, BucketedCoreNumbers)
+{
+    // K4 (vertices 0-3) with a path 3-4-5 and a triangle 5-6-7 attached.
+    EdgeList list(12);
+    list[0] = Edge(0,1);
+    list[1] = Edge(0,2);
+    list[2] = Edge(0,3);
+    list[3] = Edge(1,2);
+    list[4] = Edge(1,3);
+    list[5] = Edge(2,3);
+    list[6] = Edge(3,4);
+    list[7] = Edge(4,5);
+    list[8] = Edge(5,6);
+    list[9] = Edge(5,7);
+    list[10]= Edge(6,7);
+    list[11]= Edge(7,8);
+
+    CSRGraph g = UndirB().MakeGraphFromEL(list);
+    std::vector<NodeId> order;
+    std::vector<NodeId> cores;
+    NodeId degeneracy = PpParallel::getKCoreDecomposition(g, order, cores);
+
+    EXPECT_EQ(3, degeneracy);
+    EXPECT_THAT(cores, testing::ElementsAre(3, 3, 3, 3, 2, 2, 2, 2, 1));
+
+    // every vertex has at most degeneracy neighbours which are peeled later
+    std::vector<NodeId> ranking(g.num_nodes());
+    for (NodeId i = 0; i < g.num_nodes(); i++)
+        ranking[order[i]] = i;
+    for (NodeId v = 0; v < g.num_nodes(); v++)
+    {
+        NodeId later = 0;
+        for (NodeId w : g.out_neigh(v))
+            later += ranking[w] > ranking[v];
+        EXPECT_LE(later, cores[v]);
+    }
+}
+
+TEST_F(DegeneracyOrdererFixture, BucketedMatchesMatula)
+{
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    RoaringGraph rgraph = RoaringGraph::FromCGraph(g);
+
+    std::vector<NodeId> matula;
+    PpSequential::getDegeneracyOrderingMatula(rgraph, matula);
+    std::vector<NodeId> bucketed;
+    PpParallel::getDegeneracyOrderingBucketed(rgraph, bucketed);
+
+    EXPECT_EQ(CoreNumberEvaluator::getCoreNumberOfOrder(matula, rgraph),
+              CoreNumberEvaluator::getCoreNumberOfOrder(bucketed, rgraph));
+    EXPECT_TRUE(PpVerifier::DegOrderingVerifier(g, bucketed));
+
+    // more levels than open buckets, i.e. the overflow bucket is used
+    EdgeList list;
+    for (NodeId u = 0; u < 200; u++)
+        for (NodeId v = u + 1; v < 200; v++)
+            list.push_back(Edge(u, v));
+    CSRGraph clique = UndirB().MakeGraphFromEL(list);
+    std::vector<NodeId> cores;
+    std::vector<NodeId> rank;
+    EXPECT_EQ(199, (PpParallel::getKCoreDecomposition<CSRGraph, true>(clique, rank, cores)));
+    std::vector<NodeId> sorted(rank.begin(), rank.end());
+    std::sort(sorted.begin(), sorted.end());
+    for (NodeId v = 0; v < 200; v++)
+    {
+        EXPECT_EQ(v, sorted[v]);
+        EXPECT_EQ(199, cores[v]);
+    }
+}
+
+TEST_F(DegeneracyOrdererFixture, ApproxOrderingIsPermutation)
+{
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    for (double epsilon : {0.001, 0.5})
+    {
+        std::vector<NodeId> order;
+        PpParallel::getDegeneracyOrderingApproxCGraph<PpParallel::boundary_function::averageDegree>(g, order, epsilon);
+        EXPECT_TRUE(PpVerifier::DegOrderingApproxVerifier<CSRGraph>(g, order));
+        std::vector<NodeId> sorted(order);
+        std::sort(sorted.begin(), sorted.end());
+        for (NodeId v = 0; v < g.num_nodes(); v++)
+            EXPECT_EQ(v, sorted[v]);
+    }
+
+    // histogram placement: stable for the remaining vertices, sorted by degree for the peeled ones
+    std::vector<int> degree = {5, 1, 3, 9, 0, 3, 7, 2};
+    std::vector<NodeId> in = {0, 1, 2, 3, 4, 5, 6, 7};
+    std::vector<NodeId> out(in.size());
+    std::vector<int64_t> counts;
+    int64_t peeled = PpParallel::ApproxDegeneracy::histogramPartition(in.data(), in.size(), out.data(), degree, 3, counts);
+    EXPECT_EQ(5, peeled);
+    EXPECT_THAT(out, testing::ElementsAre(4, 1, 7, 2, 5, 0, 3, 6));
+
+    // a border above kMaxHistogramBuckets merges degrees into one bucket, the peeled vertices are still sorted
+    const int64_t border = 3 * PpParallel::ApproxDegeneracy::kMaxHistogramBuckets;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pick(0, 2 * border);
+    degree.resize(20000);
+    for (int &d : degree)
+        d = pick(rng);
+    in.resize(degree.size());
+    std::iota(in.begin(), in.end(), 0);
+    out.resize(in.size());
+    peeled = PpParallel::ApproxDegeneracy::histogramPartition(in.data(), in.size(), out.data(), degree, border, counts);
+    std::vector<NodeId> expected(in);
+    std::stable_sort(expected.begin(), expected.end(), [&](NodeId a, NodeId b) {
+        return std::min<int64_t>(degree[a], border + 1) < std::min<int64_t>(degree[b], border + 1);
+    });
+    EXPECT_EQ(expected, out);
+    EXPECT_EQ(std::count_if(degree.begin(), degree.end(), [&](int d) { return d <= border; }), peeled);
+}
+
+TEST_F(DegeneracyOrdererFixture, ParallelOrderEvaluation)
+{
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    RoaringGraph rgraph = RoaringGraph::FromCGraph(g);
+    const size_t degeneracy = DegeneracyOrderingVerifier::getDegeneracy(RoaringGraph::FromCGraph(g));
+    EXPECT_EQ(degeneracy, CoreNumberEvaluator::getDegeneracy(g));
+
+    std::vector<NodeId> order;
+    PpParallel::getDegreeOrdering(g, order);
+    auto info = CoreNumberEvaluator::evaluateCoreNrAccuracy(order, g);
+    EXPECT_EQ(degeneracy, info.coreNumber);
+    EXPECT_EQ(CoreNumberEvaluator::getCoreNumberOfOrder(order, rgraph), info.coreNumberOfOrder);
+    EXPECT_DOUBLE_EQ((double)info.coreNumberOfOrder / degeneracy, info.approximationFactor);
+
+    // rank format gives the same result
+    std::vector<NodeId> rank(order.size());
+    CoreNumberEvaluator::switchOrderingFormat(order, rank);
+    EXPECT_EQ(info.coreNumberOfOrder, CoreNumberEvaluator::getCoreNumberOfOrder<true>(rank, g));
+
+    // sampling only gives a lower bound
+    EXPECT_LE(CoreNumberEvaluator::getCoreNumberOfOrder(order, g, 10), info.coreNumberOfOrder);
+    auto sampled = CoreNumberEvaluator::evaluateCoreNrAccuracy(order, g, degeneracy, 10);
+    EXPECT_EQ(10u, sampled.sampledVertices);
+    EXPECT_LE(sampled.coreNumberOfOrder, info.coreNumberOfOrder);
+
+    std::vector<NodeId> degeneracyOrder;
+    PpParallel::getDegeneracyOrderingBucketed(g, degeneracyOrder);
+    EXPECT_TRUE(DegeneracyOrderingVerifier::degeneracyOrderingVerifier(g, degeneracyOrder, 50));
+
+    // no permutation
+    std::vector<NodeId> broken(degeneracyOrder);
+    broken[0] = broken[1];
+    std::vector<NodeId> ranks;
+    EXPECT_FALSE(CoreNumberEvaluator::toRankFormat(broken, g.num_nodes(), ranks));
+    EXPECT_FALSE(PpVerifier::DegOrderingVerifier(g, broken));
+    EXPECT_FALSE(PpVerifier::DegOrderingApproxVerifier<CSRGraph>(g, broken));
+}
+
+TEST_F(DegeneracyOrdererFixture, VerifierReferenceIsIndependent)
+{
+    for (const char *file : {"smallRandom1.el", "tomitaExample.el"})
+    {
+        CSRGraph g = loadGraphFromFile(file);
+        const size_t degeneracy = DegeneracyOrderingVerifier::getDegeneracy(RoaringGraph::FromCGraph(g));
+        EXPECT_EQ(degeneracy, DegeneracyOrderingVerifier::sequentialDegeneracy(g));
+
+        // the peeling orderings prove the degeneracy with their core suffix
+        std::vector<NodeId> order;
+        PpParallel::getDegeneracyOrderingBucketed(g, order);
+        std::vector<NodeId> rank;
+        ASSERT_TRUE(CoreNumberEvaluator::toRankFormat(order, g.num_nodes(), rank));
+        bool fromSuffix = false;
+        EXPECT_EQ(degeneracy, DegeneracyOrderingVerifier::referenceDegeneracy(g, rank, 0, fromSuffix));
+        EXPECT_TRUE(fromSuffix);
+        EXPECT_TRUE(DegeneracyOrderingVerifier::degeneracyOrderingVerifier(g, order, 0));
+
+        // the reverse ordering has no core suffix, the sequential peel gives the reference and the ordering is rejected
+        std::vector<NodeId> reverse(order.rbegin(), order.rend());
+        ASSERT_TRUE(CoreNumberEvaluator::toRankFormat(reverse, g.num_nodes(), rank));
+        if (CoreNumberEvaluator::getCoreNumberOfOrder(reverse, g) > degeneracy)
+        {
+            EXPECT_EQ(degeneracy, DegeneracyOrderingVerifier::referenceDegeneracy(g, rank, 0, fromSuffix));
+            EXPECT_FALSE(fromSuffix);
+            EXPECT_FALSE(DegeneracyOrderingVerifier::degeneracyOrderingVerifier(g, reverse, 0));
+        }
+    }
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,143 @@
+#ifndef GMS_TESTING_PREPROCESSING_ORDERING_CACHE_TESTS_H
+#define GMS_TESTING_PREPROCESSING_ORDERING_CACHE_TESTS_H
+
+#include "../test_helper.h"
+
+#include <gms/common/ordering_cache.h>
+#include <gms/algorithms/preprocessing/preprocessing.h>
+
+#include <cstdlib>
+
+class OrderingCacheFixture : public ::testing::Test
+{
+protected:
+    std::string directory;
+
+    virtual void SetUp() override
+    {
+        char name[] = "/tmp/gms_ordering_cache_XXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(name));
+        directory = name;
+    }
+
+    virtual void TearDown() override
+    {
+        std::string command = "rm -rf " + directory;
+        EXPECT_EQ(0, std::system(command.c_str()));
+    }
+};
+
+TEST_F(OrderingCacheFixture, FingerprintDependsOnContentOnly)
+{
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    CSRGraph h = loadGraphFromFile("smallRandom1.el");
+    CSRGraph other = loadGraphFromFile("tomitaExample.el");
+
+    const uint64_t fp = GMS::OrderingCache::fingerprint(g);
+    EXPECT_EQ(fp, GMS::OrderingCache::fingerprint(h));
+    EXPECT_EQ(fp, GMS::OrderingCache::fingerprint(RoaringGraph::FromCGraph(g)));
+    EXPECT_NE(fp, GMS::OrderingCache::fingerprint(other));
+}
+
+TEST_F(OrderingCacheFixture, StoreAndLoad)
+{
+    using namespace GMS::OrderingCache;
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    std::vector<NodeId> ranks;
+    std::vector<NodeId> cores;
+    PpParallel::getKCoreDecomposition<CSRGraph, true>(g, ranks, cores);
+
+    Store store(directory);
+    Key key{fingerprint(g), "degeneracy", "bucketed"};
+    EXPECT_FALSE(store.load(key, g.num_nodes()).has_value());
+    ASSERT_TRUE(store.save(key, ranks, cores));
+
+    auto entry = store.load(key, g.num_nodes());
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_TRUE(entry->has_cores());
+    pvector<NodeId> loaded_ranks;
+    std::vector<NodeId> loaded_cores;
+    entry->copy_ranks(loaded_ranks);
+    entry->copy_cores(loaded_cores);
+    EXPECT_TRUE(std::equal(ranks.begin(), ranks.end(), loaded_ranks.begin()));
+    EXPECT_EQ(cores, loaded_cores);
+
+    // other parameters, vertex counts or graphs are different entries
+    EXPECT_FALSE(store.load(Key{key.graph, "degeneracy", "approx"}, g.num_nodes()).has_value());
+    EXPECT_FALSE(store.load(key, g.num_nodes() + 1).has_value());
+    EXPECT_FALSE(store.load(Key{key.graph + 1, "degeneracy", "bucketed"}, g.num_nodes()).has_value());
+
+    // entries without core numbers, overwriting the previous entry
+    ASSERT_TRUE(store.save(key, ranks));
+    entry = store.load(key, g.num_nodes());
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_FALSE(entry->has_cores());
+    EXPECT_EQ(nullptr, entry->cores());
+    EXPECT_TRUE(std::equal(ranks.begin(), ranks.end(), entry->ranks()));
+}
+
+TEST_F(OrderingCacheFixture, CachedOrderingIsSharedByName)
+{
+    using namespace GMS::OrderingCache;
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    int computed = 0;
+    auto degeneracy = [&](std::vector<NodeId> &ranks, std::vector<NodeId> &cores) {
+        computed++;
+        PpParallel::getKCoreDecomposition<CSRGraph, true>(g, ranks, cores);
+    };
+
+    std::vector<NodeId> ranks, cores;
+    CachedOrdering first(Mode::Reuse, directory, g, "degeneracy");
+    first.get(ranks, cores, degeneracy);
+    EXPECT_FALSE(first.loaded());
+    EXPECT_EQ(1, computed);
+
+    // another benchmark with the same ordering name loads the entry, with or without the core numbers
+    std::vector<NodeId> loaded_ranks, loaded_cores;
+    CachedOrdering second(Mode::Reuse, directory, RoaringGraph::FromCGraph(g), "degeneracy");
+    second.get(loaded_ranks, loaded_cores, degeneracy);
+    EXPECT_TRUE(second.loaded());
+    EXPECT_EQ(1, computed);
+    EXPECT_EQ(ranks, loaded_ranks);
+    EXPECT_EQ(cores, loaded_cores);
+    pvector<NodeId> rank_only;
+    second.get(rank_only, [&](pvector<NodeId> &) { computed++; });
+    EXPECT_TRUE(second.loaded());
+    EXPECT_TRUE(std::equal(ranks.begin(), ranks.end(), rank_only.begin()));
+
+    // entries without core numbers are computed again when the cores are needed
+    CachedOrdering degree(Mode::Reuse, directory, g, "degree");
+    degree.get(rank_only, [&](pvector<NodeId> &r) { PpParallel::getDegreeOrdering<CSRGraph, true>(g, r); });
+    degree.get(loaded_ranks, loaded_cores, degeneracy);
+    EXPECT_FALSE(degree.loaded());
+    EXPECT_EQ(2, computed);
+
+    // refresh computes the entry once, off never touches the store
+    CachedOrdering refresh(Mode::Refresh, directory, g, "degeneracy");
+    refresh.get(loaded_ranks, loaded_cores, degeneracy);
+    refresh.get(loaded_ranks, loaded_cores, degeneracy);
+    EXPECT_EQ(3, computed);
+    EXPECT_TRUE(refresh.loaded());
+    CachedOrdering off(Mode::Off, directory, g, "degeneracy");
+    off.get(loaded_ranks, loaded_cores, degeneracy);
+    EXPECT_FALSE(off.enabled());
+    EXPECT_FALSE(off.loaded());
+    EXPECT_EQ(4, computed);
+}
+
+TEST_F(OrderingCacheFixture, BoundParametersAreReported)
+{
+    auto approx = PpParallel::getDegeneracyOrderingApproxCGraph<PpParallel::boundary_function::averageDegree, true, CSRGraph, pvector<NodeId>>;
+    auto small = preprocessing_bind(approx, 0.001);
+    auto large = preprocessing_bind(approx, 0.1);
+    EXPECT_EQ(small.parameters(), preprocessing_bind(approx, 0.001).parameters());
+    EXPECT_NE(small.parameters(), large.parameters());
+
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    pvector<NodeId> bound(g.num_nodes()), direct(g.num_nodes());
+    small(g, bound);
+    approx(g, direct, 0.001);
+    EXPECT_TRUE(std::equal(bound.begin(), bound.end(), direct.begin()));
+}
+
+#endif
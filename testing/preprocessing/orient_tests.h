@@ -0,0 +1,78 @@
+#ifndef GMS_TESTING_PREPROCESSING_ORIENT_TESTS_H
+#define GMS_TESTING_PREPROCESSING_ORIENT_TESTS_H
+
+#include "../test_helper.h"
+
+#include <gms/algorithms/preprocessing/preprocessing.h>
+#include <gms/algorithms/set_based/triangle_count/verifier.h>
+
+template <class SGraph>
+class OrientByRankTest : public testing::Test {};
+
+using SetGraphTypes = testing::Types<RoaringGraph, SortedSetGraph, RobinHoodGraph>;
+TYPED_TEST_SUITE(OrientByRankTest, SetGraphTypes);
+
+TEST(OrientByRank, CSRGraphRankSpace)
+{
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    const NodeId n = g.num_nodes();
+    std::vector<NodeId> ranking;
+    PpParallel::getDegeneracyOrderingBucketed<CSRGraph, true>(g, ranking);
+
+    CSRGraph oriented = PpParallel::OrientByRank(g, ranking);
+    ASSERT_EQ(n, oriented.num_nodes());
+    EXPECT_TRUE(oriented.directed());
+    EXPECT_EQ(g.num_edges(), oriented.num_edges());
+
+    size_t triangles = 0;
+    for (NodeId u = 0; u < n; u++)
+    {
+        EXPECT_TRUE(std::is_sorted(oriented.out_neigh(u).begin(), oriented.out_neigh(u).end()));
+        for (NodeId v : oriented.out_neigh(u))
+        {
+            EXPECT_LT(u, v);
+            EXPECT_TRUE(std::binary_search(oriented.in_neigh(v).begin(), oriented.in_neigh(v).end(), u));
+            std::vector<NodeId> common;
+            std::set_intersection(oriented.out_neigh(u).begin(), oriented.out_neigh(u).end(),
+                                  oriented.out_neigh(v).begin(), oriented.out_neigh(v).end(),
+                                  std::back_inserter(common));
+            triangles += common.size();
+        }
+    }
+    EXPECT_EQ(GMS::TriangleCount::Verify::compute_total_count(g), triangles);
+}
+
+TEST(OrientByRank, CSRGraphKeepIds)
+{
+    CSRGraph g = loadGraphFromFile("tomitaExample.el");
+    // equal ranks are oriented by vertex id
+    std::vector<NodeId> ranking(g.num_nodes(), 0);
+    CSRGraph oriented = PpParallel::OrientByRank(g, ranking, false);
+    for (NodeId u = 0; u < g.num_nodes(); u++)
+    {
+        std::vector<NodeId> expected;
+        for (NodeId v : g.out_neigh(u))
+            if (u < v)
+                expected.push_back(v);
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), oriented.out_neigh(u).begin(), oriented.out_neigh(u).end()));
+    }
+}
+
+TYPED_TEST(OrientByRankTest, MatchesCSRGraph)
+{
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    std::vector<NodeId> ranking;
+    PpParallel::getDegreeOrdering<CSRGraph, true>(g, ranking);
+
+    CSRGraph expected = PpParallel::OrientByRank(g, ranking);
+    TypeParam oriented = PpParallel::OrientByRank(TypeParam::FromCGraph(g), ranking);
+    ASSERT_EQ(expected.num_nodes(), oriented.num_nodes());
+    for (NodeId u = 0; u < g.num_nodes(); u++)
+    {
+        std::vector<NodeId> neigh(oriented.out_neigh(u).begin(), oriented.out_neigh(u).end());
+        std::sort(neigh.begin(), neigh.end());
+        EXPECT_TRUE(std::equal(neigh.begin(), neigh.end(), expected.out_neigh(u).begin(), expected.out_neigh(u).end()));
+    }
+}
+
+#endif
@@ -1,4 +1,8 @@
+#include "core_maintenance_tests.h"
 #include "degeneracy_order_tests.h"
+#include "ordering_cache_tests.h"
+#include "orient_tests.h"
+#include "relabel_tests.h"
 
 int main(int argc, char **argv) {
     //omp_set_num_threads(1);
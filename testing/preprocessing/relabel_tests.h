@@ -0,0 +1,91 @@
+#ifndef GMS_TESTING_PREPROCESSING_RELABEL_TESTS_H
+#define GMS_TESTING_PREPROCESSING_RELABEL_TESTS_H
+
+#include "../test_helper.h"
+
+#include <gms/algorithms/preprocessing/parallel/relabel.h>
+#include <gms/algorithms/set_based/triangle_count/verifier.h>
+
+// The relabeled graph has the same edges, mapped by new_ids, and sorted neighbourhoods.
+static void expectRelabeled(const CSRGraph &g, const CSRGraph &relabeled, const PpParallel::Relabeling &relabeling)
+{
+    ASSERT_EQ(g.num_nodes(), relabeled.num_nodes());
+    ASSERT_EQ(g.num_edges(), relabeled.num_edges());
+    for (NodeId v = 0; v < g.num_nodes(); v++)
+    {
+        ASSERT_EQ(v, relabeling.original_ids[relabeling.new_ids[v]]);
+        std::vector<NodeId> expected;
+        for (NodeId w : g.out_neigh(v))
+            expected.push_back(relabeling.new_ids[w]);
+        std::sort(expected.begin(), expected.end());
+        auto neigh = relabeled.out_neigh(relabeling.new_ids[v]);
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), neigh.begin(), neigh.end()));
+    }
+}
+
+TEST(Relabel, AllOrderings)
+{
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    std::vector<std::string> orderings = PpParallel::Relabel::orderingNames();
+    for (const auto &[name, variant] : GMS::Permuters::permuter_names())
+        orderings.push_back(name);
+
+    for (const auto &ordering : orderings)
+    {
+        SCOPED_TRACE(ordering);
+        auto relabeling = PpParallel::computeRelabeling(g, ordering);
+        ASSERT_TRUE(relabeling.has_value());
+        CSRGraph relabeled = PpParallel::relabelGraph(g, *relabeling);
+        expectRelabeled(g, relabeled, *relabeling);
+        EXPECT_EQ(GMS::TriangleCount::Verify::compute_total_count(g),
+                  GMS::TriangleCount::Verify::compute_total_count(relabeled));
+    }
+    EXPECT_FALSE(PpParallel::computeRelabeling(g, "unknown").has_value());
+    std::vector<NodeId> original_ids;
+    EXPECT_FALSE(PpParallel::relabelByOrdering(g, "unknown", original_ids).has_value());
+}
+
+TEST(Relabel, DegreeMatchesRelabelByDegree)
+{
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    CSRGraph expected = Builder::RelabelByDegree(g);
+    CSRGraph relabeled = PpParallel::relabelGraph(g, *PpParallel::computeRelabeling(g, "degree"));
+    for (NodeId v = 0; v < g.num_nodes(); v++)
+    {
+        EXPECT_TRUE(std::equal(expected.out_neigh(v).begin(), expected.out_neigh(v).end(),
+                               relabeled.out_neigh(v).begin(), relabeled.out_neigh(v).end()));
+    }
+}
+
+TEST(Relabel, SetGraphAndOriginalIds)
+{
+    CSRGraph g = loadGraphFromFile("smallRandom1.el");
+    auto relabeling = *PpParallel::computeRelabeling(g, "rcm");
+    CSRGraph relabeled = PpParallel::relabelGraph(g, relabeling);
+    SortedSetGraph sgraph = PpParallel::relabelGraph(SortedSetGraph::FromCGraph(g), relabeling);
+    for (NodeId v = 0; v < g.num_nodes(); v++)
+    {
+        EXPECT_TRUE(std::equal(relabeled.out_neigh(v).begin(), relabeled.out_neigh(v).end(),
+                               sgraph.out_neigh(v).begin(), sgraph.out_neigh(v).end()));
+    }
+
+    // vertex v of the relabeled graph is vertex original_ids[v] of the input
+    for (NodeId v = 0; v < g.num_nodes(); v++)
+        EXPECT_EQ(relabeled.out_degree(v), g.out_degree(relabeling.original_ids[v]));
+
+    // per vertex results of the command line relabeling are reported in the original ids
+    GMS::CLI::Args args;
+    auto cliRelabeled = PpParallel::relabelByOrdering(g, "rcm", args.original_ids);
+    ASSERT_TRUE(cliRelabeled.has_value());
+    std::vector<int64_t> degrees(g.num_nodes());
+    for (NodeId v = 0; v < g.num_nodes(); v++)
+        degrees[v] = cliRelabeled->out_degree(v);
+    std::vector<int64_t> original = args.to_original_ids(degrees);
+    for (NodeId v = 0; v < g.num_nodes(); v++)
+    {
+        EXPECT_EQ(g.out_degree(v), original[v]);
+        EXPECT_EQ(relabeling.original_ids[v], args.original_id(v));
+    }
+}
+
+#endif
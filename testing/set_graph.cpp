@@ -1,5 +1,6 @@
 #include "test_helper.h"
 #include <gms/representations/graphs/set_graph.h>
+#include <gms/representations/graphs/prefetch.h>
 
 template <class TSet>
 class SetGraphTest : public testing::Test
@@ -112,4 +113,23 @@ TYPED_TEST(SetGraphTest, Clone) {
     ASSERT_EQ(g.num_nodes(), 2);
     ASSERT_EQ(g.out_neigh(0), Set{1});
     ASSERT_EQ(g.out_neigh(1), Set{0});
-}
\ No newline at end of file
+}
+TYPED_TEST(SetGraphTest, PrefetchRange) {
+    std::vector<Set> sets;
+    sets.push_back(Set{1, 2, 3});
+    sets.push_back(Set{0, 2});
+    sets.push_back(Set{0, 1, 3});
+    sets.push_back(Set{0, 2});
+    SGraph g(std::move(sets));
+
+    for (int64_t distance : {0, 1, 2, 8}) {
+        for (NodeId u : GMS::prefetch_vertices(g, distance)) {
+            std::vector<NodeId> expected(g.out_neigh(u).begin(), g.out_neigh(u).end());
+            std::vector<NodeId> actual;
+            for (NodeId v : GMS::prefetch_range(g, g.out_neigh(u), distance)) {
+                actual.push_back(v);
+            }
+            ASSERT_EQ(actual, expected);
+        }
+    }
+}